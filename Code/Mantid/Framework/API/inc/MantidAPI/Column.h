@@ -174,6 +174,8 @@ public:
 protected:
     /// Sets the new column size.
     virtual void resize(size_t count) = 0;
+    /// Makes room for the given number of items without resizing. Does nothing by default.
+    virtual void reserve(size_t count) {UNUSED_ARG(count);}
     /// Inserts an item.
     virtual void insert(size_t index) = 0;
     /// Removes an item.
@@ -33,6 +33,8 @@ namespace API
     /// Pure abstract methods to be implemented
     virtual std::string toXMLString() const = 0;
     virtual void apply(const coord_t * inputVector, coord_t * outVector) const = 0;
+    /// Transform several points stored one after another
+    virtual void applyMany(const coord_t * inputVectors, coord_t * outVectors, const size_t numPoints) const;
     virtual CoordTransform * clone() const = 0;
     virtual std::string id() const = 0;
 
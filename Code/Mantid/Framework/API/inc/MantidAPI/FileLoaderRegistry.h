@@ -3,12 +3,17 @@
 
 #include "MantidAPI/AlgorithmFactory.h"
 #include "MantidAPI/IFileLoader.h"
+#include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/SingletonHolder.h"
 
 #ifndef Q_MOC_RUN
 # include <boost/type_traits/is_base_of.hpp>
 #endif
 
+#include <Poco/File.h>
+#include <Poco/Timestamp.h>
+
+#include <list>
 #include <map>
 #include <string>
 #include <vector>
@@ -29,6 +34,9 @@ namespace Mantid
     Keeps a registry of algorithm's that are file loading algorithms to allow them to be searched
     to find the correct one to load a particular file.
 
+    The loader chosen for a file is remembered, along with the file's modification time and size,
+    so that loading the same unchanged file again does not ask every loader to check it.
+
     A macro, DECLARE_FILELOADER_ALGORITHM is defined in RegisterFileLoader.h. Use this in place of the standard
     DECLARE_ALGORITHM macro
 
@@ -79,6 +87,7 @@ namespace Mantid
         // If the factory didn't throw then the name is valid
         m_names[format].insert(nameVersion);
         m_totalSize += 1;
+        clearCache();
         m_log.debug() << "Registered '" << nameVersion.first << "' version '" << nameVersion.second << "' as file loader\n";
       }
 
@@ -126,6 +135,30 @@ namespace Mantid
         }
       };
 
+      /// The loader previously chosen for a file
+      struct CachedChoice
+      {
+        /// The file the loader was chosen for
+        std::string filename;
+        /// Modification time of the file when the loader was chosen
+        Poco::Timestamp modified;
+        /// Size of the file when the loader was chosen
+        Poco::File::FileSize size;
+        /// Name of the chosen loader
+        std::string name;
+        /// Version of the chosen loader
+        int version;
+      };
+      /// Type of the list of cached choices, most recently used first
+      typedef std::list<CachedChoice> ChoiceList;
+
+      /// Look for a loader previously chosen for the unchanged file
+      IAlgorithm_sptr findCachedLoader(const std::string & filename, const Poco::File & file) const;
+      /// Remember the loader chosen for the file
+      void cacheLoader(const std::string & filename, const Poco::File & file, const IAlgorithm_sptr & loader) const;
+      /// Forget all the chosen loaders
+      void clearCache();
+
       /// Remove a named algorithm & version from the given map
       void removeAlgorithm(const std::string & name, const int version, 
                            std::multimap<std::string,int> & typedLoaders);
@@ -134,6 +167,12 @@ namespace Mantid
       std::vector<std::multimap<std::string,int> > m_names;
       /// Total number of names registered
       size_t m_totalSize;
+      /// Recently chosen loaders, most recent first
+      mutable ChoiceList m_choices;
+      /// Lookup into m_choices by filename
+      mutable std::map<std::string, ChoiceList::iterator> m_choiceIndex;
+      /// Protects the cache of chosen loaders
+      mutable Kernel::Mutex m_choiceMutex;
 
       /// Reference to a logger
       mutable Kernel::Logger m_log;
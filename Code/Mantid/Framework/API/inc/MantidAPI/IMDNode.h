@@ -150,6 +150,11 @@ public:
      *   @param coordTable -- vector of events data, which would be packed into events
      */
     virtual void setEventsData(const std::vector<coord_t> &coordTable)=0;
+    /** The method to convert the table of data into events appended to the events already in the box
+     *   Used to merge events loaded from several files in one block
+     *   @param coordTable -- vector of events data, which would be packed into events
+     */
+    virtual void addEventsData(const std::vector<coord_t> &coordTable)=0;
       
     /// Add a single event defined by its components
     virtual void buildAndAddEvent(const signal_t Signal, const signal_t errorSq,const std::vector<coord_t> &point, uint16_t runIndex,uint32_t detectorId) = 0;
@@ -172,6 +177,17 @@ public:
    * @param errorSquared [out] :: set to the integrated squared error.
     */
     virtual void integrateSphere(Mantid::API::CoordTransform & radiusTransform, const coord_t radiusSquared, signal_t & signal, signal_t & errorSquared) const = 0;
+   /** Sphere (peak) integration of several spheres with the same center, e.g. a peak and its background.
+   * Each box is visited once for all the spheres.
+   *
+   * @param radiusTransform :: nd-to-1 coordinate transformation that converts from these
+   *        dimensions to the distance (squared) from the center of the spheres.
+   * @param radiiSquared :: radius^2 below which to integrate, for each sphere
+   * @param signal [out] :: the integrated signal of each sphere is added to the element at its index
+   * @param errorSquared [out] :: the integrated squared error of each sphere is added to the element at its index
+    */
+    virtual void integrateSpheres(Mantid::API::CoordTransform & radiusTransform, const std::vector<coord_t> & radiiSquared,
+                                  std::vector<signal_t> & signal, std::vector<signal_t> & errorSquared) const = 0;
    /** Find the centroid of all events contained within by doing a weighted average
    * of their coordinates.
    *
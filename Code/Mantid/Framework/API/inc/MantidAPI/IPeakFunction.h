@@ -56,6 +56,8 @@ public:
   void functionDeriv1D(Jacobian* out, const double* xValues, const size_t nData);
   /// Set new peak radius
   static void setPeakRadius(const int& r = 5);
+  /// Get the interval of x outside which the peak values and derivatives are zero
+  virtual std::pair<double,double> getDomainInterval() const;
 
   /// Function evaluation method to be implemented in the inherited classes
   virtual void functionLocal(double* out, const double* xValues, const size_t nData)const = 0;
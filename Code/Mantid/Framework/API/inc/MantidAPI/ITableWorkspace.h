@@ -297,6 +297,15 @@ protected:
     c->resize(size);
   }
 
+  /**  Reserve room in a column.
+         @param c :: Pointer to the column
+         @param size :: Number of elements to make room for
+   */
+  void reserveInColumn(Column* c,size_t size)
+  {
+    c->reserve(size);
+  }
+
   /**  Insert a new element into a column.
          @param c :: Pointer to the column
          @param index :: Index in the column before which a new element wil be inserted.
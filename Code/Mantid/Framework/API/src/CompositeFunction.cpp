@@ -5,6 +5,8 @@
 #include "MantidAPI/ParameterTie.h"
 #include "MantidAPI/IConstraint.h"
 #include "MantidAPI/FunctionFactory.h"
+#include "MantidAPI/FunctionDomain1D.h"
+#include "MantidAPI/IPeakFunction.h"
 #include "MantidKernel/Exception.h"
 #include "MantidKernel/Logger.h"
 
@@ -24,6 +26,58 @@ namespace API
   {
     /// static logger
     Kernel::Logger g_log("CompositeFunction");
+
+    /**
+     * Get a 1D domain if its x values are sorted in ascending order
+     * @param domain :: A domain to check
+     * @return Pointer to the 1D domain or NULL if the domain isn't 1D or isn't sorted
+     */
+    const FunctionDomain1D* getSortedDomain1D(const FunctionDomain& domain)
+    {
+      const FunctionDomain1D* d1d = dynamic_cast<const FunctionDomain1D*>(&domain);
+      if (!d1d || d1d->size() == 0) return NULL;
+      const double* x = d1d->getPointerAt(0);
+      for(size_t i = 1; i < d1d->size(); ++i)
+      {
+        if (x[i] < x[i-1]) return NULL;
+      }
+      return d1d;
+    }
+
+    /**
+     * Find the range of points of a sorted domain which are strictly inside a peak's interval
+     * @param peak :: A peak function
+     * @param domain :: A sorted 1D domain
+     * @return A pair of the index of the first point inside the interval and the number of points
+     */
+    std::pair<size_t,size_t> getPeakRange(const IPeakFunction& peak, const FunctionDomain1D& domain)
+    {
+      const std::pair<double,double> interval = peak.getDomainInterval();
+      const double* begin = domain.getPointerAt(0);
+      const double* end = begin + domain.size();
+      const double* first = std::upper_bound(begin, end, interval.first);
+      const double* last = std::lower_bound(first, end, interval.second);
+      return std::make_pair(static_cast<size_t>(first - begin), static_cast<size_t>(last - first));
+    }
+
+    /**
+     * Set the derivatives of a range of data points to zero
+     * @param jacobian :: The Jacobian to modify
+     * @param iStart :: The first data point
+     * @param iEnd :: One past the last data point
+     * @param iP0 :: The index of the first parameter
+     * @param np :: The number of parameters
+     */
+    void zeroDerivatives(Jacobian& jacobian, size_t iStart, size_t iEnd, size_t iP0, size_t np)
+    {
+      for(size_t i = iStart; i < iEnd; ++i)
+      {
+        for(size_t ip = 0; ip < np; ++ip)
+        {
+          jacobian.set(i,iP0 + ip,0.0);
+        }
+      }
+    }
   }
 
 using std::size_t;
@@ -161,10 +215,25 @@ void CompositeFunction::function(const FunctionDomain& domain, FunctionValues& v
 {
   FunctionValues tmp(domain);
   values.zeroCalculated();
+  // peaks on a sorted 1D domain are calculated only inside their intervals
+  const FunctionDomain1D* sortedDomain = getSortedDomain1D(domain);
   for(size_t iFun = 0; iFun < nFunctions(); ++iFun)
   {
-    m_functions[ iFun ]->function(domain,tmp);
-    values += tmp;
+    const IPeakFunction* peak = sortedDomain ? dynamic_cast<const IPeakFunction*>(m_functions[ iFun ].get()) : NULL;
+    if (peak)
+    {
+      std::pair<size_t,size_t> range = getPeakRange(*peak, *sortedDomain);
+      if (range.second == 0) continue;
+      FunctionDomain1DView peakDomain(sortedDomain->getPointerAt(range.first), range.second);
+      FunctionValues peakValues(peakDomain);
+      peak->function(peakDomain,peakValues);
+      values.addToCalculated(range.first, peakValues);
+    }
+    else
+    {
+      m_functions[ iFun ]->function(domain,tmp);
+      values += tmp;
+    }
   }
 }
 
@@ -181,10 +250,29 @@ void CompositeFunction::functionDeriv(const FunctionDomain& domain, Jacobian& ja
   }
   else
   {
+    const FunctionDomain1D* sortedDomain = getSortedDomain1D(domain);
     for(size_t iFun = 0; iFun < nFunctions(); ++iFun)
     {
-      PartialJacobian J(&jacobian,paramOffset(iFun));
-      getFunction(iFun)->functionDeriv(domain,J);
+      IPeakFunction* peak = sortedDomain ? dynamic_cast<IPeakFunction*>(m_functions[ iFun ].get()) : NULL;
+      if (peak)
+      {
+        // outside its interval the derivatives of a peak are zero
+        std::pair<size_t,size_t> range = getPeakRange(*peak, *sortedDomain);
+        const size_t iP0 = paramOffset(iFun);
+        const size_t np = peak->nParams();
+        const size_t rangeEnd = range.first + range.second;
+        zeroDerivatives(jacobian, 0, range.first, iP0, np);
+        zeroDerivatives(jacobian, rangeEnd, domain.size(), iP0, np);
+        if (range.second == 0) continue;
+        FunctionDomain1DView peakDomain(sortedDomain->getPointerAt(range.first), range.second);
+        PartialJacobian J(&jacobian,range.first,iP0);
+        peak->functionDeriv(peakDomain,J);
+      }
+      else
+      {
+        PartialJacobian J(&jacobian,paramOffset(iFun));
+        getFunction(iFun)->functionDeriv(domain,J);
+      }
     }
   }
 }
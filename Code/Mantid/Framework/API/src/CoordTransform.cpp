@@ -58,7 +58,19 @@ namespace API
     return out;
   }
 
-
+  //----------------------------------------------------------------------------------------------
+  /** Apply the transformation to several points at once.
+   * This calls apply() for each point; subclasses override it with a faster loop.
+   *
+   * @param inputVectors :: numPoints points of inD coordinates each, one after another
+   * @param outVectors :: numPoints*outD array filled with the transformed points
+   * @param numPoints :: the number of points to transform
+   */
+  void CoordTransform::applyMany(const coord_t * inputVectors, coord_t * outVectors, const size_t numPoints) const
+  {
+    for (size_t i = 0; i < numPoints; ++i)
+      this->apply(inputVectors + i * inD, outVectors + i * outD);
+  }
 
 } // namespace Mantid
 } // namespace API
@@ -1,6 +1,7 @@
 #include "MantidAPI/FileLoaderRegistry.h"
 #include "MantidAPI/IFileLoader.h"
 
+#include <Poco/Exception.h>
 #include <Poco/File.h>
 
 namespace Mantid
@@ -9,6 +10,9 @@ namespace Mantid
   {
     namespace
     {
+      /// The number of files whose chosen loader is remembered
+      const size_t MAX_CACHED_CHOICES = 100;
+
       //----------------------------------------------------------------------------------------------
       // Anonymous namespace helpers
       //----------------------------------------------------------------------------------------------
@@ -88,11 +92,14 @@ namespace Mantid
       {
         removeAlgorithm(name, version, *it);
       }
+      clearCache();
     }
 
     /**
      * Queries each registered algorithm and asks it how confident it is that it can
      * load the given file. The name of the one with the highest confidence is returned.
+     * If a loader has already been chosen for the file and it has not changed since then
+     * a new instance of the same loader is returned without querying the others.
      * @param filename A full file path pointing to an existing file
      * @return A string containing the name of an algorithm to load the file
      * @throws Exception::NotFoundError if an algorithm cannot be found
@@ -104,7 +111,14 @@ namespace Mantid
 
       m_log.debug() << "Trying to find loader for '" << filename << "'" << std::endl;
 
-      IAlgorithm_sptr bestLoader;
+      Poco::File file(filename);
+      IAlgorithm_sptr bestLoader = findCachedLoader(filename, file);
+      if(bestLoader)
+      {
+        m_log.debug() << "Using previously chosen loader " << bestLoader->name() << " for file '" << filename << "'" << std::endl;
+        return bestLoader;
+      }
+
       if(NexusDescriptor::isHDF(filename))
       {
         m_log.debug() << filename << " looks like a Nexus file. Checking registered Nexus loaders\n";
@@ -121,6 +135,7 @@ namespace Mantid
         throw Kernel::Exception::NotFoundError(filename, "Unable to find loader");
       }
       m_log.debug() << "Found loader " << bestLoader->name() << " for file '" << filename << "'" << std::endl;
+      cacheLoader(filename, file, bestLoader);
       return bestLoader;
     }
 
@@ -166,6 +181,7 @@ namespace Mantid
      */
     FileLoaderRegistryImpl::FileLoaderRegistryImpl() :
         m_names(2, std::multimap<std::string,int>()), m_totalSize(0),
+        m_choices(), m_choiceIndex(), m_choiceMutex(),
         m_log("FileLoaderRegistry")
     {
     }
@@ -176,6 +192,83 @@ namespace Mantid
     {
     }
 
+    /**
+     * @param filename The name of the file to load
+     * @param file The file object for the filename
+     * @return A new instance of the loader previously chosen for the file, or an empty pointer if there
+     * is none or the file has been modified since
+     */
+    IAlgorithm_sptr FileLoaderRegistryImpl::findCachedLoader(const std::string & filename, const Poco::File & file) const
+    {
+      std::string name;
+      int version(-1);
+      {
+        Kernel::Mutex::ScopedLock lock(m_choiceMutex);
+        auto indexIt = m_choiceIndex.find(filename);
+        if(indexIt == m_choiceIndex.end()) return IAlgorithm_sptr();
+
+        auto choice = indexIt->second;
+        if(!file.exists() || file.getLastModified() != choice->modified || file.getSize() != choice->size)
+        {
+          m_choices.erase(choice);
+          m_choiceIndex.erase(indexIt);
+          return IAlgorithm_sptr();
+        }
+        m_choices.splice(m_choices.begin(), m_choices, choice); // now most recently used
+        name = choice->name;
+        version = choice->version;
+      }
+      return AlgorithmFactory::Instance().create(name, version);
+    }
+
+    /**
+     * @param filename The name of the file that was checked
+     * @param file The file object for the filename
+     * @param loader The loader chosen for the file
+     */
+    void FileLoaderRegistryImpl::cacheLoader(const std::string & filename, const Poco::File & file,
+                                             const IAlgorithm_sptr & loader) const
+    {
+      CachedChoice choice;
+      choice.filename = filename;
+      try
+      {
+        choice.modified = file.getLastModified();
+        choice.size = file.getSize();
+      }
+      catch(Poco::Exception &)
+      {
+        return; // not a plain file, e.g. a stream. Don't remember it
+      }
+      choice.name = loader->name();
+      choice.version = loader->version();
+
+      Kernel::Mutex::ScopedLock lock(m_choiceMutex);
+      auto indexIt = m_choiceIndex.find(filename);
+      if(indexIt != m_choiceIndex.end())
+      {
+        m_choices.erase(indexIt->second);
+        m_choiceIndex.erase(indexIt);
+      }
+      m_choices.push_front(choice);
+      m_choiceIndex[filename] = m_choices.begin();
+      if(m_choices.size() > MAX_CACHED_CHOICES)
+      {
+        m_choiceIndex.erase(m_choices.back().filename);
+        m_choices.pop_back();
+      }
+    }
+
+    /**
+     * Forget all of the loaders chosen so far. Called whenever the registered loaders change
+     */
+    void FileLoaderRegistryImpl::clearCache()
+    {
+      Kernel::Mutex::ScopedLock lock(m_choiceMutex);
+      m_choices.clear();
+      m_choiceIndex.clear();
+    }
+
     /**
      * @param name A string containing the algorithm name
      * @param version The version to remove. -1 indicates all instances
@@ -132,6 +132,19 @@ void IPeakFunction::functionDeriv1D(Jacobian* out, const double* xValues, const
   this->functionDerivLocal(&J,xValues+i0,n);
 }
 
+/**
+ * Get the interval of x outside which function1D() and functionDeriv1D() return zeros.
+ * Only the points strictly inside the interval need to be evaluated, which allows a
+ * composite of many narrow peaks to calculate each peak on a small part of the domain.
+ * @return A pair of the left and right bounds of the interval
+ */
+std::pair<double,double> IPeakFunction::getDomainInterval() const
+{
+  const double c = this->centre();
+  const double dx = fabs(s_peakRadius*this->fwhm());
+  return std::make_pair(c - dx, c + dx);
+}
+
 void IPeakFunction::setPeakRadius(const int& r)
 {
   if (r > 0)
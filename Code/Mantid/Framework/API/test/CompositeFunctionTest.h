@@ -11,6 +11,8 @@
 #include "MantidAPI/ParamFunction.h"
 #include "MantidAPI/IFunction1D.h"
 #include "MantidAPI/FunctionFactory.h"
+#include "MantidAPI/FunctionDomain1D.h"
+#include "MantidAPI/FunctionValues.h"
 
 using namespace Mantid;
 using namespace Mantid::API;
@@ -225,6 +227,22 @@ public:
 
 };
 
+class CompositeFunctionTest_Jacobian: public Jacobian
+{
+public:
+  CompositeFunctionTest_Jacobian(size_t ny, size_t np, double value = 0.0):m_np(np),m_data(ny*np,value){}
+  void set(size_t iY, size_t iP, double value)
+  {
+    m_data[iY * m_np + iP] = value;
+  }
+  double get(size_t iY, size_t iP)
+  {
+    return m_data[iY * m_np + iP];
+  }
+  size_t m_np;
+  std::vector<double> m_data;
+};
+
 class CompositeFunctionTest : public CxxTest::TestSuite
 {
 public:
@@ -1226,6 +1244,70 @@ public:
     delete mfun;
   }
 
+  void test_peaks_are_calculated_inside_their_intervals()
+  {
+    CompositeFunction mfun;
+    mfun.addFunction(IFunction_sptr(new Linear()));
+    mfun.setParameter(0,0.3);
+    mfun.setParameter(1,0.01);
+    for(size_t i = 0; i < 10; ++i)
+    {
+      IFunction_sptr g(new Gauss());
+      g->setParameter("c",1.0 + 2.0 * static_cast<double>(i));
+      g->setParameter("h",1.0 + 0.1 * static_cast<double>(i));
+      g->setParameter("s",0.5);
+      mfun.addFunction(g);
+    }
+
+    std::vector<double> x(2000);
+    for(size_t i = 0; i < x.size(); ++i)
+    {
+      x[i] = 0.01 * static_cast<double>(i);
+    }
+    FunctionDomain1DVector domain(x);
+    FunctionValues values(domain);
+    mfun.function(domain,values);
+
+    // reversed x values aren't sorted and the members are calculated on the whole domain
+    std::vector<double> xReversed(x.rbegin(),x.rend());
+    FunctionDomain1DVector domainReversed(xReversed);
+    FunctionValues valuesReversed(domainReversed);
+    mfun.function(domainReversed,valuesReversed);
+
+    std::vector<double> expected(x.size(),0.0);
+    FunctionValues tmp(domain);
+    for(size_t iFun = 0; iFun < mfun.nFunctions(); ++iFun)
+    {
+      mfun.getFunction(iFun)->function(domain,tmp);
+      for(size_t i = 0; i < x.size(); ++i)
+      {
+        expected[i] += tmp[i];
+      }
+    }
+
+    for(size_t i = 0; i < x.size(); ++i)
+    {
+      TS_ASSERT_DELTA(values[i], expected[i], 1e-12);
+      TS_ASSERT_DELTA(valuesReversed[x.size() - 1 - i], expected[i], 1e-12);
+    }
+
+    // derivatives outside the peak intervals must be set to zero
+    CompositeFunctionTest_Jacobian jacobian(x.size(),mfun.nParams(),999.0);
+    mfun.functionDeriv(domain,jacobian);
+    CompositeFunctionTest_Jacobian expectedJacobian(x.size(),mfun.nParams());
+    size_t paramOffset = 0;
+    for(size_t iFun = 0; iFun < mfun.nFunctions(); ++iFun)
+    {
+      PartialJacobian J(&expectedJacobian,paramOffset);
+      mfun.getFunction(iFun)->functionDeriv(domain,J);
+      paramOffset += mfun.getFunction(iFun)->nParams();
+    }
+    for(size_t i = 0; i < jacobian.m_data.size(); ++i)
+    {
+      TS_ASSERT_DELTA(jacobian.m_data[i], expectedJacobian.m_data[i], 1e-12);
+    }
+  }
+
   void test_ctreatingWithFactory()
   {
     std::string funStr = "composite=CompositeFunction,NumDeriv=true;name=Linear;name=Linear";
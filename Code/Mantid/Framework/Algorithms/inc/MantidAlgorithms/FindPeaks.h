@@ -75,7 +75,28 @@ public:
   int getVectorIndex(const MantidVec &vecX, double x);
 
 private:
-  
+
+  /// A row of the output table, held by a fit context until all spectra are fitted
+  struct PeakRow
+  {
+    /// Workspace index of the spectrum
+    int spectrum;
+    /// Peak/background parameters followed by the cost function value
+    std::vector<double> values;
+    /// Rows are ordered by spectrum
+    bool operator<(const PeakRow &other) const { return spectrum < other.spectrum; }
+  };
+
+  /** Fit context owned by one thread: the peak and background functions are reused
+    * for every peak fitted by the thread and the resulting rows are collected locally
+    */
+  struct FitContext
+  {
+    API::IPeakFunction_sptr peakFunction;
+    API::IBackgroundFunction_sptr backgroundFunction;
+    std::vector<PeakRow> rows;
+  };
+
   void init();
   void exec();
 
@@ -95,14 +116,17 @@ private:
   long long computePhi(const int& w) const;
 
   /// Fit peak confined in a given window (x-min, x-max)
-  void fitPeakInWindow(const API::MatrixWorkspace_sptr &input, const int spectrum, const double centre, const double xmin, const double xmax);
+  void fitPeakInWindow(FitContext &context, const API::MatrixWorkspace_sptr &input, const int spectrum,
+                       const double centre, const double xmin, const double xmax);
 
   /// Fit peak by given/guessed FWHM
-  void fitPeakGivenFWHM(const API::MatrixWorkspace_sptr &input, const int spectrum, const double center_guess, const int fitWidth,
+  void fitPeakGivenFWHM(FitContext &context, const API::MatrixWorkspace_sptr &input, const int spectrum,
+                        const double center_guess, const int fitWidth,
                         const bool hasleftpeak, const double leftpeakcentre, const bool hasrightpeak, const double rightpeakcentre);
 
   /// Fit peak: this is a basic peak fit function as a root function for all different type of user input
-  void fitSinglePeak(const API::MatrixWorkspace_sptr &input, const int spectrum, const int i_min, const int i_max, const int i_centre);
+  void fitSinglePeak(FitContext &context, const API::MatrixWorkspace_sptr &input, const int spectrum,
+                     const int i_min, const int i_max, const int i_centre);
 
   void fitPeakHighBackground(const API::MatrixWorkspace_sptr &input, const size_t spectrum, int i_centre, int i_min, int i_max,
                              double &in_bg0, double &in_bg1, double &in_bg2, int i_peakmin, int i_peakmax);
@@ -111,17 +135,26 @@ private:
                       const double& in_bg0, const double& in_bg1, const double& in_bg2);
 
   /// Add a new row in output TableWorkspace containing information of the fitted peak+background
-  void addInfoRow(const size_t spectrum, const API::IPeakFunction_const_sptr& peakfunction,
+  void addInfoRow(FitContext &context, const size_t spectrum, const API::IPeakFunction_const_sptr& peakfunction,
                   const API::IBackgroundFunction_sptr& bkgdfunction,
                   const bool isoutputraw,
                   const double mincost);
 
   /// Add the fit record (failure) to output workspace
-  void addNonFitRecord(const size_t spectrum);
+  void addNonFitRecord(FitContext &context, const size_t spectrum);
 
   /// Create peak and background functions
   void createFunctions();
 
+  /// Create one fit context per thread from the peak and background functions
+  void createFitContexts();
+
+  /// Set the functions of a fit context back to their starting parameter values
+  void resetFitContext(FitContext &context) const;
+
+  /// Merge the rows collected by all fit contexts into the output table in spectrum order
+  void fillOutputPeakParameterTable();
+
   /// Find peak background
   bool findPeakBackground(const API::MatrixWorkspace_sptr& input, int spectrum, size_t i_min, size_t i_max,
                           std::vector<double>& vecBkgdParamValues, std::vector<double>& vecpeakrange);
@@ -195,6 +228,11 @@ private:
   double m_peakPositionTolerance;
 
   std::vector<API::IFunction_sptr> m_fitFunctions;
+  /// Fit contexts indexed by thread number
+  std::vector<FitContext> m_fitContexts;
+  /// Parameter values of the peak and background functions before any fit
+  std::vector<double> m_initialPeakParameters;
+  std::vector<double> m_initialBackgroundParameters;
   std::vector<size_t> m_peakLeftIndexes;
   std::vector<size_t> m_peakRightIndexes;
 
@@ -2,6 +2,7 @@
 // Includes
 //----------------------------------------------------------------------
 #include "MantidAlgorithms/FFT.h"
+#include "MantidKernel/FFTPlanCache.h"
 #include "MantidKernel/UnitFactory.h"
 #include "MantidAPI/TextAxis.h"
 
@@ -97,7 +98,7 @@ void FFT::exec()
     }
   
 
-  gsl_fft_complex_wavetable * wavetable = gsl_fft_complex_wavetable_alloc(ySize);
+  auto wavetable = Kernel::FFTPlanCache::Instance().complexWavetable(ySize);
   gsl_fft_complex_workspace * workspace = gsl_fft_complex_workspace_alloc(ySize);
 
   boost::shared_array<double> data(new double[2*ySize]);
@@ -179,7 +180,7 @@ void FFT::exec()
     double shift = getProperty("Shift"); // extra phase to be applied to the transform
     shift *= 2 * M_PI;
 
-    gsl_fft_complex_forward (data.get(), 1, ySize, wavetable, workspace);
+    gsl_fft_complex_forward (data.get(), 1, ySize, wavetable.get(), workspace);
     /* The Fourier transform overwrites array 'data'. Recall that the Fourier transform is
      * periodic along the frequency axis. Thus, 'data' takes the same values when index j runs
      * from ySize/2 to ySize than if index j would run from -ySize/2 to 0. Thus, for negative
@@ -236,7 +237,7 @@ void FFT::exec()
       data[2*i] = inWS->dataY(iReal)[j];
       data[2*i+1] = isComplex? inImagWS->dataY(iImag)[j] : 0.;
     }
-    gsl_fft_complex_inverse(data.get(), 1, ySize, wavetable, workspace);
+    gsl_fft_complex_inverse(data.get(), 1, ySize, wavetable.get(), workspace);
     for(int i=0;i<ySize;i++)
     {
       double x = df*i;
@@ -252,7 +253,6 @@ void FFT::exec()
     if (xSize == ySize + 1) outWS->dataX(0)[ySize] = outWS->dataX(0)[ySize - 1] + df;
   }
 
-  gsl_fft_complex_wavetable_free (wavetable);
   gsl_fft_complex_workspace_free (workspace);
 
   outWS->dataX(1) = outWS->dataX(0);
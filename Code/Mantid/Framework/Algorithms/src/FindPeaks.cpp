@@ -19,6 +19,7 @@
 #include <numeric>
 #include "MantidKernel/BoundedValidator.h"
 #include "MantidKernel/ListValidator.h"
+#include "MantidKernel/MultiThreaded.h"
 
 #include <fstream>
 
@@ -50,7 +51,7 @@ namespace Algorithms
     m_backgroundFunction(), m_peakFunction(),
     m_minGuessedPeakWidth(0), m_maxGuessedPeakWidth(0), m_stepGuessedPeakWidth(0),
     m_usePeakPositionTolerance(false), m_peakPositionTolerance(0.0),
-    m_fitFunctions(), m_peakLeftIndexes(), m_peakRightIndexes(),
+    m_fitFunctions(), m_fitContexts(), m_peakLeftIndexes(), m_peakRightIndexes(),
     m_minimizer("Levenberg-MarquardtMD"), m_costFunction(),
     m_minHeight(0.0), m_useObsCentre(false)
   {
@@ -161,6 +162,9 @@ namespace Algorithms
     // Set up output table workspace
     generateOutputPeakParameterTable();
 
+    // Functions reused by each thread
+    createFitContexts();
+
     // Fit
     if (!m_vecPeakCentre.empty())
     {
@@ -183,6 +187,9 @@ namespace Algorithms
       this->findPeaksUsingMariscotti();
     }
 
+    // Collect the rows fitted by all threads
+    fillOutputPeakParameterTable();
+
     // Set output properties
     g_log.information() << "Total " << m_outPeakTableWS->rowCount()
                         << " peaks found and successfully fitted." << std::endl;
@@ -316,8 +323,13 @@ namespace Algorithms
     const int end = singleSpectrum ? m_wsIndex + 1 : static_cast<int>(m_dataWS->getNumberHistograms());
     m_progress = new Progress(this, 0.0, 1.0, end - start);
 
+    // Spectra are independent: each thread fits with its own context
+    PRAGMA_OMP(parallel for schedule(dynamic, 1) if (m_dataWS->threadSafe()) )
     for (int spec = start; spec < end; ++spec)
     {
+      PARALLEL_START_INTERUPT_REGION
+
+      FitContext &context = m_fitContexts[PARALLEL_THREAD_NUMBER];
       const MantidVec& vecX = m_dataWS->readX(spec);
 
       for (std::size_t ipeak = 0; ipeak < numPeaks; ipeak++)
@@ -337,7 +349,7 @@ namespace Algorithms
         if (x_center > vecX.front() && x_center < vecX.back())
         {
           if (useWindows)
-            fitPeakInWindow(m_dataWS, spec, x_center, fitwindows[2 * ipeak], fitwindows[2 * ipeak + 1]);
+            fitPeakInWindow(context, m_dataWS, spec, x_center, fitwindows[2 * ipeak], fitwindows[2 * ipeak + 1]);
           else
           {
             bool hasLeftPeak = (ipeak > 0);
@@ -348,7 +360,8 @@ namespace Algorithms
             double rightpeakcentre = 0.;
             if (hasRightPeak) rightpeakcentre = peakcentres[ipeak+1];
 
-            fitPeakGivenFWHM(m_dataWS, spec, x_center, m_inputPeakFWHM, hasLeftPeak, leftpeakcentre, hasRightPeak, rightpeakcentre);
+            fitPeakGivenFWHM(context, m_dataWS, spec, x_center, m_inputPeakFWHM, hasLeftPeak, leftpeakcentre,
+                             hasRightPeak, rightpeakcentre);
           }
         }
         else
@@ -361,7 +374,9 @@ namespace Algorithms
 
       m_progress->report();
 
+      PARALLEL_END_INTERUPT_REGION
     } // loop over spectra
+    PARALLEL_CHECK_INTERUPT_REGION
 
   }
 
@@ -402,8 +417,13 @@ namespace Algorithms
     m_progress = new Progress(this, 0.0, 1.0, end - start);
     const int blocksize = static_cast<int>(smoothedData->blocksize());
 
+    // Spectra are independent: each thread fits with its own context
+    PRAGMA_OMP(parallel for schedule(dynamic, 1) if (m_dataWS->threadSafe()) )
     for (int k = start; k < end; ++k)
     {
+      PARALLEL_START_INTERUPT_REGION
+
+      FitContext &context = m_fitContexts[PARALLEL_THREAD_NUMBER];
       const MantidVec &S = smoothedData->readY(k);
       const MantidVec &F = smoothedData->readE(k);
 
@@ -555,7 +575,7 @@ namespace Algorithms
           if (i_max >= wssize)
             i_max = wssize - 1;
 
-          this->fitSinglePeak(m_dataWS, k, i_min, i_max, i4);
+          this->fitSinglePeak(context, m_dataWS, k, i_min, i_max, i4);
 
           // reset and go searching for the next peak
           i1 = 0, i2 = 0, i3 = 0, i4 = 0, i5 = 0;
@@ -565,7 +585,9 @@ namespace Algorithms
 
       m_progress->report();
 
+      PARALLEL_END_INTERUPT_REGION
     } // loop over spectra
+    PARALLEL_CHECK_INTERUPT_REGION
 
   }
 
@@ -765,6 +787,7 @@ namespace Algorithms
   /** Attempts to fit a candidate peak given a center and width guess.
     * (This is not the CORE fit peak method)
     *
+    *  @param context :: fit context of the calling thread
     *  @param input ::    The input workspace
     *  @param spectrum :: The spectrum index of the peak (is actually the WorkspaceIndex)
     *  @param center_guess :: A guess of the X-value of the center of the peak, in whatever units of the X-axis of the workspace.
@@ -774,7 +797,7 @@ namespace Algorithms
     *  @param hasrightpeak :: flag to show that there is a specified peak to its right
     *  @param rightpeakcentre :: centre of the right peak if existed
     */
-  void FindPeaks::fitPeakGivenFWHM(const API::MatrixWorkspace_sptr &input, const int spectrum,
+  void FindPeaks::fitPeakGivenFWHM(FitContext &context, const API::MatrixWorkspace_sptr &input, const int spectrum,
                                    const double center_guess, const int fitWidth,
                                    const bool hasleftpeak, const double leftpeakcentre,
                                    const bool hasrightpeak, const double rightpeakcentre)
@@ -825,7 +848,7 @@ namespace Algorithms
           << ", " << vecX[i_max];
     g_log.information(outss.str());
 
-    fitSinglePeak(input, spectrum, i_min, i_max, i_centre);
+    fitSinglePeak(context, input, spectrum, i_min, i_max, i_centre);
 
     return;
   }
@@ -833,13 +856,14 @@ namespace Algorithms
   //----------------------------------------------------------------------------------------------
   /** Attempts to fit a candidate peak with a given window of where peak resides
     *
+    *  @param context :: fit context of the calling thread
     *  @param input    The input workspace
     *  @param spectrum The spectrum index of the peak (is actually the WorkspaceIndex)
     *  @param centre_guess ::  Channel number of peak candidate i0 - the higher side of the peak (right side)
     *  @param xmin    Minimum x value to find the peak
     *  @param xmax    Maximum x value to find the peak
     */
-  void FindPeaks::fitPeakInWindow(const API::MatrixWorkspace_sptr &input, const int spectrum,
+  void FindPeaks::fitPeakInWindow(FitContext &context, const API::MatrixWorkspace_sptr &input, const int spectrum,
                                   const double centre_guess, const double xmin, const double xmax)
   {
     // Check
@@ -849,7 +873,7 @@ namespace Algorithms
     if (xmin >= centre_guess || xmax <= centre_guess)
     {
       g_log.error("Peak centre is on the edge of Fit window. ");
-      addNonFitRecord(spectrum);
+      addNonFitRecord(context, spectrum);
       return;
     }
 
@@ -865,7 +889,7 @@ namespace Algorithms
     {
       g_log.error() << "Input peak centre @ " << centre_guess << " is out side of minimum x = "
                     << xmin << ".  Input X ragne = " << vecX.front() << ", " << vecX.back() << "\n";
-      addNonFitRecord(spectrum);
+      addNonFitRecord(context, spectrum);
       return;
     }
 
@@ -875,12 +899,12 @@ namespace Algorithms
     {
       g_log.error() << "Input peak centre @ " << centre_guess << " is out side of maximum x = "
             << xmax << "\n";
-      addNonFitRecord(spectrum);
+      addNonFitRecord(context, spectrum);
       return;
     }
 
     // finally do the actual fit
-    fitSinglePeak(input, spectrum, i_min, i_max, i_centre);
+    fitSinglePeak(context, input, spectrum, i_min, i_max, i_centre);
 
     return;
   }
@@ -889,10 +913,16 @@ namespace Algorithms
   //----------------------------------------------------------------------------------------------
   /** Fit a single peak
     * This is the fundametary peak fit function used by all kinds of input
+    * @param context :: fit context of the calling thread, whose functions are used for fitting
     */
-  void FindPeaks::fitSinglePeak(const API::MatrixWorkspace_sptr &input, const int spectrum,
+  void FindPeaks::fitSinglePeak(FitContext &context, const API::MatrixWorkspace_sptr &input, const int spectrum,
                                 const int i_min, const int i_max, const int i_centre)
   {
+    // Start from the same guesses whichever thread fits the peak and whatever it fitted before
+    resetFitContext(context);
+    IPeakFunction_sptr peakfunction = context.peakFunction;
+    IBackgroundFunction_sptr bkgdfunction = context.backgroundFunction;
+
     const MantidVec& vecX = input->readX(spectrum);
     const MantidVec& vecY = input->readY(spectrum);
 
@@ -909,7 +939,7 @@ namespace Algorithms
       std::stringstream ess;
       ess << "Peak supposed at " << vecY[i_centre] << " does not have enough counts as " << m_leastMaxObsY;
       g_log.debug(ess.str());
-      addNonFitRecord(spectrum);
+      addNonFitRecord(context, spectrum);
       return;
     }
 
@@ -934,7 +964,7 @@ namespace Algorithms
 
     for (size_t i = 0; i < vecbkgdparvalue.size(); ++i)
       if (i < m_bkgdOrder)
-        m_backgroundFunction->setParameter(i, vecbkgdparvalue[i]);
+        bkgdfunction->setParameter(i, vecbkgdparvalue[i]);
 
     // Estimate peak parameters
     double est_height(0.0), est_fwhm(0.0);
@@ -953,11 +983,11 @@ namespace Algorithms
 
     // Set peak parameters to
     if (m_useObsCentre)
-      m_peakFunction->setCentre(vecX[i_obscentre]);
+      peakfunction->setCentre(vecX[i_obscentre]);
     else
-      m_peakFunction->setCentre(vecX[i_centre]);
-    m_peakFunction->setHeight(est_height);
-    m_peakFunction->setFwhm(est_fwhm);
+      peakfunction->setCentre(vecX[i_centre]);
+    peakfunction->setHeight(est_height);
+    peakfunction->setFwhm(est_fwhm);
 
     if (!usefpdresult)
     {
@@ -973,12 +1003,12 @@ namespace Algorithms
     fitwindow[0] = vecX[i_min];
     fitwindow[1] = vecX[i_max];
 
-    double costfuncvalue = callFitPeak(input, spectrum, m_peakFunction, m_backgroundFunction, fitwindow,
+    double costfuncvalue = callFitPeak(input, spectrum, peakfunction, bkgdfunction, fitwindow,
                                        vecpeakrange, m_minGuessedPeakWidth, m_maxGuessedPeakWidth,
                                        m_stepGuessedPeakWidth);
 
     bool fitsuccess = false;
-    if (costfuncvalue < DBL_MAX && costfuncvalue >= 0. && m_peakFunction->height() > m_minHeight)
+    if (costfuncvalue < DBL_MAX && costfuncvalue >= 0. && peakfunction->height() > m_minHeight)
       fitsuccess = true;
 
     //-------------------------------------------------------------------------
@@ -986,9 +1016,9 @@ namespace Algorithms
     //-------------------------------------------------------------------------
     // Update output
     if (fitsuccess)
-      addInfoRow(spectrum, m_peakFunction, m_backgroundFunction, m_rawPeaksTable, costfuncvalue);
+      addInfoRow(context, spectrum, peakfunction, bkgdfunction, m_rawPeaksTable, costfuncvalue);
     else
-      addNonFitRecord(spectrum);
+      addNonFitRecord(context, spectrum);
 
     return;
   }
@@ -1341,6 +1371,8 @@ namespace Algorithms
 
   //----------------------------------------------------------------------------------------------
   /** Add a row to the output table workspace.
+    * The row is kept by the fit context and written to the table by fillOutputPeakParameterTable().
+    * @param context :: fit context of the calling thread
     * @param spectrum :: spectrum number
     * @param peakfunction :: peak function
     * @param bkgdfunction :: background function
@@ -1348,7 +1380,7 @@ namespace Algorithms
     * @param mincost Chi2 value for this set of parameters
     * @param mincost :: minimum/best cost function value
     */
-  void FindPeaks::addInfoRow(const size_t spectrum, const API::IPeakFunction_const_sptr& peakfunction,
+  void FindPeaks::addInfoRow(FitContext &context, const size_t spectrum, const API::IPeakFunction_const_sptr& peakfunction,
                              const API::IBackgroundFunction_sptr& bkgdfunction,
                              const bool isoutputraw, const double mincost)
   {
@@ -1358,10 +1390,12 @@ namespace Algorithms
                                "under this circumstance. ");
 
     // Add fitted parameters to output table workspace
-    API::TableRow t = m_outPeakTableWS->appendRow();
+    PeakRow row;
 
     // spectrum
-    t << static_cast<int>(spectrum);
+    row.spectrum = static_cast<int>(spectrum);
+    std::vector<double> &t = row.values;
+    t.reserve(m_numTableParams + 1);
 
     // peak and background function parameters
     if (isoutputraw)
@@ -1378,11 +1412,11 @@ namespace Algorithms
 
       for (size_t i = 0; i < nparams; ++i)
       {
-        t << peakfunction->getParameter(i);
+        t.push_back(peakfunction->getParameter(i));
       }
       for (size_t i = 0; i < nparamsb; ++i)
       {
-        t << bkgdfunction->getParameter(i);
+        t.push_back(bkgdfunction->getParameter(i));
       }
     }
     else
@@ -1393,7 +1427,9 @@ namespace Algorithms
       double fwhm = peakfunction->fwhm();
       double height = peakfunction->height();
 
-      t << peakcentre << fwhm << height;
+      t.push_back(peakcentre);
+      t.push_back(fwhm);
+      t.push_back(height);
 
       // Set up parameters to background function
 
@@ -1406,33 +1442,37 @@ namespace Algorithms
       if (bkgdfunction->name() != "LinearBackground" && bkgdfunction->name() != "FlatBackground")
         a2 = bkgdfunction->getParameter("A2");
 
-      t << a0 << a1 << a2;
+      t.push_back(a0);
+      t.push_back(a1);
+      t.push_back(a2);
     }
 
     // Minimum cost function value
-    t << mincost;
+    t.push_back(mincost);
+    context.rows.push_back(row);
 
     return;
   }
 
   //----------------------------------------------------------------------------------------------
   /** Add the fit record (failure) to output workspace
+    * @param context :: fit context of the calling thread
     * @param spectrum :: spectrum where the peak is
     */
-  void FindPeaks::addNonFitRecord(const size_t spectrum)
+  void FindPeaks::addNonFitRecord(FitContext &context, const size_t spectrum)
   {
     // Add a new row
-    API::TableRow t = m_outPeakTableWS->appendRow();
+    PeakRow row;
 
     // 1st column
-    t << static_cast<int>(spectrum);
+    row.spectrum = static_cast<int>(spectrum);
 
     // Parameters
-    for (std::size_t i = 0; i < m_numTableParams; i++)
-      t << 0.;
+    row.values.assign(m_numTableParams, 0.);
 
     // HUGE chi-square
-    t << DBL_MAX;
+    row.values.push_back(DBL_MAX);
+    context.rows.push_back(row);
 
     return;
   }
@@ -1466,6 +1506,82 @@ namespace Algorithms
     return;
   }
 
+  //----------------------------------------------------------------------------------------------
+  /** Create a fit context for each thread.  Each context owns a copy of the peak and background
+    * functions, so that threads can fit different spectra at the same time.
+    */
+  void FindPeaks::createFitContexts()
+  {
+    m_initialPeakParameters.resize(m_peakFunction->nParams());
+    for (size_t i = 0; i < m_initialPeakParameters.size(); ++i)
+      m_initialPeakParameters[i] = m_peakFunction->getParameter(i);
+    m_initialBackgroundParameters.resize(m_backgroundFunction->nParams());
+    for (size_t i = 0; i < m_initialBackgroundParameters.size(); ++i)
+      m_initialBackgroundParameters[i] = m_backgroundFunction->getParameter(i);
+
+    const size_t numthreads = static_cast<size_t>(PARALLEL_GET_MAX_THREADS);
+    m_fitContexts.clear();
+    m_fitContexts.resize(numthreads);
+    for (size_t i = 0; i < numthreads; ++i)
+    {
+      FitContext &context = m_fitContexts[i];
+      context.peakFunction = boost::dynamic_pointer_cast<IPeakFunction>(m_peakFunction->clone());
+      context.backgroundFunction = boost::dynamic_pointer_cast<IBackgroundFunction>(m_backgroundFunction->clone());
+      if (!context.peakFunction || !context.backgroundFunction)
+        throw std::runtime_error("Unable to copy peak or background function for fitting. ");
+    }
+
+    return;
+  }
+
+  //----------------------------------------------------------------------------------------------
+  /** Set the peak and background functions of a fit context back to the parameter values they
+    * had before any fit, so that the result of a fit does not depend on the peaks fitted before it.
+    * @param context :: fit context to reset
+    */
+  void FindPeaks::resetFitContext(FitContext &context) const
+  {
+    for (size_t i = 0; i < m_initialPeakParameters.size(); ++i)
+      context.peakFunction->setParameter(i, m_initialPeakParameters[i]);
+    for (size_t i = 0; i < m_initialBackgroundParameters.size(); ++i)
+      context.backgroundFunction->setParameter(i, m_initialBackgroundParameters[i]);
+  }
+
+  //----------------------------------------------------------------------------------------------
+  /** Write the rows collected by all the fit contexts to the output table workspace.
+    * A spectrum is always fitted by a single thread, so a stable sort on spectrum gives
+    * the same row order as fitting the spectra one after another.
+    */
+  void FindPeaks::fillOutputPeakParameterTable()
+  {
+    std::vector<PeakRow> rows;
+    size_t numrows = 0;
+    for (size_t i = 0; i < m_fitContexts.size(); ++i)
+      numrows += m_fitContexts[i].rows.size();
+    rows.reserve(numrows);
+    for (size_t i = 0; i < m_fitContexts.size(); ++i)
+    {
+      rows.insert(rows.end(), m_fitContexts[i].rows.begin(), m_fitContexts[i].rows.end());
+      m_fitContexts[i].rows.clear();
+    }
+    std::stable_sort(rows.begin(), rows.end());
+
+    const size_t numcols = m_outPeakTableWS->columnCount();
+    m_outPeakTableWS->setRowCount(numrows);
+    for (size_t irow = 0; irow < numrows; ++irow)
+    {
+      const PeakRow &row = rows[irow];
+      if (row.values.size() + 1 != numcols)
+        throw std::runtime_error("Number of fitted values does not match the number of columns. ");
+
+      m_outPeakTableWS->Int(irow, 0) = row.spectrum;
+      for (size_t icol = 1; icol < numcols; ++icol)
+        m_outPeakTableWS->Double(irow, icol) = row.values[icol-1];
+    }
+
+    return;
+  }
+
   //----------------------------------------------------------------------------------------------
   /** Fit a single peak function with background by calling algorithm callFitPeak
     */
@@ -1481,7 +1597,7 @@ namespace Algorithms
          << " of spectrum " << wsindex;
     g_log.information(dbss.str());
 
-    double userFWHM = m_peakFunction->fwhm();
+    double userFWHM = peakfunction->fwhm();
     bool fitwithsteppedfwhm = (guessedFWHMStep > 0);
 
     FitOneSinglePeak fitpeak;
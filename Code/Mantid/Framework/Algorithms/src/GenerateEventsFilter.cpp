@@ -1871,15 +1871,27 @@ namespace Algorithms
     */
   void GenerateEventsFilter::generateSplittersInSplitterWS()
   {    
+    // Add all of the rows at once and fill the columns directly, rather than row by row
+    size_t numSplitters = 0;
+    for (size_t i = 0; i < m_vecSplitterGroup.size(); ++i)
+    {
+      if (m_vecSplitterGroup[i] >= 0)
+        ++ numSplitters;
+    }
+    size_t row = m_splitWS->appendRows(numSplitters);
+    std::vector<int64_t> & startCol = m_splitWS->getColVector<int64_t>("start");
+    std::vector<int64_t> & stopCol = m_splitWS->getColVector<int64_t>("stop");
+    std::vector<int> & groupCol = m_splitWS->getColVector<int>("workspacegroup");
+
     for (size_t i = 0; i < m_vecSplitterGroup.size(); ++i)
     {
       int groupindex = m_vecSplitterGroup[i];
       if (groupindex >= 0)
       {
-        DateAndTime start = m_vecSplitterTime[i];
-        DateAndTime stop = m_vecSplitterTime[i+1];
-        Kernel::SplittingInterval newsplit(start, stop, groupindex);
-        m_splitWS->addSplitter(newsplit);
+        startCol[row] = m_vecSplitterTime[i].totalNanoseconds();
+        stopCol[row] = m_vecSplitterTime[i+1].totalNanoseconds();
+        groupCol[row] = groupindex;
+        ++ row;
       }
     }
 
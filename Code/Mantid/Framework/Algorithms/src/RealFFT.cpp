@@ -4,6 +4,7 @@
 #include "MantidAlgorithms/RealFFT.h"
 #include "MantidAPI/MatrixWorkspace.h"
 #include "MantidKernel/Exception.h"
+#include "MantidKernel/FFTPlanCache.h"
 #include "MantidAPI/TextAxis.h"
 
 #include <boost/shared_array.hpp>
@@ -110,9 +111,8 @@ void RealFFT::exec()
             data[i] = inWS->dataY(spec)[i];
         }
 
-        gsl_fft_real_wavetable * wavetable = gsl_fft_real_wavetable_alloc(ySize);
-        gsl_fft_real_transform (data.get(), 1, ySize, wavetable, workspace);
-        gsl_fft_real_wavetable_free (wavetable);
+        auto wavetable = Kernel::FFTPlanCache::Instance().realWavetable(ySize);
+        gsl_fft_real_transform (data.get(), 1, ySize, wavetable.get(), workspace);
         gsl_fft_real_workspace_free (workspace);
 
         for(int i=0;i<yOutSize;i++)
@@ -173,9 +173,8 @@ void RealFFT::exec()
         }
       }
 
-      gsl_fft_halfcomplex_wavetable * wavetable = gsl_fft_halfcomplex_wavetable_alloc(yOutSize);
-      gsl_fft_halfcomplex_inverse(data.get(), 1, yOutSize, wavetable, workspace);
-      gsl_fft_halfcomplex_wavetable_free (wavetable);
+      auto wavetable = Kernel::FFTPlanCache::Instance().halfComplexWavetable(yOutSize);
+      gsl_fft_halfcomplex_inverse(data.get(), 1, yOutSize, wavetable.get(), workspace);
       gsl_fft_real_workspace_free (workspace);
   
       for(int i=0;i<yOutSize;i++)
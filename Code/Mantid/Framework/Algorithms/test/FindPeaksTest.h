@@ -15,7 +15,9 @@
 #include "MantidDataHandling/LoadInstrument.h"
 #include "MantidDataObjects/TableWorkspace.h"
 #include "MantidDataObjects/Workspace2D.h"
+#include "MantidKernel/MultiThreaded.h"
 
+#include <cmath>
 #include <fstream>
 
 using Mantid::Algorithms::FindPeaks;
@@ -110,6 +112,64 @@ public:
     AnalysisDataService::Instance().remove("FoundedSinglePeakTable");
   }
 
+  //----------------------------------------------------------------------------------------------
+  /** Test find peaks with given position on all spectra of a workspace.  Spectra may be fitted
+    * by different threads, but the output table must be in the order of workspace index
+    */
+  void test_findPeakGivenPeakPositionMultiSpectra()
+  {
+    MatrixWorkspace_sptr singlews = getSinglePeakData();
+    const size_t numspec = 8;
+    MatrixWorkspace_sptr dataws = WorkspaceFactory::Instance().create(singlews, numspec,
+                                                                      singlews->readX(0).size(),
+                                                                      singlews->readY(0).size());
+    for (size_t i = 0; i < numspec; ++i)
+    {
+      dataws->dataX(i) = singlews->readX(0);
+      dataws->dataY(i) = singlews->readY(0);
+      dataws->dataE(i) = singlews->readE(0);
+    }
+    std::string wsname("MultiSpectraPeakTestData");
+    AnalysisDataService::Instance().addOrReplace(wsname, dataws);
+
+    FindPeaks finder;
+    finder.initialize();
+    TS_ASSERT_THROWS_NOTHING( finder.setPropertyValue("InputWorkspace", wsname));
+    TS_ASSERT_THROWS_NOTHING( finder.setPropertyValue("PeakPositions", "1.2356"));
+    TS_ASSERT_THROWS_NOTHING( finder.setPropertyValue("FitWindows", "1.21, 1.50"));
+    TS_ASSERT_THROWS_NOTHING( finder.setProperty("PeakFunction", "Gaussian"));
+    TS_ASSERT_THROWS_NOTHING( finder.setProperty("BackgroundType", "Quadratic"));
+    TS_ASSERT_THROWS_NOTHING( finder.setProperty("RawPeakParameters", true));
+    TS_ASSERT_THROWS_NOTHING( finder.setProperty("StartFromObservedPeakCentre", false));
+    TS_ASSERT_THROWS_NOTHING( finder.setPropertyValue("PeaksList","FoundMultiSpectraPeakTable"));
+
+    TS_ASSERT_THROWS_NOTHING( finder.execute() );
+    TS_ASSERT( finder.isExecuted() );
+
+    TableWorkspace_sptr outtablews = boost::dynamic_pointer_cast<TableWorkspace>(
+          AnalysisDataService::Instance().retrieve("FoundMultiSpectraPeakTable"));
+    TS_ASSERT(outtablews);
+    TS_ASSERT_EQUALS(outtablews->rowCount(), numspec);
+    if (outtablews->rowCount() != numspec)
+      return;
+
+    map<string, double> firstmap;
+    getParameterMap(outtablews, 0, firstmap);
+    for (size_t i = 0; i < numspec; ++i)
+    {
+      TS_ASSERT_EQUALS(outtablews->Int(i, 0), static_cast<int>(i));
+
+      // Identical spectra give identical fits
+      map<string, double> parammap;
+      getParameterMap(outtablews, i, parammap);
+      TS_ASSERT_DELTA(parammap["PeakCentre"], firstmap["PeakCentre"], 1.0E-8);
+      TS_ASSERT_DELTA(parammap["Height"], firstmap["Height"], 1.0E-6);
+    }
+
+    AnalysisDataService::Instance().remove(wsname);
+    AnalysisDataService::Instance().remove("FoundMultiSpectraPeakTable");
+  }
+
   //----------------------------------------------------------------------------------------------
   /** Test find peaks automaticallyclear
     */
@@ -151,6 +211,54 @@ public:
 
   }
 
+  //----------------------------------------------------------------------------------------------
+  /** Find the peaks of all the spectra of a multi-peak data set with one thread and with all
+    * threads: every fit starts from the same guesses, so the results must be the same
+    */
+  void test_findMultiPeaksParallelMatchesSerial()
+  {
+    Mantid::DataHandling::LoadNexusProcessed loader;
+    loader.initialize();
+    loader.setProperty("Filename","focussed.nxs");
+    loader.setProperty("OutputWorkspace", "FindPeaksTest_peaksWS");
+    loader.execute();
+
+    const int maxThreads = PARALLEL_GET_MAX_THREADS;
+    PARALLEL_SET_NUM_THREADS(1);
+    runFindPeaksOnAllSpectra("FindPeaksTest_peaksWS", "FindPeaksTest_serialpeaks");
+    PARALLEL_SET_NUM_THREADS(maxThreads);
+    runFindPeaksOnAllSpectra("FindPeaksTest_peaksWS", "FindPeaksTest_parallelpeaks");
+
+    TableWorkspace_sptr serial = boost::dynamic_pointer_cast<TableWorkspace>(
+          AnalysisDataService::Instance().retrieve("FindPeaksTest_serialpeaks"));
+    TableWorkspace_sptr parallel = boost::dynamic_pointer_cast<TableWorkspace>(
+          AnalysisDataService::Instance().retrieve("FindPeaksTest_parallelpeaks"));
+    TS_ASSERT(serial);
+    TS_ASSERT(parallel);
+    if (!serial || !parallel)
+      return;
+
+    TS_ASSERT_LESS_THAN(1, serial->rowCount());
+    TS_ASSERT_EQUALS(parallel->rowCount(), serial->rowCount());
+    TS_ASSERT_EQUALS(parallel->columnCount(), serial->columnCount());
+    if (parallel->rowCount() != serial->rowCount() || parallel->columnCount() != serial->columnCount())
+      return;
+
+    for (size_t row = 0; row < serial->rowCount(); ++row)
+    {
+      TS_ASSERT_EQUALS(parallel->Int(row, 0), serial->Int(row, 0));
+      for (size_t col = 1; col < serial->columnCount(); ++col)
+      {
+        const double expected = serial->cell<double>(row, col);
+        TS_ASSERT_DELTA(parallel->cell<double>(row, col), expected, 1.0E-10 * (1.0 + fabs(expected)));
+      }
+    }
+
+    AnalysisDataService::Instance().remove("FindPeaksTest_peaksWS");
+    AnalysisDataService::Instance().remove("FindPeaksTest_serialpeaks");
+    AnalysisDataService::Instance().remove("FindPeaksTest_parallelpeaks");
+  }
+
   void NtestFindMultiPeaksGivenPeaksList()
   {
     this->LoadPG3_733();
@@ -167,6 +275,22 @@ public:
 
   }
 
+  //----------------------------------------------------------------------------------------------
+  /** Find the peaks of all the spectra of a workspace automatically
+    */
+  void runFindPeaksOnAllSpectra(const std::string &inputname, const std::string &outputname)
+  {
+    FindPeaks finder;
+    finder.initialize();
+    TS_ASSERT_THROWS_NOTHING( finder.setPropertyValue("InputWorkspace", inputname) );
+    TS_ASSERT_THROWS_NOTHING( finder.setProperty("PeakFunction", "Gaussian") );
+    TS_ASSERT_THROWS_NOTHING( finder.setProperty("BackgroundType", "Quadratic") );
+    TS_ASSERT_THROWS_NOTHING( finder.setProperty("RawPeakParameters", true) );
+    TS_ASSERT_THROWS_NOTHING( finder.setPropertyValue("PeaksList", outputname) );
+    TS_ASSERT_THROWS_NOTHING( finder.execute() );
+    TS_ASSERT( finder.isExecuted() );
+  }
+
   //----------------------------------------------------------------------------------------------
   /** Parse a row in output parameter tableworkspace to a string/double parameter name/value map
     */
@@ -3,6 +3,8 @@
 #include "MantidKernel/EnabledWhenProperty.h"
 #include "MantidDataObjects/PeaksWorkspace.h"
 #include "MantidDataObjects/Peak.h"
+#include "MantidDataObjects/PeakQIndex.h"
+#include "MantidKernel/MultiThreaded.h"
 
 namespace Mantid
 {
@@ -17,6 +19,7 @@ namespace Crystal
   using DataObjects::PeaksWorkspace_const_sptr;
   using DataObjects::PeaksWorkspace_sptr;
   using DataObjects::Peak;
+  using DataObjects::PeakQIndex;
 
   /** Constructor
    */
@@ -100,25 +103,25 @@ namespace Crystal
 
       // Get hold of the peaks in the first workspace as we'll need to examine them
       auto & lhsPeaks = LHSWorkspace->getPeaks();
+      // Index them by Q so that each peak in the second workspace only looks at its neighbours
+      const PeakQIndex lhsIndex(lhsPeaks, PeakQIndex::QSample);
+      const V3D tolerance(Tolerance, Tolerance, Tolerance);
+
+      // A peak matches if every component of Q is within the tolerance of a peak in the first workspace
+      const int64_t numRHSPeaks = static_cast<int64_t>(rhsPeaks.size());
+      std::vector<char> matched(rhsPeaks.size(), 0);
+      PARALLEL_FOR_NO_WSP_CHECK()
+      for ( int64_t i = 0; i < numRHSPeaks; ++i )
+      {
+        const V3D q = rhsPeaks[static_cast<size_t>(i)].getQSampleFrame();
+        if ( lhsIndex.hasPeakInBox(q - tolerance, q + tolerance) ) matched[static_cast<size_t>(i)] = 1;
+      }
 
-      // Loop over the peaks in the second workspace, appending ones that don't match any in first workspace
+      // Append the peaks that don't match any in first workspace, keeping their order
       for ( size_t i = 0; i < rhsPeaks.size(); ++i )
       {
-        const Peak& currentPeak = rhsPeaks[i];
-        // Now have to go through the first workspace checking for matches
-        // Not doing anything clever as peaks workspace are typically not large - just a linear search
-        bool match = false;
-        for ( size_t j = 0; j < lhsPeaks.size(); ++j )
-        {
-          const V3D deltaQ = currentPeak.getQSampleFrame() - lhsPeaks[j].getQSampleFrame();
-          if ( deltaQ.nullVector(Tolerance) )  // Using a V3D method that does the job
-          {
-            match = true;
-            break;
-          }
-        }
         // Only add the peak if there was no match
-        if ( ! match ) output->addPeak(currentPeak);
+        if ( ! matched[i] ) output->addPeak(rhsPeaks[i]);
         progress.report();
       }
     }
@@ -61,6 +61,7 @@ namespace Mantid
       virtual void setHeight(const double h) ;
       virtual double fwhm()const;
       virtual void setFwhm(const double w);
+      virtual std::pair<double,double> getDomainInterval() const;
 
       /// overwrite IFunction base class methods
       std::string name()const{return "BackToBackExponential";}
@@ -89,9 +89,33 @@ namespace Mantid
         API::MatrixWorkspace_sptr ws; ///< shared pointer to the workspace
         std::vector<int> indx;  ///< a list of ws indices to fit if i and spec < 0
       };
+
+      /** Structure holding a spectrum to fit and the result of its fit
+        */
+      struct FitData
+      {
+        /// Constructor
+        FitData(size_t in,API::MatrixWorkspace_sptr w,int ix,double lv,const std::string& bn)
+          :input(in),
+          ws(w),
+          i(ix),
+          logValue(lv),
+          baseName(bn),
+          chi2(0)
+        {}
+        size_t input;     ///< Index of the data source in the list of input data
+        API::MatrixWorkspace_sptr ws; ///< shared pointer to the workspace
+        int i;            ///< Workspace index of the spectrum to fit
+        double logValue;  ///< Value to plot the fitted parameters against
+        std::string baseName; ///< Base name of the Fit output workspaces
+        std::vector<double> parameters; ///< Fitted parameter values
+        std::vector<double> errors;     ///< Errors of the fitted parameters
+        double chi2;      ///< Fit's chi squared over degrees of freedom
+      };
     public:
       /// Default constructor
-      PlotPeakByLogValue() : API::Algorithm() {};
+      PlotPeakByLogValue() : API::Algorithm(), m_createFitOutput(false),
+        m_outputCompositeMembers(false), m_outputConvolvedMembers(false) {};
       /// Destructor
       virtual ~PlotPeakByLogValue() {};
       /// Algorithm's name for identification overriding a virtual method
@@ -118,6 +142,27 @@ namespace Mantid
 
       /// Create a list of input workspace names
       std::vector<InputData> makeNames()const;
+
+      /// Fit all spectra independently of each other
+      void fitIndividual(API::IFunction_const_sptr ifun, std::vector<FitData>& fits, bool passWSIndexToFunction);
+
+      /// Fit the spectra one after another, starting each fit from the result of the previous one
+      void fitSequential(API::IFunction_sptr ifun, std::vector<FitData>& fits, bool passWSIndexToFunction);
+
+      /// Create a Fit algorithm for a spectrum
+      API::IAlgorithm_sptr createFitAlgorithm(API::IFunction_sptr fun, const FitData& data) const;
+
+      /// Run a Fit algorithm and store its result
+      void runFit(API::IAlgorithm_sptr fit, API::IFunction_const_sptr fun, FitData& data) const;
+
+      /// Fit properties passed on to every Fit
+      std::string m_startX;
+      std::string m_endX;
+      std::string m_minimizer;
+      std::string m_costFunction;
+      bool m_createFitOutput;
+      bool m_outputCompositeMembers;
+      bool m_outputConvolvedMembers;
     };
 
   } // namespace CurveFitting
@@ -128,6 +128,20 @@ namespace CurveFitting
       }
     }
   
+   /**
+    * The peak is calculated within ~100 of its widths from X0, see function1D().
+    * @return The interval outside which the function is zero
+    */
+   std::pair<double,double> BackToBackExponential::getDomainInterval() const
+   {
+     const double x0 = getParameter(3);
+     const double s = getParameter(4);
+     double extent = expWidth();
+     if ( s > extent ) extent = s;
+     extent *= 100;
+     return std::make_pair(x0 - extent, x0 + extent);
+   }
+
    /**
     * Evaluate function derivatives numerically.
     */
@@ -5,6 +5,7 @@
 #include "MantidCurveFitting/DeltaFunction.h"
 #include "MantidAPI/IFunction1D.h"
 #include "MantidAPI/FunctionFactory.h"
+#include "MantidKernel/FFTPlanCache.h"
 
 #include <cmath>
 #include <algorithm>
@@ -97,7 +98,7 @@ void Convolution::function(const FunctionDomain& domain, FunctionValues& values)
   refreshResolution();
 
   gsl_fft_real_workspace * workspace = gsl_fft_real_workspace_alloc(nData);
-  gsl_fft_real_wavetable * wavetable = gsl_fft_real_wavetable_alloc(nData);
+  auto wavetable = Kernel::FFTPlanCache::Instance().realWavetable(nData);
 
   int n2 = static_cast<int>(nData) / 2;
   bool odd = n2*2 != static_cast<int>(nData);
@@ -147,7 +148,7 @@ void Convolution::function(const FunctionDomain& domain, FunctionValues& values)
         m_resolution[n2+i] = tmp;
       }
     }
-    gsl_fft_real_transform (m_resolution.data(), 1, nData, wavetable, workspace);
+    gsl_fft_real_transform (m_resolution.data(), 1, nData, wavetable.get(), workspace);
     std::transform(m_resolution.begin(),m_resolution.end(),m_resolution.begin(),std::bind2nd(std::multiplies<double>(),dx));
     delete[] xr;
   }
@@ -157,7 +158,6 @@ void Convolution::function(const FunctionDomain& domain, FunctionValues& values)
   {
     double dx = 1.;//nData > 1? xValues[1] - xValues[0]: 1.;
     std::transform(m_resolution.begin(),m_resolution.end(),out,std::bind2nd(std::multiplies<double>(),dx));
-    gsl_fft_real_wavetable_free (wavetable);
     gsl_fft_real_workspace_free (workspace);
     return;
   }
@@ -184,7 +184,6 @@ void Convolution::function(const FunctionDomain& domain, FunctionValues& values)
     {// all delta functions - return scaled reslution
       resolution->function1D(out,xValues,nData);
       std::transform(out,out+nData,out,std::bind2nd(std::multiplies<double>(),dltF));
-      gsl_fft_real_wavetable_free (wavetable);
       gsl_fft_real_workspace_free (workspace);
       return;
     }
@@ -194,14 +193,12 @@ void Convolution::function(const FunctionDomain& domain, FunctionValues& values)
     auto df = boost::dynamic_pointer_cast<DeltaFunction>(getFunction(1));
     resolution->function1D(out,xValues,nData);
     std::transform(out,out+nData,out,std::bind2nd(std::multiplies<double>(),df->getParameter("Height")*df->HeightPrefactor()));
-    gsl_fft_real_wavetable_free (wavetable);
     gsl_fft_real_workspace_free (workspace);
     return;
   }
 
   getFunction(1)->function(domain,values);
-  gsl_fft_real_transform (out, 1, nData, wavetable, workspace);
-  gsl_fft_real_wavetable_free (wavetable);
+  gsl_fft_real_transform (out, 1, nData, wavetable.get(), workspace);
 
   double dx = nData > 1? xValues[1] - xValues[0]: 1.;
   std::transform(out,out+nData,out,std::bind2nd(std::multiplies<double>(),dx));
@@ -219,9 +216,8 @@ void Convolution::function(const FunctionDomain& domain, FunctionValues& values)
     fun.set(i,res_r*fun_r - res_i*fun_i,res_r*fun_i + res_i*fun_r);
   }
 
-  gsl_fft_halfcomplex_wavetable * wavetable_r = gsl_fft_halfcomplex_wavetable_alloc(nData);
-  gsl_fft_halfcomplex_inverse(out, 1, nData, wavetable_r, workspace);
-  gsl_fft_halfcomplex_wavetable_free (wavetable_r);
+  auto wavetable_r = Kernel::FFTPlanCache::Instance().halfComplexWavetable(nData);
+  gsl_fft_halfcomplex_inverse(out, 1, nData, wavetable_r.get(), workspace);
 
   gsl_fft_real_workspace_free (workspace);
 
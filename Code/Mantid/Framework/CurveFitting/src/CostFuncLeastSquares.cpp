@@ -10,6 +10,7 @@
 #include "MantidKernel/Logger.h"
 #include "MantidKernel/MultiThreaded.h"
 
+#include <algorithm>
 #include <iomanip>
 
 namespace Mantid
@@ -280,8 +281,6 @@ void CostFuncLeastSquares::addValDerivHessian(
   }
   function->functionDeriv(*domain,jacobian);
 
-  size_t iActiveP = 0;
-  double fVal = 0.0;
   if (g_log.is(Kernel::Logger::Priority::PRIO_DEBUG))
   {
     g_log.debug() << "Jacobian:\n";
@@ -298,69 +297,88 @@ void CostFuncLeastSquares::addValDerivHessian(
 
   std::vector<double> weights = getFitWeights(values);
 
+  std::vector<size_t> activeParams;
+  activeParams.reserve(np);
   for(size_t ip = 0; ip < np; ++ip)
   {
-    if ( !function->isActive(ip) ) continue;
-    double d = 0.0;
-    for(size_t i = 0; i < ny; ++i)
-    {
-      double calc = values->getCalculated(i);
-      double obs = values->getFitData(i);
-      double w =  weights[i];
-      double y = ( calc - obs ) * w;
-      d += y * jacobian.get(i,ip) * w;
-      if (iActiveP == 0 && evalFunction)
-      {
-        fVal += y * y;
-      }
-    }
-    PARALLEL_CRITICAL(der_set)
-    {
-      double der = m_der.get(iActiveP);
-      m_der.set(iActiveP, der + d);
-    }
-    //std::cerr << "der " << ip << ' ' << der[iActiveP] << std::endl;
-    ++iActiveP;
+    if ( function->isActive(ip) ) activeParams.push_back(ip);
   }
+  const size_t na = activeParams.size(); // number of active parameters
 
-  if (evalFunction)
+  // The value, the derivatives and the Hessian are summed into local buffers and added
+  // to the totals once at the end: calls made by different threads on different domains
+  // (ParDomain) then do not serialise on every element.
+  double fVal = 0.0;
+  std::vector<double> der(na, 0.0);
+  evalHessian = evalHessian && na > 0 && ny > 0;
+  GSLMatrix hessian;
+  if (evalHessian)
   {
-    PARALLEL_ATOMIC
-    m_value += 0.5 * fVal;
+    hessian.resize(na,na);
+    hessian.zero();
   }
 
-  if (!evalHessian) return;
-
-  //size_t na = m_der.size(); // number of active parameters
+  // The Hessian is approximated by J^T * J where J is the weighted Jacobian of the active
+  // parameters. It is computed by matrix multiplication over blocks of data points.
+  const size_t blockSize = std::min(ny, static_cast<size_t>(1024));
+  GSLMatrix wJacobian;
+  if (evalHessian)
+  {
+    wJacobian.resize(blockSize,na);
+  }
 
-  size_t i1 = 0; // active parameter index
-  for(size_t i = 0; i < np; ++i) // over parameters
+  for(size_t i0 = 0; i0 < ny; i0 += blockSize)
   {
-    if ( !function->isActive(i) ) continue;
-    size_t i2 = 0; // active parameter index
-    for(size_t j = 0; j <= i; ++j) // over ~ half of parameters
+    const size_t i1 = std::min(ny, i0 + blockSize);
+    for(size_t i = i0; i < i1; ++i)
     {
-      if ( !function->isActive(j) ) continue;
-      double d = 0.0;
-      for(size_t k = 0; k < ny; ++k) // over fitting data
+      double calc = values->getCalculated(i);
+      double obs = values->getFitData(i);
+      double w =  weights[i];
+      double y = ( calc - obs ) * w;
+      fVal += y * y;
+      for(size_t ia = 0; ia < na; ++ia)
       {
-        // double w = values->getFitWeight(k);
-        double w = weights[k];
-        d += jacobian.get(k,i) * jacobian.get(k,j) * w * w;
+        const double wj = jacobian.get(i,activeParams[ia]) * w;
+        der[ia] += y * wj;
+        if (evalHessian)
+        {
+          wJacobian.set(i - i0, ia, wj);
+        }
       }
-      PARALLEL_CRITICAL(hessian_set)
+    }
+    if (evalHessian)
+    {
+      if (i1 - i0 < blockSize)
       {
-        double h = m_hessian.get(i1,i2);
-        m_hessian.set(i1,i2, h + d);
-        //std::cerr << "hess " << i1 << ' ' << i2 << std::endl;
-        if (i1 != i2)
+        // zero the unused rows of the last block
+        for(size_t i = i1 - i0; i < blockSize; ++i)
         {
-          m_hessian.set(i2,i1,h + d);
+          for(size_t ia = 0; ia < na; ++ia)
+          {
+            wJacobian.set(i, ia, 0.0);
+          }
         }
       }
-      ++i2;
+      // hessian += wJacobian^T * wJacobian
+      gsl_blas_dgemm(CblasTrans, CblasNoTrans, 1.0, wJacobian.gsl(), wJacobian.gsl(), 1.0, hessian.gsl());
+    }
+  }
+
+  PARALLEL_CRITICAL(der_set)
+  {
+    if (evalFunction)
+    {
+      m_value += 0.5 * fVal;
+    }
+    for(size_t ia = 0; ia < na; ++ia)
+    {
+      m_der.set(ia, m_der.get(ia) + der[ia]);
+    }
+    if (evalHessian)
+    {
+      m_hessian += hessian;
     }
-    ++i1;
   }
 }
 
@@ -26,6 +26,7 @@
 #include "MantidAPI/ITableWorkspace.h"
 #include "MantidKernel/ListValidator.h"
 #include "MantidKernel/MandatoryValidator.h"
+#include "MantidKernel/MultiThreaded.h"
 
 namespace Mantid
 {
@@ -110,9 +111,13 @@ namespace Mantid
       std::string logName = getProperty("LogValue");
       bool individual = getPropertyValue("FitType") == "Individual";
       bool passWSIndexToFunction = getProperty("PassWSIndexToFunction");
-      bool createFitOutput = getProperty("CreateOutput");
-      bool outputCompositeMembers = getProperty("OutputCompositeMembers");
-      bool outputConvolvedMembers = getProperty("ConvolveMembers");
+      m_createFitOutput = getProperty("CreateOutput");
+      m_outputCompositeMembers = getProperty("OutputCompositeMembers");
+      m_outputConvolvedMembers = getProperty("ConvolveMembers");
+      m_startX = getPropertyValue("StartX");
+      m_endX = getPropertyValue("EndX");
+      m_minimizer = getPropertyValue("Minimizer");
+      m_costFunction = getPropertyValue("CostFunction");
       std::string baseName = getPropertyValue("OutputWorkspace");
 
       bool isDataName = false; // if true first output column is of type string and is the data source name
@@ -137,16 +142,6 @@ namespace Mantid
         throw std::invalid_argument("Fitting function failed to initialize");
       }
 
-      // for inidividual fittings store the initial parameters
-      std::vector<double> initialParams(ifun->nParams());
-      if ( individual )
-      {
-          for(size_t i = 0; i < initialParams.size(); ++i)
-          {
-              initialParams[i] = ifun->getParameter(i);
-          }
-      }
-
       for(size_t iPar=0;iPar<ifun->nParams();++iPar)
       {
         result->addColumn("double",ifun->parameterName(iPar));
@@ -156,12 +151,8 @@ namespace Mantid
 
       setProperty("OutputWorkspace",result);
 
-      std::vector<std::string> covariance_workspaces;
-      std::vector<std::string> fit_workspaces;
-      std::vector<std::string> parameter_workspaces;
-
-      double dProg = 1./static_cast<double>(wsNames.size());
-      double Prog = 0.;
+      // Collect the spectra to fit in the order their results appear in the output table
+      std::vector<FitData> fits;
       for(int i=0;i<static_cast<int>(wsNames.size());++i)
       {
         InputData data = getWorkspace(wsNames[i]);
@@ -190,14 +181,6 @@ namespace Mantid
           jend = data.indx.back() + 1;
         }
 
-        if (createFitOutput)
-        {        
-          covariance_workspaces.reserve(covariance_workspaces.size()+jend);
-          fit_workspaces.reserve(fit_workspaces.size()+jend);
-          parameter_workspaces.reserve(parameter_workspaces.size()+jend);
-        }
-        
-        dProg /= abs(jend - j);
         for(;j < jend;++j)
         {
 
@@ -220,98 +203,61 @@ namespace Mantid
             logValue = logp->lastValue();
           }
 
-          double chi2;
-
-          try
-          {
-            if ( passWSIndexToFunction )
-            {
-                setWorkspaceIndexAttribute( ifun, j );
-            }
-
-            g_log.debug() << "Fitting " << data.ws->name() << " index " << j << " with " << std::endl;
-            g_log.debug() << ifun->asString() << std::endl;
-
-            std::string spectrum_index = boost::lexical_cast<std::string>(j);
-            std::string wsBaseName = "";
-            
-            if(createFitOutput) 
-              wsBaseName = wsNames[i].name + "_" + spectrum_index;
-            
-            // Fit the function
-            API::IAlgorithm_sptr fit = AlgorithmManager::Instance().createUnmanaged("Fit");
-            fit->initialize();
-            fit->setProperty("Function",ifun);
-            fit->setProperty("InputWorkspace",data.ws);
-            fit->setProperty("WorkspaceIndex",j);
-            fit->setPropertyValue("StartX",getPropertyValue("StartX"));
-            fit->setPropertyValue("EndX",getPropertyValue("EndX"));
-            fit->setPropertyValue("Minimizer",getPropertyValue("Minimizer"));
-            fit->setPropertyValue("CostFunction",getPropertyValue("CostFunction"));
-            fit->setProperty("CalcErrors",true);
-            fit->setProperty("CreateOutput",createFitOutput);
-            fit->setProperty("OutputCompositeMembers", outputCompositeMembers);
-            fit->setProperty("ConvolveMembers",outputConvolvedMembers);
-            fit->setProperty("Output", wsBaseName);
-            fit->execute();
-
-            if (!fit->isExecuted())
-            {
-                throw std::runtime_error("Fit child algorithm failed: "+data.ws->name());
-            }
-
-            ifun = fit->getProperty("Function");
-            chi2 = fit->getProperty("OutputChi2overDoF");
-
-            if (createFitOutput)
-            {
-              covariance_workspaces.push_back(wsBaseName + "_NormalisedCovarianceMatrix");
-              parameter_workspaces.push_back(wsBaseName + "_Parameters");
-              fit_workspaces.push_back(wsBaseName + "_Workspace");
-            }
-
-            g_log.debug() << "Fit result " << fit->getPropertyValue("OutputStatus") << ' ' << chi2 << std::endl;
+          std::string wsBaseName = "";
+          if(m_createFitOutput) 
+            wsBaseName = wsNames[i].name + "_" + boost::lexical_cast<std::string>(j);
 
-          }
-          catch(...)
-          {
-            g_log.error("Error in Fit ChildAlgorithm");
-            throw;
-          }
+          fits.push_back(FitData(static_cast<size_t>(i),data.ws,j,logValue,wsBaseName));
+        } // for(;j < jend;++j)
+      }
 
-          // Extract the fitted parameters and put them into the result table
-          TableRow row = result->appendRow();
-          if (isDataName)
-          {
-            row << wsNames[i].name;
-          }
-          else
-          {
-            row << logValue;
-          }
+      if (individual)
+      {
+        fitIndividual(ifun, fits, passWSIndexToFunction);
+      }
+      else
+      {
+        fitSequential(ifun, fits, passWSIndexToFunction);
+      }
 
-          for(size_t iPar=0;iPar<ifun->nParams();++iPar)
-          {
-            row << ifun->getParameter(iPar) << ifun->getError(iPar);
-          }
-          row << chi2;
+      // Put the fitted parameters into the result table
+      std::vector<std::string> covariance_workspaces;
+      std::vector<std::string> fit_workspaces;
+      std::vector<std::string> parameter_workspaces;
+      if (m_createFitOutput)
+      {
+        covariance_workspaces.reserve(fits.size());
+        fit_workspaces.reserve(fits.size());
+        parameter_workspaces.reserve(fits.size());
+      }
 
-          Prog += dProg;
-          progress(Prog);
-          interruption_point();
+      for(auto fit = fits.begin(); fit != fits.end(); ++fit)
+      {
+        TableRow row = result->appendRow();
+        if (isDataName)
+        {
+          row << wsNames[fit->input].name;
+        }
+        else
+        {
+          row << fit->logValue;
+        }
 
-          if (individual)
-          {
-            for(size_t i = 0; i < initialParams.size(); ++i)
-            {
-                ifun->setParameter(i,initialParams[i]);
-            }
-          }
+        for(size_t iPar=0;iPar<fit->parameters.size();++iPar)
+        {
+          row << fit->parameters[iPar] << fit->errors[iPar];
+        }
+        row << fit->chi2;
 
-        } // for(;j < jend;++j)
+        if (m_createFitOutput)
+        {
+          covariance_workspaces.push_back(fit->baseName + "_NormalisedCovarianceMatrix");
+          parameter_workspaces.push_back(fit->baseName + "_Parameters");
+          fit_workspaces.push_back(fit->baseName + "_Workspace");
+        }
       }
 
-      if(createFitOutput)
+      if(m_createFitOutput)
       {
         //collect output of fit for each spectrum into workspace groups
         API::IAlgorithm_sptr groupAlg = AlgorithmManager::Instance().createUnmanaged("GroupWorkspaces");
@@ -334,6 +280,157 @@ namespace Mantid
       }
     }
 
+    /**
+      * Fit every spectrum starting from the initial values given in the Function property.
+      * The fits are independent and run in parallel: each thread fits its own copy of the
+      * function while the input workspaces are shared read-only.
+      * @param ifun :: The initial fitting function
+      * @param fits :: The spectra to fit. On return they hold the fit results.
+      * @param passWSIndexToFunction :: Set the WorkspaceIndex attributes of the function
+      */
+    void PlotPeakByLogValue::fitIndividual(IFunction_const_sptr ifun, std::vector<FitData>& fits, bool passWSIndexToFunction)
+    {
+      std::vector<double> initialParams(ifun->nParams());
+      for(size_t i = 0; i < initialParams.size(); ++i)
+      {
+        initialParams[i] = ifun->getParameter(i);
+      }
+
+      std::vector<IFunction_sptr> threadFunctions(PARALLEL_GET_MAX_THREADS);
+      for(size_t i = 0; i < threadFunctions.size(); ++i)
+      {
+        threadFunctions[i] = ifun->clone();
+      }
+
+      // interruption_point() cannot throw inside the parallel loop. A cancel request makes the
+      // interrupt region skip the fits that have not started, and the check after the loop throws.
+      interruption_point();
+      const int nfits = static_cast<int>(fits.size());
+      Progress prog(this, 0.0, 1.0, nfits);
+      PRAGMA_OMP(parallel for schedule(dynamic, 1) )
+      for(int k = 0; k < nfits; ++k)
+      {
+        PARALLEL_START_INTERUPT_REGION
+
+        FitData& data = fits[k];
+        IFunction_sptr fun = threadFunctions[PARALLEL_THREAD_NUMBER];
+        for(size_t i = 0; i < initialParams.size(); ++i)
+        {
+          fun->setParameter(i,initialParams[i]);
+        }
+        if ( passWSIndexToFunction )
+        {
+          setWorkspaceIndexAttribute( fun, data.i );
+        }
+
+        runFit(createFitAlgorithm(fun, data), fun, data);
+        prog.report();
+
+        PARALLEL_END_INTERUPT_REGION
+      }
+      PARALLEL_CHECK_INTERUPT_REGION
+    }
+
+    /**
+      * Fit the spectra in order. Every next fit starts with the parameters returned by the previous fit.
+      * A Fit algorithm is reused for all the spectra of a workspace unless it has to create
+      * output workspaces, which cannot be declared twice.
+      * @param ifun :: The fitting function, updated by every fit
+      * @param fits :: The spectra to fit. On return they hold the fit results.
+      * @param passWSIndexToFunction :: Set the WorkspaceIndex attributes of the function
+      */
+    void PlotPeakByLogValue::fitSequential(IFunction_sptr ifun, std::vector<FitData>& fits, bool passWSIndexToFunction)
+    {
+      Progress prog(this, 0.0, 1.0, fits.size());
+      API::IAlgorithm_sptr fit;
+      for(size_t k = 0; k < fits.size(); ++k)
+      {
+        FitData& data = fits[k];
+        if ( passWSIndexToFunction )
+        {
+          setWorkspaceIndexAttribute( ifun, data.i );
+        }
+
+        if (!fit || m_createFitOutput || data.ws != fits[k-1].ws)
+        {
+          fit = createFitAlgorithm(ifun, data);
+        }
+        else
+        {
+          // Fit works on ifun itself which already holds the result of the previous fit
+          fit->setProperty("WorkspaceIndex",data.i);
+        }
+
+        runFit(fit, ifun, data);
+        prog.report();
+        interruption_point();
+      }
+    }
+
+    /**
+      * Create and set up a Fit algorithm for a spectrum.
+      * @param fun :: The function to fit. Fit modifies it in place.
+      * @param data :: The spectrum to fit
+      * @return The Fit algorithm, ready to be executed
+      */
+    API::IAlgorithm_sptr PlotPeakByLogValue::createFitAlgorithm(IFunction_sptr fun, const FitData& data) const
+    {
+      API::IAlgorithm_sptr fit = AlgorithmManager::Instance().createUnmanaged("Fit");
+      fit->initialize();
+      fit->setProperty("Function",fun);
+      fit->setProperty("InputWorkspace",data.ws);
+      fit->setProperty("WorkspaceIndex",data.i);
+      fit->setPropertyValue("StartX",m_startX);
+      fit->setPropertyValue("EndX",m_endX);
+      fit->setPropertyValue("Minimizer",m_minimizer);
+      fit->setPropertyValue("CostFunction",m_costFunction);
+      fit->setProperty("CalcErrors",true);
+      fit->setProperty("CreateOutput",m_createFitOutput);
+      fit->setProperty("OutputCompositeMembers", m_outputCompositeMembers);
+      fit->setProperty("ConvolveMembers",m_outputConvolvedMembers);
+      fit->setProperty("Output", data.baseName);
+      return fit;
+    }
+
+    /**
+      * Execute a Fit algorithm and copy the fitted parameters to a FitData.
+      * @param fit :: The Fit algorithm created by createFitAlgorithm
+      * @param fun :: The function being fitted
+      * @param data :: The spectrum being fitted, receives the result
+      */
+    void PlotPeakByLogValue::runFit(API::IAlgorithm_sptr fit, IFunction_const_sptr fun, FitData& data) const
+    {
+      try
+      {
+        g_log.debug() << "Fitting " << data.ws->name() << " index " << data.i << " with " << std::endl;
+        g_log.debug() << fun->asString() << std::endl;
+
+        fit->execute();
+
+        if (!fit->isExecuted())
+        {
+            throw std::runtime_error("Fit child algorithm failed: "+data.ws->name());
+        }
+
+        data.chi2 = fit->getProperty("OutputChi2overDoF");
+
+        g_log.debug() << "Fit result " << fit->getPropertyValue("OutputStatus") << ' ' << data.chi2 << std::endl;
+      }
+      catch(...)
+      {
+        g_log.error("Error in Fit ChildAlgorithm");
+        throw;
+      }
+
+      data.parameters.resize(fun->nParams());
+      data.errors.resize(fun->nParams());
+      for(size_t iPar=0;iPar<fun->nParams();++iPar)
+      {
+        data.parameters[iPar] = fun->getParameter(iPar);
+        data.errors[iPar] = fun->getError(iPar);
+      }
+    }
+
     /** Get a workspace identified by an InputData structure. 
       * @param data :: InputData with name and either spec or i fields defined. 
       * @return InputData structure with the ws field set if everything was OK.
@@ -199,6 +199,52 @@ public:
     TS_ASSERT_DELTA(L, -0.145, 1e-10); // L + costFun->val() == 0
   }
 
+  void test_hessian_is_weighted_JTJ()
+  {
+    // a*x + b with 3000 points to span several blocks of the Jacobian
+    const size_t n = 3000;
+    std::vector<double> x(n),y(n),w(n);
+    double sx = 0, sxx = 0, sw = 0;
+    for(size_t i = 0; i < n; ++i)
+    {
+      x[i] = 0.001 * double(i);
+      y[i] = 2.0 * x[i] + 1.0;
+      w[i] = 1.0 + 0.5 * double(i % 3);
+      sw += w[i] * w[i];
+      sx += w[i] * w[i] * x[i];
+      sxx += w[i] * w[i] * x[i] * x[i];
+    }
+    API::FunctionDomain1D_sptr domain(new API::FunctionDomain1DVector(x));
+    API::FunctionValues_sptr values(new API::FunctionValues(*domain));
+    values->setFitData(y);
+    values->setFitWeights(w);
+
+    boost::shared_ptr<UserFunction> fun(new UserFunction);
+    fun->setAttributeValue("Formula","a*x+b");
+    fun->setParameter("a",1.1);
+    fun->setParameter("b",2.2);
+
+    boost::shared_ptr<CostFuncLeastSquares> costFun(new CostFuncLeastSquares);
+    costFun->setFittingFunction(fun,domain,values);
+    costFun->valDerivHessian();
+
+    const GSLMatrix& H = costFun->getHessian();
+    TS_ASSERT_EQUALS(H.size1(), 2);
+    TS_ASSERT_EQUALS(H.size2(), 2);
+    TS_ASSERT_DELTA(H.get(0,0), sxx, 1e-8 * sxx);
+    TS_ASSERT_DELTA(H.get(0,1), sx, 1e-8 * sx);
+    TS_ASSERT_DELTA(H.get(1,0), sx, 1e-8 * sx);
+    TS_ASSERT_DELTA(H.get(1,1), sw, 1e-8 * sw);
+
+    // Fixed parameters are left out
+    fun->fix(0);
+    costFun->setFittingFunction(fun,domain,values);
+    costFun->valDerivHessian();
+    const GSLMatrix& H1 = costFun->getHessian();
+    TS_ASSERT_EQUALS(H1.size1(), 1);
+    TS_ASSERT_DELTA(H1.get(0,0), sw, 1e-8 * sw);
+  }
+
   void test_Fixing_parameter()
   {
     std::vector<double> x(10),y(10);
@@ -337,4 +383,56 @@ public:
 
 };
 
+class LeastSquaresTestPerformance : public CxxTest::TestSuite
+{
+public:
+  static LeastSquaresTestPerformance *createSuite() { return new LeastSquaresTestPerformance(); }
+  static void destroySuite( LeastSquaresTestPerformance *suite ) { delete suite; }
+
+  LeastSquaresTestPerformance()
+  {
+    // 10^6 points with 20 peaks on a linear background
+    const size_t n = 1000000;
+    const size_t nPeaks = 20;
+    m_domain.reset(new API::FunctionDomain1DVector(0.0, 100.0, n));
+    m_values.reset(new API::FunctionValues(*m_domain));
+
+    m_function.reset( new API::CompositeFunction() );
+    boost::shared_ptr<LinearBackground> bk( new LinearBackground() );
+    bk->initialize();
+    bk->setParameter("A0",1.0);
+    bk->setParameter("A1",0.01);
+    m_function->addFunction(bk);
+    for(size_t i = 0; i < nPeaks; ++i)
+    {
+      boost::shared_ptr<Gaussian> peak( new Gaussian() );
+      peak->initialize();
+      peak->setParameter("PeakCentre",2.5 + 5.0 * double(i));
+      peak->setParameter("Height",10.0 + double(i));
+      peak->setParameter("Sigma",0.3);
+      m_function->addFunction(peak);
+    }
+    m_function->function(*m_domain,*m_values);
+    m_values->setFitDataFromCalculated(*m_values);
+    m_values->setFitWeights(1.0);
+  }
+
+  void test_valDerivHessian_multi_peak()
+  {
+    boost::shared_ptr<CostFuncLeastSquares> costFun(new CostFuncLeastSquares);
+    costFun->setFittingFunction(m_function,m_domain,m_values);
+    for(size_t i = 0; i < 5; ++i)
+    {
+      costFun->setParameter(0, 1.0 + 0.01 * double(i));
+      costFun->valDerivHessian();
+    }
+    TS_ASSERT_EQUALS(costFun->getHessian().size1(), m_function->nParams());
+  }
+
+private:
+  API::FunctionDomain1D_sptr m_domain;
+  API::FunctionValues_sptr m_values;
+  API::CompositeFunction_sptr m_function;
+};
+
 #endif /*CURVEFITTING_LEASTSQUARESTEST_H_*/
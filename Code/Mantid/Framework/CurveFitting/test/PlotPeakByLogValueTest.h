@@ -151,6 +151,41 @@ public:
 
   }
 
+  void testWorkspaceGroup_Individual()
+  {
+    createData();
+
+    PlotPeakByLogValue alg;
+    alg.initialize();
+    alg.setPropertyValue("Input","PlotPeakGroup");
+    alg.setPropertyValue("OutputWorkspace","PlotPeakResult");
+    alg.setPropertyValue("WorkspaceIndex","1");
+    alg.setPropertyValue("LogValue","var");
+    alg.setPropertyValue("FitType","Individual");
+    alg.setPropertyValue("Function","name=LinearBackground,A0=1,A1=0.3;name=Gaussian,PeakCentre=5,Height=2,Sigma=0.1");
+    alg.execute();
+    TS_ASSERT(alg.isExecuted());
+
+    TWS_type result = WorkspaceCreationHelper::getWS<TableWorkspace>("PlotPeakResult");
+    TS_ASSERT_EQUALS(result->columnCount(),12);
+    TS_ASSERT_EQUALS(result->rowCount(),3);
+
+    // Rows are in input order whichever thread fitted them
+    for(size_t iWS = 0; iWS < 3; ++iWS)
+    {
+      const double d = static_cast<double>(iWS);
+      TS_ASSERT_DELTA(result->Double(iWS,0),1 + 0.3*d,1e-10);
+      TS_ASSERT_DELTA(result->Double(iWS,1),1 + 0.1*d,1e-10);
+      TS_ASSERT_DELTA(result->Double(iWS,3),0.3 - 0.02*d,1e-10);
+      TS_ASSERT_DELTA(result->Double(iWS,5),2 - 0.2*d,1e-10);
+      TS_ASSERT_DELTA(result->Double(iWS,7),5 + 0.03*d,1e-10);
+      TS_ASSERT_DELTA(result->Double(iWS,9),0.1 + 0.01*d,1e-10);
+    }
+
+    deleteData();
+    WorkspaceCreationHelper::removeWS("PlotPeakResult");
+  }
+
   void testWorkspaceList()
   {
     createData();
@@ -249,6 +249,8 @@ namespace DataHandling
 
     void init();
     void exec();
+    /// Cross-check the properties
+    std::map<std::string, std::string> validateInputs();
 
     /// ISIS specific methods for dealing with wide events
     static void loadTimeOfFlight(const std::string &nexusfilename, DataObjects::EventWorkspace_sptr WS,
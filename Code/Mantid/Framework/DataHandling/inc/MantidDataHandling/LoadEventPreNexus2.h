@@ -208,8 +208,16 @@ private:
 
   void procEvents(DataObjects::EventWorkspace_sptr & workspace);
 
+  void procEventsParallel(DataObjects::EventWorkspace_sptr & workspace);
+
   void procEventsLinear(DataObjects::EventWorkspace_sptr & workspace, std::vector<DataObjects::TofEvent> ** arrayOfVectors, DasEvent * event_buffer,
-                        size_t current_event_buffer_size, size_t fileOffset, bool dbprint);
+                        size_t current_event_buffer_size, size_t fileOffset, bool dbprint,
+                        PixelType * goodPixels = NULL, size_t * spectrumCounts = NULL);
+
+  void fillEvents(const DasEvent * event_buffer, const PixelType * goodPixels, size_t numEvents, size_t fileOffset,
+                  std::vector<std::vector<DataObjects::TofEvent> *> & spectrumEvents, std::vector<size_t> & positions) const;
+
+  int64_t firstPulseIndex(size_t fileOffset, int64_t numPulses) const;
 
   void setProtonCharge(DataObjects::EventWorkspace_sptr & workspace);
 
@@ -129,6 +129,8 @@ namespace Mantid
       void init();
       /// Overwrites Algorithm method
       void exec();
+      /// Cross-check the properties
+      std::map<std::string, std::string> validateInputs();
       // Validate the optional input properties
       void checkOptionalProperties(const std::map<int64_t,std::string> &ExcludedMonitors);
       /// Prepare a vector of SpectraBlock structures to simplify loading
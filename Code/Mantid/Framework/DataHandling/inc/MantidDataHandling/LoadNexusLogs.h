@@ -7,6 +7,8 @@
 #include "MantidAPI/Algorithm.h"
 #include <nexus/NeXusFile.hpp>
 
+#include <set>
+
 namespace Mantid
 {
   //----------------------------------------------------------------------
@@ -34,6 +36,12 @@ namespace Mantid
     <LI> Workspace - The name of the workspace in which to store the imported data.</LI>
     </UL>
 
+    Optional Properties:
+    <UL>
+    <LI> LogAllowList - If given, only the logs with these names are loaded </LI>
+    <LI> LogBlockList - The logs with these names are not loaded </LI>
+    </UL>
+
     @author Martyn Gigg, Tessella plc
 
     Copyright &copy; 2011 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge National Laboratory & European Spallation Source
@@ -78,6 +86,10 @@ namespace Mantid
       void init();
       /// Overwrites Algorithm method
       void exec();
+      /// Cross-check the properties
+      std::map<std::string, std::string> validateInputs();
+      /// Check a log against the allow and block lists
+      bool isLogWanted(const std::string & logName) const;
       /// Load log data from a group
       void loadLogs(::NeXus::File & file, const std::string & entry_name, 
                     const std::string & entry_class, 
@@ -99,6 +111,10 @@ namespace Mantid
 
       ///Use frequency start for Monitor19 and Special1_19 logs with "No Time" for SNAP
       std::string freqStart;
+      /// Only the logs with these names are loaded, if any are given
+      std::set<std::string> m_allowList;
+      /// The logs with these names are not loaded
+      std::set<std::string> m_blockList;
     };
 
   } // namespace DataHandling
@@ -133,6 +133,11 @@ namespace Mantid
       ///Read the bin masking information
       void readBinMasking(Mantid::NeXus::NXData & wksp_cls, API::MatrixWorkspace_sptr local_workspace);
 
+      /// Copy a block of spectra read from the file into the workspace
+      void fillBlock(const double * data, const double * errors, const double * farea,
+                     int64_t blocksize, int64_t nchannels, int64_t wsIndex, bool setSharedX,
+                     API::MatrixWorkspace_sptr local_workspace);
+
       /// Load a block of data into the workspace where it is assumed that the x bins have already been cached
       void loadBlock(Mantid::NeXus::NXDataSetTyped<double> & data,
                      Mantid::NeXus::NXDataSetTyped<double> & errors,
@@ -69,9 +69,6 @@ namespace Mantid
       /// Overwrites Algorithm method
       void exec();
 
-      /// returns true if the given spectrum is a monitor
-      bool isMonitor(const std::vector<specid_t>& monitorIndexes,specid_t spectrumNum);
-
       /// validate workspace sizes
       void validateWorkspaceSizes( bool bexcludeMonitors ,bool bseparateMonitors,
           const int64_t normalwsSpecs,const int64_t  monitorwsSpecs);
@@ -87,6 +84,14 @@ namespace Mantid
       void separateMonitors(FILE* file,const int64_t& period,const std::vector<specid_t>& monitorList,
           DataObjects::Workspace2D_sptr ws_sptr,DataObjects::Workspace2D_sptr mws_sptr);
 
+      /// reads the spectra of a period into their target workspaces
+      void readSpectra(FILE* file,const int64_t& period,
+          const std::vector<DataObjects::Workspace2D_sptr>& targetWS,const std::vector<int64_t>& targetIndex);
+      /// flags the spectra to load
+      std::vector<bool> getSelectedSpectra() const;
+      /// flags the monitor spectra
+      std::vector<bool> getMonitorFlags(const std::vector<specid_t>& monitorList) const;
+
       /// skip all spectra in a period
       void skipPeriod(FILE* file,const int64_t& period);
       /// return true if loading a selection of periods
@@ -21,6 +21,8 @@
 #include "MantidAPI/SpectrumDetectorMapping.h"
 #include "MantidKernel/Timer.h"
 
+#include <algorithm>
+
 using std::endl;
 using std::map;
 using std::string;
@@ -1119,6 +1121,27 @@ namespace Mantid
       declareProperty(
         new PropertyWithValue<bool>("LoadLogs", true, Direction::Input),
         "Load the Sample/DAS logs from the file (default True).");
+
+      declareProperty(new ArrayProperty<std::string>("LogAllowList"),
+        "If given, only the sample logs with these names are loaded. proton_charge is always loaded.");
+      declareProperty(new ArrayProperty<std::string>("LogBlockList"),
+        "The sample logs with these names are not loaded. proton_charge is always loaded.");
+      setPropertySettings("LogAllowList", new VisibleWhenProperty("LoadLogs", IS_EQUAL_TO, "1"));
+      setPropertySettings("LogBlockList", new VisibleWhenProperty("LoadLogs", IS_EQUAL_TO, "1"));
+    }
+
+    //----------------------------------------------------------------------------------------------
+    /// Validate the inputs
+    std::map<std::string, std::string> %s::validateInputs()
+    {
+      std::map<std::string, std::string> result;
+      const std::vector<std::string> allowList = getProperty("LogAllowList");
+      const std::vector<std::string> blockList = getProperty("LogBlockList");
+      if (!allowList.empty() && !blockList.empty())
+      {
+        result["LogBlockList"] = "Cannot specify both LogAllowList and LogBlockList";
+      }
+      return result;
     }
 
     //----------------------------------------------------------------------------------------------
@@ -2783,6 +2806,22 @@ namespace Mantid
         alg.getLogger().information() << "Loading logs from NeXus file..." << "\n";
         loadLogs->setPropertyValue("Filename", nexusfilename);
         loadLogs->setProperty<API::MatrixWorkspace_sptr> ("Workspace", localWorkspace);
+        // Pass on which logs to load, always keeping the proton charge as the pulse times come from it
+        if (alg.existsProperty("LogAllowList"))
+        {
+          std::vector<std::string> allowList = alg.getProperty("LogAllowList");
+          if (!allowList.empty())
+          {
+            allowList.push_back("proton_charge");
+            loadLogs->setProperty("LogAllowList", allowList);
+          }
+        }
+        if (alg.existsProperty("LogBlockList"))
+        {
+          std::vector<std::string> blockList = alg.getProperty("LogBlockList");
+          blockList.erase(std::remove(blockList.begin(), blockList.end(), "proton_charge"), blockList.end());
+          loadLogs->setProperty("LogBlockList", blockList);
+        }
         loadLogs->execute();
 
         //If successful, we can try to load the pulse times
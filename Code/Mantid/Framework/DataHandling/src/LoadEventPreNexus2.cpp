@@ -84,6 +84,10 @@ namespace DataHandling
   static const double CURRENT_CONVERSION = 1.e-6 / 3600.;
   /// Veto flag: 0xFF00000000000
   static const uint64_t VETOFLAG(72057594037927935);
+  /// Marks an event that is not added to any spectrum when processing in parallel
+  static const PixelType SKIPPED_PIXEL = -1;
+  /// The number of loading blocks each thread processes from every chunk read when processing in parallel
+  static const size_t BLOCKS_PER_THREAD = 8;
 
   static const string  EVENT_EXTS[] = {"_neutron_event.dat",
                                        "_neutron0_event.dat",
@@ -730,189 +734,47 @@ namespace DataHandling
     CPUTimer tim;
 
     //-------------------------------------------------------------------------
-    // Create the partial workspaces
+    // LOAD THE DATA
     //-------------------------------------------------------------------------
-    // Vector of partial workspaces, for parallel processing.
-    std::vector<EventWorkspace_sptr> partWorkspaces;
-    std::vector<DasEvent *> buffers;
-
-    /// Pointer to the vector of events
-    typedef std::vector<TofEvent> * EventVector_pt;
-    /// Bare array of arrays of pointers to the EventVectors
-    EventVector_pt ** eventVectors;
-
-    /// How many threads will we use?
-    size_t numThreads = 1;
     if (parallelProcessing)
-      numThreads = size_t(PARALLEL_GET_MAX_THREADS);
-
-
-    partWorkspaces.resize(numThreads);
-    buffers.resize(numThreads);
-    eventVectors = new EventVector_pt *[numThreads];
-
-    // cppcheck-suppress syntaxError
-    PRAGMA_OMP( parallel for if (parallelProcessing) )
-    for (int i=0; i < int(numThreads); i++)
     {
-      // This is the partial workspace we are about to create (if in parallel)
-      EventWorkspace_sptr partWS;
-      if (parallelProcessing)
-      {
-        prog->report("Creating Partial Workspace");
-        // Create a partial workspace
-        partWS = EventWorkspace_sptr(new EventWorkspace());
-        //Make sure to initialize.
-        partWS->initialize(1,1,1);
-        // Copy all the spectra numbers and stuff (no actual events to copy though).
-        partWS->copyDataFrom(*workspace);
-        // Push it in the array
-        partWorkspaces[i] = partWS;
-      }
-      else
-        partWS = workspace;
-
-      //Allocate the buffers
-      buffers[i] = new DasEvent[loadBlockSize];
-
-      // For each partial workspace, make an array where index = detector ID and value = pointer to the events vector
-      eventVectors[i] = new EventVector_pt[detid_max+1];
-      EventVector_pt * theseEventVectors = eventVectors[i];
-      for (detid_t j=0; j<detid_max+1; j++)
-      {
-        size_t wi = pixel_to_wkspindex[j];
-        // Save a POINTER to the vector<tofEvent>
-        theseEventVectors[j] = &partWS->getEventList(wi).getEvents();
-      }
+      procEventsParallel(workspace);
     }
-
-    g_log.information() << tim << " to create " << partWorkspaces.size()
-                        << " workspaces (same as number of threads) for parallel loading "
-                        << numBlocks << " blocks. " << "\n";
-
-    prog->resetNumSteps( numBlocks, 0.1, 0.8);
-
-    //-------------------------------------------------------------------------
-    // LOAD THE DATA
-    //-------------------------------------------------------------------------
-
-    PRAGMA_OMP( parallel for schedule(dynamic, 1) if (parallelProcessing) )
-    for (int blockNum=0; blockNum<int(numBlocks); blockNum++)
+    else
     {
-      PARALLEL_START_INTERUPT_REGION
+      DasEvent * event_buffer = new DasEvent[loadBlockSize];
 
-      // Find the workspace for this particular thread
-      EventWorkspace_sptr ws;
-      size_t threadNum = 0;
-      if (parallelProcessing)
+      // Make an array where index = detector ID and value = pointer to the events vector
+      std::vector<TofEvent> ** eventVectors = new std::vector<TofEvent> *[detid_max+1];
+      for (detid_t j=0; j<detid_max+1; j++)
       {
-        threadNum = PARALLEL_THREAD_NUMBER;
-        ws = partWorkspaces[threadNum];
+        eventVectors[j] = &workspace->getEventList(pixel_to_wkspindex[j]).getEvents();
       }
-      else
-        ws = workspace;
 
-      // Get the buffer (for this thread)
-      DasEvent * event_buffer = buffers[threadNum];
-
-      // Get the speeding-up array of vector<tofEvent> where index = detid.
-      EventVector_pt * theseEventVectors = eventVectors[threadNum];
-
-      // Where to start in the file?
-      size_t fileOffset = first_event + (loadBlockSize * blockNum);
-      // May need to reduce size of last (or only) block
-      size_t current_event_buffer_size =
-          ( blockNum == int(numBlocks-1) ) ? ( max_events - (numBlocks-1)*loadBlockSize ) : loadBlockSize;
-
-      // Load this chunk of event data (critical block)
-      PARALLEL_CRITICAL( LoadEventPreNexus2_fileAccess )
+      prog->resetNumSteps( numBlocks, 0.1, 0.94);
+      for (size_t blockNum=0; blockNum<numBlocks; blockNum++)
       {
+        // Where to start in the file?
+        size_t fileOffset = first_event + (loadBlockSize * blockNum);
+        // May need to reduce size of last (or only) block
+        size_t current_event_buffer_size =
+            ( blockNum == numBlocks-1 ) ? ( max_events - (numBlocks-1)*loadBlockSize ) : loadBlockSize;
+
         current_event_buffer_size = eventfile->loadBlockAt(event_buffer, fileOffset, current_event_buffer_size);
-      }
 
-      // This processes the events. Can be done in parallel!
-      bool dbprint = m_dbOutput && (blockNum == m_dbOpBlockNumber);
-      procEventsLinear(ws, theseEventVectors, event_buffer, current_event_buffer_size, fileOffset, dbprint);
+        bool dbprint = m_dbOutput && (int(blockNum) == m_dbOpBlockNumber);
+        procEventsLinear(workspace, eventVectors, event_buffer, current_event_buffer_size, fileOffset, dbprint);
 
-      // Report progress
-      prog->report("Load Event PreNeXus");
+        prog->report("Load Event PreNeXus");
+        interruption_point();
+      }
 
-      PARALLEL_END_INTERUPT_REGION
+      delete [] eventVectors;
+      delete [] event_buffer;
     }
-    PARALLEL_CHECK_INTERUPT_REGION
 
     g_log.debug() << tim << " to load the data." << std::endl;
 
-
-    //-------------------------------------------------------------------------
-    // MERGE WORKSPACES BACK TOGETHER
-    //-------------------------------------------------------------------------
-    if (parallelProcessing)
-    {
-      PARALLEL_START_INTERUPT_REGION
-      prog->resetNumSteps( workspace->getNumberHistograms(), 0.8, 0.95);
-
-      size_t memoryCleared = 0;
-      MemoryManager::Instance().releaseFreeMemory();
-
-      // Merge all workspaces, index by index.
-      PARALLEL_FOR_NO_WSP_CHECK()
-      for (int iwi=0; iwi<int(workspace->getNumberHistograms()); iwi++)
-      {
-        size_t wi = size_t(iwi);
-
-        // The output event list.
-        EventList & el = workspace->getEventList(wi);
-        el.clear(false);
-
-        // How many events will it have?
-        size_t numEvents = 0;
-        for (size_t i=0; i<numThreads; i++)
-          numEvents += partWorkspaces[i]->getEventList(wi).getNumberEvents();
-        // This will avoid too much copying.
-        el.reserve(numEvents);
-
-        // Now merge the event lists
-        for (size_t i=0; i<numThreads; i++)
-        {
-          EventList & partEl = partWorkspaces[i]->getEventList(wi);
-          el += partEl.getEvents();
-          // Free up memory as you go along.
-          partEl.clear(false);
-        }
-
-        // With TCMalloc, release memory when you accumulate enough to make sense
-        PARALLEL_CRITICAL( LoadEventPreNexus2_trackMemory )
-        {
-          memoryCleared += numEvents;
-          if (memoryCleared > 10000000) // ten million events = about 160 MB
-          {
-            MemoryManager::Instance().releaseFreeMemory();
-            memoryCleared = 0;
-          }
-        }
-        prog->report("Merging Workspaces");
-      }
-      // Final memory release
-      MemoryManager::Instance().releaseFreeMemory();
-      g_log.debug() << tim << " to merge workspaces together." << std::endl;
-      PARALLEL_END_INTERUPT_REGION
-    }
-    PARALLEL_CHECK_INTERUPT_REGION
-
-    //-------------------------------------------------------------------------
-    // Clean memory
-    //-------------------------------------------------------------------------
-
-    // Delete the buffers for each thread.
-    for (size_t i=0; i<numThreads; i++)
-    {
-      delete [] buffers[i];
-      delete [] eventVectors[i];
-    }
-    delete [] eventVectors;
-    //delete [] pulsetimes;
-
     prog->resetNumSteps( 3, 0.94, 1.00);
 
     //-------------------------------------------------------------------------
@@ -971,6 +833,155 @@ namespace DataHandling
 
   } // End of procEvents
 
+  //----------------------------------------------------------------------------------------------
+  /** Process the event file in parallel. The file is read a large chunk at a time and each chunk is
+    * split between the threads. Each thread first sorts out which events are good and counts them
+    * per spectrum, then the event lists are grown to their final size and each thread copies its
+    * events straight into its own slots in them. No partial workspaces need to be merged afterwards.
+    * @param workspace :: EventWorkspace to write to.
+    */
+  void LoadEventPreNexus2::procEventsParallel(DataObjects::EventWorkspace_sptr & workspace)
+  {
+    const size_t numThreads = static_cast<size_t>(PARALLEL_GET_MAX_THREADS);
+    const size_t numHistograms = workspace->getNumberHistograms();
+
+    std::vector<std::vector<TofEvent> *> spectrumEvents(numHistograms);
+    for (size_t wi = 0; wi < numHistograms; ++wi)
+      spectrumEvents[wi] = &workspace->getEventList(wi).getEvents();
+
+    const size_t loadBlockSize = Mantid::Kernel::DEFAULT_BLOCK_SIZE * 2;
+    const size_t chunkSize = std::max(size_t(1), std::min(max_events, loadBlockSize * BLOCKS_PER_THREAD * numThreads));
+    const size_t numChunks = (max_events + chunkSize - 1) / chunkSize;
+    // The block whose events are printed for investigation
+    const size_t dbOpStart = first_event + loadBlockSize * static_cast<size_t>(m_dbOpBlockNumber);
+
+    std::vector<DasEvent> events(chunkSize);
+    // The (mapped) pixel id of each good event, or SKIPPED_PIXEL
+    std::vector<PixelType> goodPixels(chunkSize);
+    // For each thread: the number of good events per spectrum, turned into where to write them
+    std::vector<std::vector<size_t> > positions(numThreads, std::vector<size_t>(numHistograms, 0));
+
+    prog->resetNumSteps( numChunks * 3, 0.1, 0.94);
+    for (size_t chunk = 0; chunk < numChunks; ++chunk)
+    {
+      const size_t chunkOffset = first_event + chunk * chunkSize;
+      const size_t chunkEvents = eventfile->loadBlockAt(&events[0], chunkOffset,
+                                                        std::min(chunkSize, max_events - chunk * chunkSize));
+      prog->report("Load Event PreNeXus");
+
+      // Sort out and count the good events
+      PARALLEL_FOR_NO_WSP_CHECK()
+      for (int64_t t = 0; t < static_cast<int64_t>(numThreads); ++t)
+      {
+        PARALLEL_START_INTERUPT_REGION
+        const size_t thread = static_cast<size_t>(t);
+        const size_t start = chunkEvents * thread / numThreads;
+        const size_t end = chunkEvents * (thread+1) / numThreads;
+        std::vector<size_t> & counts = positions[thread];
+        std::fill(counts.begin(), counts.end(), 0);
+        const bool dbprint = m_dbOutput && (chunkOffset + start <= dbOpStart) && (dbOpStart < chunkOffset + end);
+        procEventsLinear(workspace, NULL, &events[start], end - start, chunkOffset + start, dbprint,
+                         &goodPixels[start], &counts[0]);
+        PARALLEL_END_INTERUPT_REGION
+      }
+      PARALLEL_CHECK_INTERUPT_REGION
+      prog->report("Load Event PreNeXus");
+
+      // Make room for the new events and work out where each thread puts its share
+      PARALLEL_FOR_NO_WSP_CHECK()
+      for (int64_t iwi = 0; iwi < static_cast<int64_t>(numHistograms); ++iwi)
+      {
+        const size_t wi = static_cast<size_t>(iwi);
+        size_t position = spectrumEvents[wi]->size();
+        for (size_t t = 0; t < numThreads; ++t)
+        {
+          const size_t count = positions[t][wi];
+          positions[t][wi] = position;
+          position += count;
+        }
+        if (position > spectrumEvents[wi]->size())
+          spectrumEvents[wi]->resize(position);
+      }
+
+      // Copy the events into place
+      PARALLEL_FOR_NO_WSP_CHECK()
+      for (int64_t t = 0; t < static_cast<int64_t>(numThreads); ++t)
+      {
+        PARALLEL_START_INTERUPT_REGION
+        const size_t thread = static_cast<size_t>(t);
+        const size_t start = chunkEvents * thread / numThreads;
+        const size_t end = chunkEvents * (thread+1) / numThreads;
+        fillEvents(&events[start], &goodPixels[start], end - start, chunkOffset + start,
+                   spectrumEvents, positions[thread]);
+        PARALLEL_END_INTERUPT_REGION
+      }
+      PARALLEL_CHECK_INTERUPT_REGION
+      prog->report("Load Event PreNeXus");
+      interruption_point();
+    }
+  }
+
+  //----------------------------------------------------------------------------------------------
+  /** Copy the good events sorted out by procEventsLinear into their slots in the event lists.
+    * @param event_buffer :: The buffer containing the DAS events
+    * @param goodPixels :: For each event, its pixel ID if it is good or SKIPPED_PIXEL if not
+    * @param numEvents :: The length of the given DAS buffer
+    * @param fileOffset :: Index of the first event of the buffer in the file
+    * @param spectrumEvents :: The events vector of each spectrum, already sized to hold these events
+    * @param positions :: For each spectrum, where to put its next event. Updated as events are added.
+    */
+  void LoadEventPreNexus2::fillEvents(const DasEvent * event_buffer, const PixelType * goodPixels, size_t numEvents,
+                                      size_t fileOffset, std::vector<std::vector<TofEvent> *> & spectrumEvents,
+                                      std::vector<size_t> & positions) const
+  {
+    const int64_t numPulses = static_cast<int64_t>(std::min(num_pulses, event_indices.size()));
+    int64_t pulse_i = firstPulseIndex(fileOffset, numPulses);
+    DateAndTime pulsetime;
+    if (numPulses > 0)
+      pulsetime = pulsetimes[pulse_i];
+
+    for (size_t i = 0; i < numEvents; ++i)
+    {
+      const PixelType pid = goodPixels[i];
+      if (pid == SKIPPED_PIXEL)
+        continue;
+
+      if (pulse_i < numPulses-1)
+      {
+        const size_t total_i = i + fileOffset;
+        while (!((total_i >= event_indices[pulse_i]) && (total_i < event_indices[pulse_i+1])) )
+        {
+          pulse_i++;
+          if (pulse_i >= (numPulses-1))
+            break;
+        }
+        pulsetime = pulsetimes[pulse_i];
+      }
+
+      const double tof = static_cast<double>(event_buffer[i].tof) * TOF_CONVERSION;
+      const size_t wi = pixel_to_wkspindex[pid];
+      (*spectrumEvents[wi])[positions[wi]++] = TofEvent(tof, pulsetime);
+    }
+  }
+
+  //----------------------------------------------------------------------------------------------
+  /** Find where to start looking for the pulse of the event at the given index, without
+    * stepping through all of the earlier pulses.
+    * @param fileOffset :: Index of an event in the file
+    * @param numPulses :: The number of pulses with a known event index
+    * @return The index of the last pulse starting at or before the event
+    */
+  int64_t LoadEventPreNexus2::firstPulseIndex(size_t fileOffset, int64_t numPulses) const
+  {
+    if (numPulses < 2)
+      return 0;
+    auto pulsesEnd = event_indices.begin() + numPulses;
+    auto next = std::upper_bound(event_indices.begin(), pulsesEnd, static_cast<uint64_t>(fileOffset));
+    if (next == event_indices.begin())
+      return 0;
+    return static_cast<int64_t>(next - event_indices.begin()) - 1;
+  }
+
   //----------------------------------------------------------------------------------------------
   /** Linear-version of the procedure to process the event file properly.
     * @param workspace :: EventWorkspace to write to.
@@ -980,21 +991,43 @@ namespace DataHandling
     * @param current_event_buffer_size :: The length of the given DAS buffer
     * @param fileOffset :: Value for an offset into the binary file
     * @param dbprint :: flag to print out events information
+    * @param goodPixels :: If arrayOfVectors is NULL, the good events are not added but their pixel IDs are
+    *        put here, with SKIPPED_PIXEL for the others
+    * @param spectrumCounts :: If arrayOfVectors is NULL, incremented per workspace index for each good event
     */
   void LoadEventPreNexus2::procEventsLinear(DataObjects::EventWorkspace_sptr & /*workspace*/,
                                             std::vector<TofEvent> ** arrayOfVectors, DasEvent * event_buffer,
                                             size_t current_event_buffer_size, size_t fileOffset,
-                                            bool dbprint)
+                                            bool dbprint, PixelType * goodPixels, size_t * spectrumCounts)
   {
-    // Starting pulse time
-    DateAndTime pulsetime;
-    int64_t pulse_i = 0;
     int64_t numPulses = static_cast<int64_t>(num_pulses);
     if (event_indices.size() < num_pulses)
     {
       g_log.warning() << "Event_indices vector is smaller than the pulsetimes array.\n";
       numPulses = static_cast<int64_t>(event_indices.size());
     }
+    // Starting pulse time
+    DateAndTime pulsetime;
+    int64_t pulse_i = firstPulseIndex(fileOffset, numPulses);
+    if (numPulses > 0)
+      pulsetime = pulsetimes[pulse_i];
+
+    // Map all of the pixel IDs first in one tight pass
+    if (goodPixels)
+    {
+      for (size_t i = 0; i < current_event_buffer_size; i++)
+      {
+        const PixelType pid = event_buffer[i].pid;
+        if ((pid & ERROR_PID) == ERROR_PID)
+          goodPixels[i] = pid;
+        else if (pid == 1073741843) // downstream monitor pixel for SNAP
+          goodPixels[i] = 1179648;
+        else if (this->using_mapping_file)
+          goodPixels[i] = this->pixelmap[pid % this->numpixel];
+        else
+          goodPixels[i] = pid;
+      }
+    }
 
     // Local stastic parameters
     size_t local_num_error_events = 0;
@@ -1017,27 +1050,32 @@ namespace DataHandling
     for (size_t i = 0; i < current_event_buffer_size; i++)
     {
       DasEvent & temp = *(event_buffer + i);
-      PixelType pid = temp.pid;
+      PixelType pid = goodPixels ? goodPixels[i] : temp.pid;
       bool iswrongdetid = false;
+      if (goodPixels)
+        goodPixels[i] = SKIPPED_PIXEL;
 
       if (dbprint && i < m_dbOpNumEvents)
         dbss << i << " \t" << temp.tof << " \t" << temp.pid << "\n";
 
       // Filter out bad event
-      if ((pid & ERROR_PID) == ERROR_PID)
+      if ((temp.pid & ERROR_PID) == ERROR_PID)
       {
         local_num_error_events++;
         local_num_bad_events ++;
         continue;
       }
 
-      //Covert the pixel ID from DAS pixel to our pixel ID
-      // downstream monitor pixel for SNAP
-      if(pid ==1073741843) pid = 1179648;
-      else if (this->using_mapping_file)
+      //Covert the pixel ID from DAS pixel to our pixel ID, unless already done above
+      if (!goodPixels)
       {
-        PixelType unmapped_pid = pid % this->numpixel;
-        pid = this->pixelmap[unmapped_pid];
+        // downstream monitor pixel for SNAP
+        if(pid ==1073741843) pid = 1179648;
+        else if (this->using_mapping_file)
+        {
+          PixelType unmapped_pid = pid % this->numpixel;
+          pid = this->pixelmap[unmapped_pid];
+        }
       }
 
       // Wrong pixel IDs
@@ -1095,6 +1133,15 @@ namespace DataHandling
         if (tof > local_longest_tof)
           local_longest_tof = tof;
 
+        if (goodPixels)
+        {
+          // Only count it: the event is copied into place later by fillEvents
+          goodPixels[i] = pid;
+          ++spectrumCounts[this->pixel_to_wkspindex[pid]];
+          ++ local_num_good_events;
+          continue;
+        }
+
         // This is equivalent to workspace->getEventList(this->pixel_to_wkspindex[pid]).addEventQuickly(event);
         // But should be faster as a bunch of these calls were cached.
 #if defined(__GNUC__) && !(defined(__INTEL_COMPILER)) && !(defined(__clang__))
@@ -105,6 +105,23 @@ namespace Mantid
         "1:  Equivalent to Separate.\n"
         "0:  Equivalent to Exclude.\n");
 
+      declareProperty(new ArrayProperty<std::string>("LogAllowList"),
+        "If given, only the sample logs with these names are loaded.");
+      declareProperty(new ArrayProperty<std::string>("LogBlockList"),
+        "The sample logs with these names are not loaded.");
+    }
+
+    /// Validate the inputs
+    std::map<std::string, std::string> %s::validateInputs()
+    {
+      std::map<std::string, std::string> result;
+      const std::vector<std::string> allowList = getProperty("LogAllowList");
+      const std::vector<std::string> blockList = getProperty("LogBlockList");
+      if (!allowList.empty() && !blockList.empty())
+      {
+        result["LogBlockList"] = "Cannot specify both LogAllowList and LogBlockList";
+      }
+      return result;
     }
 
     /** Executes the algorithm. Reading in the file and creating and populating
@@ -1048,6 +1065,8 @@ namespace Mantid
       IAlgorithm_sptr alg = createChildAlgorithm("LoadNexusLogs", 0.0, 0.5);
       alg->setPropertyValue("Filename", this->getProperty("Filename"));
       alg->setProperty<MatrixWorkspace_sptr>("Workspace", ws);
+      alg->setPropertyValue("LogAllowList", getPropertyValue("LogAllowList"));
+      alg->setPropertyValue("LogBlockList", getPropertyValue("LogBlockList"));
       try
       {
         alg->executeAsChildAlg();
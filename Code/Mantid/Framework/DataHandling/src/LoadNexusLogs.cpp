@@ -3,6 +3,7 @@
 //----------------------------------------------------------------------
 #include "MantidDataHandling/LoadNexusLogs.h"
 #include <nexus/NeXusException.hpp>
+#include "MantidKernel/ArrayProperty.h"
 #include "MantidKernel/TimeSeriesProperty.h"
 #include "MantidKernel/LogParser.h"
 #include "MantidAPI/FileProperty.h"
@@ -46,8 +47,23 @@ namespace Mantid
                       "Path to the .nxs file to load. Can be an EventNeXus or a histogrammed NeXus." );
       declareProperty(new PropertyWithValue<bool>("OverwriteLogs", true, Direction::Input),
                       "If true then existing logs will be overwritten, if false they will not.");
+      declareProperty(new ArrayProperty<std::string>("LogAllowList"),
+                      "If given, only the logs with these names are loaded. Others are not read from the file.");
+      declareProperty(new ArrayProperty<std::string>("LogBlockList"),
+                      "The logs with these names are not read from the file.");
+    }
 
-
+    /// Validate the inputs
+    std::map<std::string, std::string> LoadNexusLogs::validateInputs()
+    {
+      std::map<std::string, std::string> result;
+      const std::vector<std::string> allowList = getProperty("LogAllowList");
+      const std::vector<std::string> blockList = getProperty("LogBlockList");
+      if (!allowList.empty() && !blockList.empty())
+      {
+        result["LogBlockList"] = "Cannot specify both LogAllowList and LogBlockList";
+      }
+      return result;
     }
 
     /** Executes the algorithm. Reading in the file and creating and populating
@@ -60,6 +76,10 @@ namespace Mantid
     {
       std::string filename = getPropertyValue("Filename");
       MatrixWorkspace_sptr workspace = getProperty("Workspace");
+      const std::vector<std::string> allowList = getProperty("LogAllowList");
+      m_allowList = std::set<std::string>(allowList.begin(), allowList.end());
+      const std::vector<std::string> blockList = getProperty("LogBlockList");
+      m_blockList = std::set<std::string>(blockList.begin(), blockList.end());
       
 
       // Find the entry name to use (normally "entry" for SNS, "raw_data_1" for ISIS)
@@ -253,6 +273,8 @@ namespace Mantid
      */
     void LoadNexusLogs::loadVetoPulses(::NeXus::File & file, boost::shared_ptr<API::MatrixWorkspace> workspace) const
     {
+      if (!isLogWanted("veto_pulse_time"))
+        return;
       try
       {
         file.openGroup("Veto_pulse", "NXgroup");
@@ -330,6 +352,11 @@ namespace Mantid
                                   const std::string & entry_class,
                                   boost::shared_ptr<API::MatrixWorkspace> workspace) const
     {
+      if (!isLogWanted(entry_name))
+      {
+        g_log.debug() << "skipping " << entry_name << ":" << entry_class << "\n";
+        return;
+      }
       g_log.debug() << "processing " << entry_name << ":" << entry_class << "\n";
 
       file.openGroup(entry_name, entry_class);
@@ -371,6 +398,8 @@ namespace Mantid
     void LoadNexusLogs::loadSELog(::NeXus::File & file, const std::string & entry_name, 
                                 boost::shared_ptr<API::MatrixWorkspace> workspace) const
     {
+      if (!isLogWanted(entry_name))
+        return;
       // Open the entry
       file.openGroup(entry_name, "IXseblock");
       std::string propName = entry_name;
@@ -448,6 +477,17 @@ namespace Mantid
       file.closeGroup();
     }
 
+    /**
+     * @param logName :: The name of a log in the file
+     * @returns True if the log passes the LogAllowList and LogBlockList
+     */
+    bool LoadNexusLogs::isLogWanted(const std::string & logName) const
+    {
+      if (!m_allowList.empty())
+        return (m_allowList.count(logName) > 0);
+      return (m_blockList.count(logName) == 0);
+    }
+
     /**
      * Creates a time series property from the currently opened log entry. It is assumed to
      * have been checked to have a time field and the value entry's name is given as an argument
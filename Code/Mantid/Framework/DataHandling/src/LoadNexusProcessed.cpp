@@ -295,7 +295,7 @@ namespace Mantid
 
       const int nChannels = data.dim1();
 
-      int64_t blockSize = 8; // Read block size. Set to 8 for efficiency. i.e. read 8 histograms at a time.
+      int64_t blockSize = Mantid::NeXus::NexusFileIO::spectraPerBlock(static_cast<size_t>(nChannels)); // Read whole chunks at a time.
       const int64_t nFullBlocks = nHistograms / blockSize; // Truncated number of full blocks to read. Remainder removed
       const int64_t readOptimumStop = (nFullBlocks * blockSize);
       const int64_t readStop = m_spec_max - 1;
@@ -314,27 +314,19 @@ namespace Mantid
         data.load(static_cast<int>(blockSize), static_cast<int>(histIndex));
         errors.load(static_cast<int>(blockSize), static_cast<int>(histIndex));
 
-        double *dataStart = data();
-        double *dataEnd = dataStart + nChannels;
+        const double *dataStart = data();
+        const double *errorStart = errors();
 
-        double *errorStart = errors();
-        double *errorEnd = errorStart + nChannels;
-
-        int64_t final(histIndex + blockSize);
-        while (histIndex < final)
+        PARALLEL_FOR1(periodWorkspace)
+        for (int64_t i = 0; i < blockSize; ++i)
         {
-          MantidVec& Y = periodWorkspace->dataY(wsIndex);
-          Y.assign(dataStart, dataEnd);
-          dataStart += nChannels;
-          dataEnd += nChannels;
-          MantidVec& E = periodWorkspace->dataE(wsIndex);
-          E.assign(errorStart, errorEnd);
-          errorStart += nChannels;
-          errorEnd += nChannels;
-
-          ++wsIndex;
-          ++histIndex;
+          const double *blockData = dataStart + i * nChannels;
+          periodWorkspace->dataY(wsIndex + i).assign(blockData, blockData + nChannels);
+          const double *blockErrors = errorStart + i * nChannels;
+          periodWorkspace->dataE(wsIndex + i).assign(blockErrors, blockErrors + nChannels);
         }
+        wsIndex += blockSize;
+        histIndex += blockSize;
       }
 
       m_cppFile->openPath(mtdEntry.path());
@@ -1317,7 +1309,8 @@ int64_t          index_start = indices[wi];
           fracarea = wksp_cls.openNXDouble("frac_area");
         }
 
-        int64_t blocksize(8);
+        // Read whole chunks of the data sets at a time
+        int64_t blocksize(Mantid::NeXus::NexusFileIO::spectraPerBlock(static_cast<size_t>(nchannels)));
         //const int fullblocks = nspectra / blocksize;
         //size of the workspace
         int64_t fullblocks = total_specs / blocksize;
@@ -1342,7 +1335,8 @@ int64_t          index_start = indices[wi];
 
               if (interval_specs < blocksize)
               {
-                blocksize = total_specs;
+                // total_specs also counts the spectra of the list, which are read separately below
+                blocksize = interval_specs + 1;
                 read_stop = m_spec_max - 1;
               }
               hist_index = m_spec_min - 1;
@@ -1784,6 +1778,45 @@ int64_t          index_start = indices[wi];
       }
     }
 
+    /**
+     * Copy a block of spectra read from the file into the workspace, in parallel
+     * @param data :: The y values of the block
+     * @param errors :: The error values of the block
+     * @param farea :: The fraction area values of the block, NULL if there are none
+     * @param blocksize :: The number of spectra in the block
+     * @param nchannels :: The number of channels of each spectrum
+     * @param wsIndex :: The workspace index of the first spectrum of the block
+     * @param setSharedX :: If true, give the spectra the cached x bins
+     * @param local_workspace :: A pointer to the workspace, a RebinnedOutput if farea is set
+     */
+    void LoadNexusProcessed::fillBlock(const double * data, const double * errors, const double * farea,
+        int64_t blocksize, int64_t nchannels, int64_t wsIndex, bool setSharedX,
+        API::MatrixWorkspace_sptr local_workspace)
+    {
+      RebinnedOutput_sptr rb_workspace;
+      if (farea)
+        rb_workspace = boost::dynamic_pointer_cast<RebinnedOutput>(local_workspace);
+      PARALLEL_FOR1(local_workspace)
+      for (int64_t i = 0; i < blocksize; ++i)
+      {
+        PARALLEL_START_INTERUPT_REGION
+        const int64_t offset = i * nchannels;
+        const size_t index = static_cast<size_t>(wsIndex + i);
+        local_workspace->dataY(index).assign(data + offset, data + offset + nchannels);
+        local_workspace->dataE(index).assign(errors + offset, errors + offset + nchannels);
+        if (rb_workspace)
+        {
+          rb_workspace->dataF(index).assign(farea + offset, farea + offset + nchannels);
+        }
+        if (setSharedX)
+        {
+          local_workspace->setX(index, m_xbins);
+        }
+        PARALLEL_END_INTERUPT_REGION
+      }
+      PARALLEL_CHECK_INTERUPT_REGION
+    }
+
     /**
      * Perform a call to nxgetslab, via the NexusClasses wrapped methods for a given blocksize. This assumes that the
      * xbins have alread been cached
@@ -1802,41 +1835,16 @@ int64_t          index_start = indices[wi];
     {
       data.load(static_cast<int>(blocksize), static_cast<int>(hist));
       errors.load(static_cast<int>(blocksize), static_cast<int>(hist));
-      double *data_start = data();
-      double *data_end = data_start + nchannels;
-      double *err_start = errors();
-      double *err_end = err_start + nchannels;
-      double *farea_start = NULL;
-      double *farea_end = NULL;
-      RebinnedOutput_sptr rb_workspace;
+      const double *data_start = data();
+      const double *err_start = errors();
+      const double *farea_start = NULL;
       if (hasFArea)
       {
         farea.load(static_cast<int>(blocksize), static_cast<int>(hist));
         farea_start = farea();
-        farea_end = farea_start + nchannels;
-        rb_workspace = boost::dynamic_pointer_cast<RebinnedOutput>(local_workspace);
-      }
-      int64_t final(hist + blocksize);
-      while (hist < final)
-      {
-        MantidVec& Y = local_workspace->dataY(hist);
-        Y.assign(data_start, data_end);
-        data_start += nchannels;
-        data_end += nchannels;
-        MantidVec& E = local_workspace->dataE(hist);
-        E.assign(err_start, err_end);
-        err_start += nchannels;
-        err_end += nchannels;
-        if (hasFArea)
-        {
-          MantidVec& F = rb_workspace->dataF(hist);
-          F.assign(farea_start, farea_end);
-          farea_start += nchannels;
-          farea_end += nchannels;
-        }
-        local_workspace->setX(hist, m_xbins);
-        ++hist;
       }
+      fillBlock(data_start, err_start, farea_start, blocksize, nchannels, hist, true, local_workspace);
+      hist += blocksize;
     }
 
     /**
@@ -1859,43 +1867,17 @@ int64_t          index_start = indices[wi];
     {
       data.load(static_cast<int>(blocksize), static_cast<int>(hist));
       errors.load(static_cast<int>(blocksize), static_cast<int>(hist));
-      double *data_start = data();
-      double *data_end = data_start + nchannels;
-      double *err_start = errors();
-      double *err_end = err_start + nchannels;
-      double *farea_start = NULL;
-      double *farea_end = NULL;
-      RebinnedOutput_sptr rb_workspace;
+      const double *data_start = data();
+      const double *err_start = errors();
+      const double *farea_start = NULL;
       if (hasFArea)
       {
         farea.load(static_cast<int>(blocksize), static_cast<int>(hist));
         farea_start = farea();
-        farea_end = farea_start + nchannels;
-        rb_workspace = boost::dynamic_pointer_cast<RebinnedOutput>(local_workspace);
-      }
-      int64_t final(hist + blocksize);
-      while (hist < final)
-      {
-        MantidVec& Y = local_workspace->dataY(wsIndex);
-        Y.assign(data_start, data_end);
-        data_start += nchannels;
-        data_end += nchannels;
-        MantidVec& E = local_workspace->dataE(wsIndex);
-        E.assign(err_start, err_end);
-        err_start += nchannels;
-        err_end += nchannels;
-        if (hasFArea)
-        {
-          MantidVec& F = rb_workspace->dataF(wsIndex);
-          F.assign(farea_start, farea_end);
-          farea_start += nchannels;
-          farea_end += nchannels;
-        }
-        local_workspace->setX(wsIndex, m_xbins);
-        ++hist;
-        ++wsIndex;
-
       }
+      fillBlock(data_start, err_start, farea_start, blocksize, nchannels, wsIndex, true, local_workspace);
+      hist += blocksize;
+      wsIndex += blocksize;
     }
 
     /**
@@ -1917,50 +1899,30 @@ int64_t          index_start = indices[wi];
         int64_t nchannels, int64_t &hist, int64_t& wsIndex, API::MatrixWorkspace_sptr local_workspace)
     {
       data.load(static_cast<int>(blocksize), static_cast<int>(hist));
-      double *data_start = data();
-      double *data_end = data_start + nchannels;
+      const double *data_start = data();
       errors.load(static_cast<int>(blocksize), static_cast<int>(hist));
-      double *err_start = errors();
-      double *err_end = err_start + nchannels;
-      double *farea_start = NULL;
-      double *farea_end = NULL;
-      RebinnedOutput_sptr rb_workspace;
+      const double *err_start = errors();
+      const double *farea_start = NULL;
       if (hasFArea)
       {
         farea.load(static_cast<int>(blocksize), static_cast<int>(hist));
         farea_start = farea();
-        farea_end = farea_start + nchannels;
-        rb_workspace = boost::dynamic_pointer_cast<RebinnedOutput>(local_workspace);
       }
       xbins.load(static_cast<int>(blocksize), static_cast<int>(hist));
       const int64_t nxbins(nchannels + 1);
-      double *xbin_start = xbins();
-      double *xbin_end = xbin_start + nxbins;
-      int64_t final(hist + blocksize);
-      while (hist < final)
-      {
-        MantidVec& Y = local_workspace->dataY(wsIndex);
-        Y.assign(data_start, data_end);
-        data_start += nchannels;
-        data_end += nchannels;
-        MantidVec& E = local_workspace->dataE(wsIndex);
-        E.assign(err_start, err_end);
-        err_start += nchannels;
-        err_end += nchannels;
-        if (hasFArea)
-        {
-          MantidVec& F = rb_workspace->dataF(wsIndex);
-          F.assign(farea_start, farea_end);
-          farea_start += nchannels;
-          farea_end += nchannels;
-        }
-        MantidVec& X = local_workspace->dataX(wsIndex);
-        X.assign(xbin_start, xbin_end);
-        xbin_start += nxbins;
-        xbin_end += nxbins;
-        ++hist;
-        ++wsIndex;
+      const double *xbin_start = xbins();
+      fillBlock(data_start, err_start, farea_start, blocksize, nchannels, wsIndex, false, local_workspace);
+      PARALLEL_FOR1(local_workspace)
+      for (int64_t i = 0; i < blocksize; ++i)
+      {
+        PARALLEL_START_INTERUPT_REGION
+        const double *blockX = xbin_start + i * nxbins;
+        local_workspace->dataX(wsIndex + i).assign(blockX, blockX + nxbins);
+        PARALLEL_END_INTERUPT_REGION
       }
+      PARALLEL_CHECK_INTERUPT_REGION
+      hist += blocksize;
+      wsIndex += blocksize;
     }
 
     /**
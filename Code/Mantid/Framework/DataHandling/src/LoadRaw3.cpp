@@ -13,7 +13,9 @@
 #include "MantidKernel/BoundedValidator.h"
 #include "MantidKernel/ListValidator.h"
 #include "MantidAPI/FileProperty.h"
+#include "MantidKernel/MultiThreaded.h"
 #include "LoadRaw/isisraw2.h"
+#include "LoadRaw/byte_rel_comp.h"
 #include "MantidDataHandling/LoadLog.h"
 #include "MantidAPI/SpectrumDetectorMapping.h"
 
@@ -28,6 +30,11 @@ namespace Mantid
   {
     DECLARE_FILELOADER_ALGORITHM(LoadRaw3);
 
+    namespace
+    {
+      /// Maximum size in bytes of the compressed data read from the file in one go
+      const size_t MAX_BLOCK_SIZE = 16 * 1024 * 1024;
+    }
 
     using namespace Kernel;
     using namespace API;
@@ -317,49 +324,21 @@ namespace Mantid
     void LoadRaw3::excludeMonitors(FILE* file,const int & period,const std::vector<specid_t>& monitorList,
         DataObjects::Workspace2D_sptr ws_sptr)
     {
-      int64_t histCurrent = -1;
+      const std::vector<bool> selected = getSelectedSpectra();
+      const std::vector<bool> monitors = getMonitorFlags(monitorList);
+      std::vector<DataObjects::Workspace2D_sptr> targetWS(m_numberOfSpectra + 1);
+      std::vector<int64_t> targetIndex(m_numberOfSpectra + 1, -1);
       int64_t wsIndex=0;
-      double histTotal = static_cast<double>(m_total_specs * m_numberOfPeriods);
-      //loop through the spectra
       for (specid_t i = 1; i <= m_numberOfSpectra; ++i)
       {
-        specid_t histToRead = i + period * (m_numberOfSpectra + 1);
-        if ((i >= m_spec_min && i < m_spec_max) || (m_list && find(m_spec_list.begin(), m_spec_list.end(),
-            i) != m_spec_list.end()))
+        //skip monitor spectrum
+        if (selected[i] && !monitors[i])
         {
-          progress(m_prog, "Reading raw file data...");
-          //skip monitor spectrum
-          if (isMonitor(monitorList, i))
-          {
-            skipData(file, histToRead);
-            continue;
-          }
-
-          //read spectrum
-          if (!readData(file, histToRead))
-          {
-            throw std::runtime_error("Error reading raw file");
-          }
-          //set the workspace data
-          setWorkspaceData(ws_sptr, m_timeChannelsVec, wsIndex, i, m_noTimeRegimes,m_lengthIn,1);
-          //increment workspace index
-          ++wsIndex;
-
-          if (m_numberOfPeriods == 1)
-          {
-            if (++histCurrent % 100 == 0)
-            {
-              setProg( static_cast<double>(histCurrent) / histTotal );
-            }
-            interruption_point();
-          }
-
-        }//end of if loop for spec min,max check
-        else
-        {
-          skipData(file, histToRead);
+          targetWS[i] = ws_sptr;
+          targetIndex[i] = wsIndex++;
         }
-      }//end of for loop
+      }
+      readSpectra(file, period, targetWS, targetIndex);
     }
 
     /**This method creates outputworkspace including monitors
@@ -369,44 +348,19 @@ namespace Mantid
      */
     void LoadRaw3::includeMonitors(FILE* file,const int64_t& period,DataObjects::Workspace2D_sptr ws_sptr)
     {
-
-      int64_t histCurrent = -1;
+      const std::vector<bool> selected = getSelectedSpectra();
+      std::vector<DataObjects::Workspace2D_sptr> targetWS(m_numberOfSpectra + 1);
+      std::vector<int64_t> targetIndex(m_numberOfSpectra + 1, -1);
       int64_t wsIndex=0;
-      double histTotal = static_cast<double>(m_total_specs * m_numberOfPeriods);
-      //loop through spectra
       for (specid_t i = 1; i <= m_numberOfSpectra; ++i)
       {
-        int64_t histToRead = i + period * (m_numberOfSpectra + 1);
-        if ((i >= m_spec_min && i < m_spec_max) || (m_list && find(m_spec_list.begin(), m_spec_list.end(),
-            i) != m_spec_list.end()))
+        if (selected[i])
         {
-          progress(m_prog, "Reading raw file data...");
-
-          //read spectrum from raw file
-          if (!readData(file, histToRead))
-          {
-            throw std::runtime_error("Error reading raw file");
-          }
-          //set workspace data
-          setWorkspaceData(ws_sptr, m_timeChannelsVec, wsIndex, i, m_noTimeRegimes,m_lengthIn,1);
-          ++wsIndex;
-
-          if (m_numberOfPeriods == 1)
-          {
-            if (++histCurrent % 100 == 0)
-            {
-              setProg( double(histCurrent) / histTotal );
-            }
-            interruption_point();
-          }
-
-        }
-        else
-        {
-          skipData(file, histToRead);
+          targetWS[i] = ws_sptr;
+          targetIndex[i] = wsIndex++;
         }
       }
-      //loadSpectra(file,period,m_total_specs,ws_sptr,m_timeChannelsVec);
+      readSpectra(file, period, targetWS, targetIndex);
     }
 
     /** This method separates monitors and creates two outputworkspaces
@@ -420,53 +374,147 @@ namespace Mantid
     void LoadRaw3::separateMonitors(FILE* file,const int64_t& period,const std::vector<specid_t>& monitorList,
         DataObjects::Workspace2D_sptr ws_sptr,DataObjects::Workspace2D_sptr mws_sptr)
     {
-      int64_t histCurrent = -1;
+      const std::vector<bool> selected = getSelectedSpectra();
+      const std::vector<bool> monitors = getMonitorFlags(monitorList);
+      std::vector<DataObjects::Workspace2D_sptr> targetWS(m_numberOfSpectra + 1);
+      std::vector<int64_t> targetIndex(m_numberOfSpectra + 1, -1);
       int64_t wsIndex=0;
       int64_t mwsIndex=0;
-      double histTotal = static_cast<double>(m_total_specs * m_numberOfPeriods);
-      //loop through spectra
       for (specid_t i = 1; i <= m_numberOfSpectra; ++i)
       {
-        int64_t histToRead = i + period * (m_numberOfSpectra + 1);
-        if ((i >= m_spec_min && i < m_spec_max) || (m_list && find(m_spec_list.begin(), m_spec_list.end(),
-            i) != m_spec_list.end()))
+        if (!selected[i]) continue;
+        //if this a monitor  store that spectrum to monitor workspace
+        if (monitors[i])
+        {
+          targetWS[i] = mws_sptr;
+          targetIndex[i] = mwsIndex++;
+        }
+        else
         {
-          progress(m_prog, "Reading raw file data...");
+          //not a monitor,store the spectrum to normal output workspace
+          targetWS[i] = ws_sptr;
+          targetIndex[i] = wsIndex++;
+        }
+      }
+      readSpectra(file, period, targetWS, targetIndex);
+    }
 
-          //read spectrum from raw file
-          if (!readData(file, histToRead))
-          {
+    /**
+     * Read the spectra of a period and put them in the output workspaces.
+     * The compressed data of consecutive spectra that are loaded is read in one go,
+     * then the spectra are expanded in parallel straight into the workspaces.
+     * The file must be positioned at spectrum 1 of the period and is left at the end of it.
+     * @param file :: -pointer to file
+     * @param period :: period number
+     * @param targetWS :: the workspace each spectrum (indexed by spectrum number) goes to, null to skip it
+     * @param targetIndex :: the workspace index of each spectrum in its target workspace
+     */
+    void LoadRaw3::readSpectra(FILE* file,const int64_t& period,
+        const std::vector<DataObjects::Workspace2D_sptr>& targetWS,const std::vector<int64_t>& targetIndex)
+    {
+      const int64_t firstHist = period * (m_numberOfSpectra + 1);
+      const double histTotal = static_cast<double>(m_total_specs * m_numberOfPeriods);
+      const int numberOfChannels = isisRaw->t_ntc1 + 1;
+      int64_t histCurrent = 0;
+
+      // Buffers for the expanded counts, one per thread
+      std::vector<std::vector<uint32_t> > expanded(PARALLEL_GET_MAX_THREADS, std::vector<uint32_t>(numberOfChannels));
+      std::vector<char> block;
+      std::vector<specid_t> blockSpectra;
+      std::vector<size_t> blockOffsets;
+
+      specid_t i = 1;
+      while (i <= m_numberOfSpectra)
+      {
+        if (!targetWS[i])
+        {
+          skipData(file, firstHist + i);
+          ++i;
+          continue;
+        }
+
+        // Gather a run of consecutive spectra to load that fits in a block
+        blockSpectra.clear();
+        blockOffsets.clear();
+        size_t blockSize = 0;
+        while (i <= m_numberOfSpectra && targetWS[i])
+        {
+          const int64_t hist = firstHist + i;
+          if (hist >= isisRaw->ndes)
             throw std::runtime_error("Error reading raw file");
-          }
-          //if this a monitor  store that spectrum to monitor workspace
-          if (isMonitor(monitorList, i))
-          {
-            setWorkspaceData(mws_sptr, m_timeChannelsVec, mwsIndex, i, m_noTimeRegimes,m_lengthIn,1);
-            ++mwsIndex;
-          }
-          else
-          {
-            //not a monitor,store the spectrum to normal output workspace
-            setWorkspaceData(ws_sptr, m_timeChannelsVec, wsIndex, i, m_noTimeRegimes,m_lengthIn,1);
-            ++wsIndex;
-          }
+          const size_t nbytes = 4 * static_cast<size_t>(isisRaw->ddes[hist].nwords);
+          if (!blockSpectra.empty() && blockSize + nbytes > MAX_BLOCK_SIZE) break;
+          blockSpectra.push_back(i);
+          blockOffsets.push_back(blockSize);
+          blockSize += nbytes;
+          ++i;
+        }
+        blockOffsets.push_back(blockSize);
 
-          if (m_numberOfPeriods == 1)
-          {
-            if (++histCurrent % 100 == 0)
-            {
-              setProg( static_cast<double>(histCurrent) / histTotal );
-            }
-            interruption_point();
-          }
+        progress(m_prog, "Reading raw file data...");
+        block.resize(blockSize + 1);
+        if (blockSize > 0 && fread(&block[0], 1, blockSize, file) != blockSize)
+        {
+          throw std::runtime_error("Error reading raw file");
+        }
 
+        const int64_t numInBlock = static_cast<int64_t>(blockSpectra.size());
+        PARALLEL_FOR_NO_WSP_CHECK()
+        for (int64_t j = 0; j < numInBlock; ++j)
+        {
+          PARALLEL_START_INTERUPT_REGION
+          const specid_t spec = blockSpectra[j];
+          std::vector<uint32_t> & counts = expanded[PARALLEL_THREAD_NUMBER];
+          const int nbytes = static_cast<int>(blockOffsets[j + 1] - blockOffsets[j]);
+          byte_rel_expn(&block[blockOffsets[j]], nbytes, 0, reinterpret_cast<int*>(&counts[0]), numberOfChannels);
+          setWorkspaceData(targetWS[spec], m_timeChannelsVec, targetIndex[spec], spec, m_noTimeRegimes, m_lengthIn, 1, &counts[0]);
+          PARALLEL_END_INTERUPT_REGION
         }
-        else
+        PARALLEL_CHECK_INTERUPT_REGION
+
+        if (m_numberOfPeriods == 1)
         {
-          skipData(file, histToRead);
+          histCurrent += numInBlock;
+          setProg( static_cast<double>(histCurrent) / histTotal );
+          interruption_point();
         }
       }
+    }
+
+    /**
+     * Flag the spectra selected by the SpectrumMin, SpectrumMax and SpectrumList properties.
+     * @return a vector indexed by spectrum number
+     */
+    std::vector<bool> LoadRaw3::getSelectedSpectra() const
+    {
+      std::vector<bool> selected(m_numberOfSpectra + 1, false);
+      for (specid_t i = 1; i <= m_numberOfSpectra; ++i)
+      {
+        selected[i] = (i >= m_spec_min && i < m_spec_max);
+      }
+      if (m_list)
+      {
+        for (auto it = m_spec_list.begin(); it != m_spec_list.end(); ++it)
+        {
+          if (*it >= 1 && *it <= m_numberOfSpectra) selected[*it] = true;
+        }
+      }
+      return selected;
+    }
 
+    /**
+     * Flag the monitor spectra.
+     * @param monitorList :: a list containing the spectrum numbers for monitors
+     * @return a vector indexed by spectrum number
+     */
+    std::vector<bool> LoadRaw3::getMonitorFlags(const std::vector<specid_t>& monitorList) const
+    {
+      std::vector<bool> monitors(m_numberOfSpectra + 1, false);
+      for (auto it = monitorList.begin(); it != monitorList.end(); ++it)
+      {
+        if (*it >= 1 && *it <= m_numberOfSpectra) monitors[*it] = true;
+      }
+      return monitors;
     }
 
     /**
@@ -565,19 +613,5 @@ namespace Mantid
 
     }
 
-    /** This method checks given spectrum is a monitor
-     *  @param monitorIndexes :: a vector holding the list of monitors
-     *  @param spectrumNum ::  the requested spectrum number
-     *  @return true if it's a monitor
-     */
-    bool LoadRaw3::isMonitor(const std::vector<specid_t>& monitorIndexes, specid_t spectrumNum)
-    {
-      bool bMonitor;
-      std::vector<specid_t>::const_iterator itr;
-      itr = find(monitorIndexes.begin(), monitorIndexes.end(), spectrumNum);
-      (itr != monitorIndexes.end()) ? (bMonitor = true) : (bMonitor = false);
-      return bMonitor;
-    }
-
   } // namespace DataHandling
 } // namespace Mantid
@@ -374,13 +374,32 @@ namespace Mantid
      */
     void LoadRawHelper::setWorkspaceData(DataObjects::Workspace2D_sptr newWorkspace, const std::vector<
         boost::shared_ptr<MantidVec> >& timeChannelsVec, int64_t wsIndex, specid_t nspecNum, int64_t noTimeRegimes,int64_t lengthIn,int64_t binStart)
+    {
+      setWorkspaceData(newWorkspace, timeChannelsVec, wsIndex, nspecNum, noTimeRegimes, lengthIn, binStart, isisRaw->dat1);
+    }
+
+    /** This method sets decoded spectrum data to workspace vectors.
+     *  It only changes the given workspace index so it can be called for different
+     *  workspace indices in parallel.
+     *  @param newWorkspace ::  shared pointer to the  workspace
+     *  @param timeChannelsVec ::  vector holding the X data
+     *  @param  wsIndex  variable used for indexing the output workspace
+     *  @param  nspecNum  spectrum number
+     *  @param noTimeRegimes ::   regime no.
+     *  @param lengthIn :: length of the workspace
+     *  @param binStart :: start of bin
+     *  @param data :: the decoded counts of the spectrum, lengthIn values
+     */
+    void LoadRawHelper::setWorkspaceData(DataObjects::Workspace2D_sptr newWorkspace, const std::vector<
+        boost::shared_ptr<MantidVec> >& timeChannelsVec, int64_t wsIndex, specid_t nspecNum, int64_t noTimeRegimes,int64_t lengthIn,int64_t binStart,
+        const uint32_t* data) const
     {
       if(!newWorkspace)return;
       typedef double (*uf)(double);
       uf dblSqrt = std::sqrt;
       // But note that the last (overflow) bin is kept
       MantidVec& Y = newWorkspace->dataY(wsIndex);
-      Y.assign(isisRaw->dat1 + binStart, isisRaw->dat1 + lengthIn);
+      Y.assign(data + binStart, data + lengthIn);
       // Fill the vector for the errors, containing sqrt(count)
       MantidVec& E = newWorkspace->dataE(wsIndex);
       std::transform(Y.begin(), Y.end(), E.begin(), dblSqrt); 
@@ -405,7 +424,9 @@ namespace Mantid
       {
 
         // Use std::vector::at just incase spectrum missing from spec array
-        newWorkspace->setX(wsIndex, timeChannelsVec.at(m_specTimeRegimes[nspecNum] - 1));
+        auto regime = m_specTimeRegimes.find(nspecNum);
+        const specid_t timeRegime = (regime != m_specTimeRegimes.end()) ? regime->second : 0;
+        newWorkspace->setX(wsIndex, timeChannelsVec.at(timeRegime - 1));
       }
 
     }
@@ -382,6 +382,19 @@ public:
     TS_ASSERT_EQUALS( ws->getNumberEvents(), 0 );
   }
 
+  void test_Giving_Both_Log_Lists_Fails()
+  {
+    LoadEventNexus load;
+    TS_ASSERT_THROWS_NOTHING( load.initialize() );
+    load.setRethrows(true);
+    TS_ASSERT_THROWS_NOTHING( load.setPropertyValue("Filename", "CNCS_7860_event.nxs") );
+    TS_ASSERT_THROWS_NOTHING( load.setPropertyValue("OutputWorkspace", "cncs_both_lists") );
+    TS_ASSERT_THROWS_NOTHING( load.setPropertyValue("LogAllowList", "Speed4") );
+    TS_ASSERT_THROWS_NOTHING( load.setPropertyValue("LogBlockList", "Phase1") );
+    TS_ASSERT_THROWS( load.execute(), std::runtime_error );
+    TS_ASSERT( !load.isExecuted() );
+  }
+
   void test_instrument_inside_nexus_file()
   {
     LoadEventNexus load;
@@ -522,6 +522,20 @@ public:
     TS_ASSERT_THROWS_NOTHING( v1.initialize() );
     TS_ASSERT_THROWS( v1.execute(), Exception::NotImplementedError)
   }
+
+  void testGivingBothLogListsFails()
+  {
+    LoadISISNexus2 ld;
+    ld.initialize();
+    ld.setRethrows(true);
+    ld.setPropertyValue("Filename","LOQ49886.nxs");
+    ld.setPropertyValue("OutputWorkspace","outWS");
+    ld.setPropertyValue("LogAllowList","icp_event");
+    ld.setPropertyValue("LogBlockList","icp_debug");
+    TS_ASSERT_THROWS( ld.execute(), std::runtime_error );
+    TS_ASSERT( !ld.isExecuted() );
+  }
+
   void testExecMonExcluded()
   {
     Mantid::API::FrameworkManager::Instance();
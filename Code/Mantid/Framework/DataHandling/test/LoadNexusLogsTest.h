@@ -108,6 +108,55 @@ public:
     TS_ASSERT_EQUALS(dlog->size(),172);
   }
 
+  void test_LogAllowList_Loads_Only_Named_Logs()
+  {
+    LoadNexusLogs loader;
+    loader.initialize();
+    MatrixWorkspace_sptr testWS = createTestWorkspace();
+    TS_ASSERT_THROWS_NOTHING(loader.setProperty("Workspace",testWS));
+    TS_ASSERT_THROWS_NOTHING(loader.setPropertyValue("Filename","LOQ49886.nxs"));
+    TS_ASSERT_THROWS_NOTHING(loader.setPropertyValue("LogAllowList","icp_event,proton_charge"));
+    TS_ASSERT_THROWS_NOTHING(loader.execute());
+    TS_ASSERT(loader.isExecuted());
+
+    const API::Run & run = testWS->run();
+    TS_ASSERT(run.hasProperty("icp_event"));
+    TS_ASSERT(run.hasProperty("proton_charge"));
+    TS_ASSERT(!run.hasProperty("icp_debug"));
+    TS_ASSERT(!run.hasProperty("total_counts"));
+  }
+
+  void test_LogBlockList_Skips_Named_Logs()
+  {
+    LoadNexusLogs loader;
+    loader.initialize();
+    MatrixWorkspace_sptr testWS = createTestWorkspace();
+    TS_ASSERT_THROWS_NOTHING(loader.setProperty("Workspace",testWS));
+    TS_ASSERT_THROWS_NOTHING(loader.setPropertyValue("Filename","LOQ49886.nxs"));
+    TS_ASSERT_THROWS_NOTHING(loader.setPropertyValue("LogBlockList","icp_debug,total_counts"));
+    TS_ASSERT_THROWS_NOTHING(loader.execute());
+    TS_ASSERT(loader.isExecuted());
+
+    const API::Run & run = testWS->run();
+    TS_ASSERT(run.hasProperty("icp_event"));
+    TS_ASSERT(run.hasProperty("period"));
+    TS_ASSERT(!run.hasProperty("icp_debug"));
+    TS_ASSERT(!run.hasProperty("total_counts"));
+  }
+
+  void test_Giving_Both_Lists_Fails()
+  {
+    LoadNexusLogs loader;
+    loader.initialize();
+    loader.setRethrows(true);
+    TS_ASSERT_THROWS_NOTHING(loader.setProperty("Workspace",createTestWorkspace()));
+    TS_ASSERT_THROWS_NOTHING(loader.setPropertyValue("Filename","LOQ49886.nxs"));
+    TS_ASSERT_THROWS_NOTHING(loader.setPropertyValue("LogAllowList","icp_event"));
+    TS_ASSERT_THROWS_NOTHING(loader.setPropertyValue("LogBlockList","icp_debug"));
+    TS_ASSERT_THROWS(loader.execute(), std::runtime_error);
+    TS_ASSERT(!loader.isExecuted());
+  }
+
 private:
   
   API::MatrixWorkspace_sptr createTestWorkspace()
@@ -262,6 +262,54 @@ public:
 
   }
 
+  void testNexusProcessed_Min_Max_List_SharedBins()
+  {
+    // Distinct values in every spectrum so that each loaded one can be traced back
+    Workspace2D_sptr inputWS = WorkspaceCreationHelper::Create2DWorkspaceBinned(10, 5);
+    for (size_t i = 0; i < inputWS->getNumberHistograms(); ++i)
+    {
+      for (size_t j = 0; j < inputWS->blocksize(); ++j)
+        inputWS->dataY(i)[j] = static_cast<double>(100 * i + j);
+    }
+    AnalysisDataService::Instance().addOrReplace("LoadNexusProcessed_shared", inputWS);
+
+    SaveNexusProcessed save;
+    save.initialize();
+    save.setPropertyValue("InputWorkspace", "LoadNexusProcessed_shared");
+    std::string filename = "LoadNexusProcessed_shared_tmp.nxs";
+    save.setPropertyValue("Filename", filename);
+    filename = save.getPropertyValue("Filename");
+    TS_ASSERT_THROWS_NOTHING(save.execute());
+
+    LoadNexusProcessed alg;
+    TS_ASSERT_THROWS_NOTHING(alg.initialize());
+    alg.setPropertyValue("Filename", filename);
+    alg.setPropertyValue("OutputWorkspace", output_ws);
+    alg.setPropertyValue("SpectrumMin", "2");
+    alg.setPropertyValue("SpectrumMax", "4");
+    alg.setPropertyValue("SpectrumList", "6,7");
+    TS_ASSERT_THROWS_NOTHING(alg.execute());
+    TS_ASSERT( alg.isExecuted());
+
+    MatrixWorkspace_sptr matrix_ws;
+    TS_ASSERT_THROWS_NOTHING( matrix_ws = AnalysisDataService::Instance().retrieveWS<MatrixWorkspace>(output_ws));
+    TS_ASSERT( matrix_ws );
+    if (matrix_ws)
+    {
+      TS_ASSERT_EQUALS(matrix_ws->getNumberHistograms(), 5);
+      const size_t expected[] = {1, 2, 3, 5, 6};
+      for (size_t i = 0; i < matrix_ws->getNumberHistograms(); ++i)
+      {
+        TS_ASSERT_EQUALS(matrix_ws->readY(i), inputWS->readY(expected[i]));
+        TS_ASSERT_EQUALS(matrix_ws->readX(i), inputWS->readX(expected[i]));
+      }
+    }
+
+    AnalysisDataService::Instance().remove("LoadNexusProcessed_shared");
+    if (Poco::File(filename).exists())
+      Poco::File(filename).remove();
+  }
+
   // Saving and reading masking correctly
   void testMasked()
   {
@@ -0,0 +1,87 @@
+#ifndef MANTID_DATAOBJECTS_PEAKQINDEX_H_
+#define MANTID_DATAOBJECTS_PEAKQINDEX_H_
+
+#include "MantidDataObjects/Peak.h"
+#include "MantidKernel/System.h"
+#include "MantidKernel/V3D.h"
+
+#include <vector>
+
+namespace Mantid
+{
+namespace DataObjects
+{
+
+  /** PeakQIndex : a spatial index over the positions of a list of peaks.
+
+    The positions of the peaks, in Q-lab, Q-sample or HKL, are copied into compact
+    coordinate arrays arranged as a k-d tree. The peaks inside a box, or the nearest peak
+    to a point, can then be found without looking at every peak.
+
+    The index is a snapshot of the peaks when it was built: if the peaks are added to,
+    removed or moved it must be built again.
+
+    Copyright &copy; 2014 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge National Laboratory & European Spallation Source
+
+    This file is part of Mantid.
+
+    Mantid is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 3 of the License, or
+    (at your option) any later version.
+
+    Mantid is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+    File change history is stored at: <https://github.com/mantidproject/mantid>
+    Code Documentation is available at: <http://doxygen.mantidproject.org>
+  */
+  class DLLExport PeakQIndex
+  {
+  public:
+    /// The coordinates the peaks are indexed by
+    enum Frame { QLab, QSample, HKL };
+
+    /// Build the index for the given peaks
+    PeakQIndex(const std::vector<Peak> & peaks, Frame frame = QSample);
+
+    /// The number of peaks in the index
+    size_t size() const { return m_peakIndex.size(); }
+    /// The coordinates the peaks are indexed by
+    Frame frame() const { return m_frame; }
+
+    /// Indices of the peaks inside the box, including its edges
+    std::vector<size_t> peaksInBox(const Kernel::V3D & min, const Kernel::V3D & max) const;
+    /// Whether there is any peak inside the box, including its edges
+    bool hasPeakInBox(const Kernel::V3D & min, const Kernel::V3D & max) const;
+    /// Index of the peak nearest to the given point
+    size_t nearestPeak(const Kernel::V3D & point, double * distanceSq = NULL) const;
+
+  private:
+    /// Arrange the points in [start, end) into a subtree
+    void build(std::vector<size_t> & order, const std::vector<Kernel::V3D> & positions,
+               size_t start, size_t end, size_t axis);
+    /// Find the points inside the box in the subtree [start, end)
+    bool searchBox(const double * min, const double * max, size_t start, size_t end, size_t axis,
+                   std::vector<size_t> * found) const;
+    /// Find the point nearest to the given one in the subtree [start, end)
+    void searchNearest(const double * point, size_t start, size_t end, size_t axis,
+                       size_t & best, double & bestDistanceSq) const;
+
+    /// The coordinates the peaks are indexed by
+    Frame m_frame;
+    /// The coordinates of the points, in tree order. m_coords[axis][i]
+    std::vector<double> m_coords[3];
+    /// The index into the original peaks of each point, in tree order
+    std::vector<size_t> m_peakIndex;
+  };
+
+} // namespace DataObjects
+} // namespace Mantid
+
+#endif /* MANTID_DATAOBJECTS_PEAKQINDEX_H_ */
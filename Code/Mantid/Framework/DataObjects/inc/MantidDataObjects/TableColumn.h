@@ -203,6 +203,8 @@ public:
 protected:
     /// Resize.
     void resize(size_t count){m_data.resize(count);}
+    /// Makes room for count values without resizing.
+    void reserve(size_t count){m_data.reserve(count);}
     /// Inserts default value at position index. 
     void insert(size_t index)
     {
@@ -232,6 +234,19 @@ void TableColumn<Type>::read(size_t index, const std::string & text)
 }
 
 namespace{
+  /// Comparison object to compare values paired with their indices, in the same way as CompareValues.
+  template<typename Type>
+  class CompareIndexedValues
+  {
+    const bool m_ascending;
+  public:
+    CompareIndexedValues(bool ascending):m_ascending(ascending){}
+    bool operator()(const std::pair<Type,size_t> &a, const std::pair<Type,size_t> &b)
+    {
+      return m_ascending? a.first < b.first : !(a.first < b.first || a.first == b.first);
+    }
+  };
+
   /// Comparison object to compare column values given their indices.
   template<typename Type>
   class CompareValues
@@ -262,7 +277,27 @@ void TableColumn<Type>::sortIndex( bool ascending, size_t start, size_t end, std
   auto iBegin = indexVec.begin() + start;
   auto iEnd   = indexVec.begin() + end;
 
-  std::stable_sort( iBegin, iEnd, CompareValues<Type>(*this,ascending) );
+  if ( boost::is_arithmetic<Type>::value )
+  {
+    // Sort the values together with their indices: this avoids jumping around the column
+    // on every comparison, which is slow for long columns
+    std::vector<std::pair<Type,size_t>> indexed;
+    indexed.reserve( end - start );
+    for(auto i = iBegin; i != iEnd; ++i)
+    {
+      indexed.push_back( std::make_pair(m_data[*i], *i) );
+    }
+    std::stable_sort( indexed.begin(), indexed.end(), CompareIndexedValues<Type>(ascending) );
+    auto i = iBegin;
+    for(auto it = indexed.begin(); it != indexed.end(); ++it, ++i)
+    {
+      *i = it->second;
+    }
+  }
+  else
+  {
+    std::stable_sort( iBegin, iEnd, CompareValues<Type>(*this,ascending) );
+  }
 
   bool same = false;
   size_t eqStart = 0;
@@ -7,6 +7,7 @@
 
 #include "MantidDataObjects/DllConfig.h"
 #include "MantidDataObjects/TableColumn.h"
+#include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/PropertyManager.h"
 #include "MantidAPI/ITableWorkspace.h"
 #include <boost/shared_ptr.hpp>
@@ -195,6 +196,10 @@ namespace DataObjects
 
     /// Resizes the workspace.
     void setRowCount(size_t count);
+    /// Makes room for the given total number of rows in every column without adding any.
+    void reserveRows(size_t count);
+    /// Appends a block of rows filled with default values and returns the index of the first one.
+    size_t appendRows(size_t count);
     /// Inserts a row before row pointed to by index and fills it with default vales.
     size_t insertRow(size_t index);
     /// Delets a row if it exists.
@@ -390,6 +395,8 @@ private:
     std::vector< boost::shared_ptr<API::Column> > m_columns;
     /// row count
     size_t m_rowCount;
+    /// Guards appendRows so several threads can claim blocks of rows
+    Kernel::Mutex m_appendMutex;
 
     /// shared pointer to the logManager, responsible for the workspace properties.   
     API::LogManager_sptr m_LogManager;
@@ -167,6 +167,12 @@ namespace DataObjects
       m_data.resize(count);
     }
 
+    /// Makes room for the given number of items.
+    virtual void reserve(size_t count)
+    {
+      m_data.reserve(count);
+    }
+
     /// Inserts an item.
     virtual void insert(size_t index)
     {
@@ -0,0 +1,221 @@
+#include "MantidDataObjects/PeakQIndex.h"
+#include "MantidKernel/MultiThreaded.h"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+using Mantid::Kernel::V3D;
+
+namespace Mantid
+{
+namespace DataObjects
+{
+  namespace
+  {
+    /// Orders the indices of points by one of their coordinates
+    class CompareOnAxis
+    {
+      const std::vector<V3D> & m_positions;
+      const size_t m_axis;
+    public:
+      CompareOnAxis(const std::vector<V3D> & positions, size_t axis) : m_positions(positions), m_axis(axis) {}
+      bool operator()(size_t i, size_t j) const
+      {
+        return m_positions[i][m_axis] < m_positions[j][m_axis];
+      }
+    };
+  }
+
+  //----------------------------------------------------------------------------------------------
+  /** Constructor. Copies the positions of the peaks and arranges them into a tree.
+   * @param peaks :: The peaks to index
+   * @param frame :: The coordinates to index them by
+   */
+  PeakQIndex::PeakQIndex(const std::vector<Peak> & peaks, Frame frame) : m_frame(frame), m_peakIndex()
+  {
+    const int64_t numPeaks = static_cast<int64_t>(peaks.size());
+    std::vector<V3D> positions(peaks.size());
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int64_t i = 0; i < numPeaks; ++i)
+    {
+      const Peak & peak = peaks[static_cast<size_t>(i)];
+      switch (frame)
+      {
+      case QLab: positions[static_cast<size_t>(i)] = peak.getQLabFrame(); break;
+      case QSample: positions[static_cast<size_t>(i)] = peak.getQSampleFrame(); break;
+      default: positions[static_cast<size_t>(i)] = peak.getHKL(); break;
+      }
+    }
+
+    std::vector<size_t> order(peaks.size());
+    for (size_t i = 0; i < order.size(); ++i)
+      order[i] = i;
+    build(order, positions, 0, order.size(), 0);
+
+    m_peakIndex.swap(order);
+    for (size_t axis = 0; axis < 3; ++axis)
+    {
+      m_coords[axis].resize(m_peakIndex.size());
+      for (size_t i = 0; i < m_peakIndex.size(); ++i)
+        m_coords[axis][i] = positions[m_peakIndex[i]][axis];
+    }
+  }
+
+  //----------------------------------------------------------------------------------------------
+  /**
+   * @param min :: The lowest corner of the box
+   * @param max :: The highest corner of the box
+   * @return The indices into the peaks the index was built from, in no particular order
+   */
+  std::vector<size_t> PeakQIndex::peaksInBox(const V3D & min, const V3D & max) const
+  {
+    const double lower[3] = {min.X(), min.Y(), min.Z()};
+    const double upper[3] = {max.X(), max.Y(), max.Z()};
+    std::vector<size_t> found;
+    searchBox(lower, upper, 0, size(), 0, &found);
+    return found;
+  }
+
+  /**
+   * @param min :: The lowest corner of the box
+   * @param max :: The highest corner of the box
+   * @return True as soon as one peak is found in the box
+   */
+  bool PeakQIndex::hasPeakInBox(const V3D & min, const V3D & max) const
+  {
+    const double lower[3] = {min.X(), min.Y(), min.Z()};
+    const double upper[3] = {max.X(), max.Y(), max.Z()};
+    return searchBox(lower, upper, 0, size(), 0, NULL);
+  }
+
+  /**
+   * @param point :: A point in the coordinates of the index
+   * @param distanceSq :: [Out] If given, set to the squared distance to the nearest peak
+   * @return The index into the peaks the index was built from of the nearest one
+   * @throws std::runtime_error if there are no peaks
+   */
+  size_t PeakQIndex::nearestPeak(const V3D & point, double * distanceSq) const
+  {
+    if (m_peakIndex.empty())
+      throw std::runtime_error("PeakQIndex::nearestPeak() - there are no peaks");
+    const double coords[3] = {point.X(), point.Y(), point.Z()};
+    size_t best = 0;
+    double bestDistanceSq = std::numeric_limits<double>::max();
+    searchNearest(coords, 0, size(), 0, best, bestDistanceSq);
+    if (distanceSq)
+      *distanceSq = bestDistanceSq;
+    return m_peakIndex[best];
+  }
+
+  //----------------------------------------------------------------------------------------------
+  /** The middle point of each range splits the rest on one axis: the points before it are not
+   * above it on that axis and those after it are not below it. The axis cycles with depth.
+   * @param order :: The indices of the points, rearranged into tree order
+   * @param positions :: The positions of the points
+   * @param start :: The first point of the subtree
+   * @param end :: One past the last point of the subtree
+   * @param axis :: The axis the subtree is split on
+   */
+  void PeakQIndex::build(std::vector<size_t> & order, const std::vector<V3D> & positions,
+                         size_t start, size_t end, size_t axis)
+  {
+    if (end - start < 2)
+      return;
+    const size_t mid = start + (end - start) / 2;
+    std::nth_element(order.begin() + start, order.begin() + mid, order.begin() + end,
+                     CompareOnAxis(positions, axis));
+    const size_t nextAxis = (axis + 1) % 3;
+    build(order, positions, start, mid, nextAxis);
+    build(order, positions, mid + 1, end, nextAxis);
+  }
+
+  /**
+   * @param min :: The lowest corner of the box
+   * @param max :: The highest corner of the box
+   * @param start :: The first point of the subtree
+   * @param end :: One past the last point of the subtree
+   * @param axis :: The axis the subtree is split on
+   * @param found :: [Out] The indices of the peaks found are added to this. If NULL the search
+   *                 stops at the first point found.
+   * @return True if a point was found when only looking for one
+   */
+  bool PeakQIndex::searchBox(const double * min, const double * max, size_t start, size_t end, size_t axis,
+                             std::vector<size_t> * found) const
+  {
+    if (start >= end)
+      return false;
+    const size_t mid = start + (end - start) / 2;
+    const double split = m_coords[axis][mid];
+
+    bool inside = true;
+    for (size_t i = 0; i < 3; ++i)
+    {
+      const double value = m_coords[i][mid];
+      if (value < min[i] || value > max[i])
+      {
+        inside = false;
+        break;
+      }
+    }
+    if (inside)
+    {
+      if (!found)
+        return true;
+      found->push_back(m_peakIndex[mid]);
+    }
+
+    const size_t nextAxis = (axis + 1) % 3;
+    if (min[axis] <= split && searchBox(min, max, start, mid, nextAxis, found))
+      return true;
+    if (split <= max[axis] && searchBox(min, max, mid + 1, end, nextAxis, found))
+      return true;
+    return false;
+  }
+
+  /**
+   * @param point :: The point to search around
+   * @param start :: The first point of the subtree
+   * @param end :: One past the last point of the subtree
+   * @param axis :: The axis the subtree is split on
+   * @param best :: [In/Out] The tree position of the nearest point so far
+   * @param bestDistanceSq :: [In/Out] The squared distance to the nearest point so far
+   */
+  void PeakQIndex::searchNearest(const double * point, size_t start, size_t end, size_t axis,
+                                 size_t & best, double & bestDistanceSq) const
+  {
+    if (start >= end)
+      return;
+    const size_t mid = start + (end - start) / 2;
+
+    double distanceSq = 0.0;
+    for (size_t i = 0; i < 3; ++i)
+    {
+      const double delta = m_coords[i][mid] - point[i];
+      distanceSq += delta * delta;
+    }
+    if (distanceSq < bestDistanceSq)
+    {
+      bestDistanceSq = distanceSq;
+      best = mid;
+    }
+
+    // Look on the side of the split the point is on first, then the other side if it could be closer
+    const double offset = point[axis] - m_coords[axis][mid];
+    const size_t nextAxis = (axis + 1) % 3;
+    if (offset < 0)
+    {
+      searchNearest(point, start, mid, nextAxis, best, bestDistanceSq);
+      if (offset * offset < bestDistanceSq)
+        searchNearest(point, mid + 1, end, nextAxis, best, bestDistanceSq);
+    }
+    else
+    {
+      searchNearest(point, mid + 1, end, nextAxis, best, bestDistanceSq);
+      if (offset * offset < bestDistanceSq)
+        searchNearest(point, start, mid, nextAxis, best, bestDistanceSq);
+    }
+  }
+
+} // namespace DataObjects
+} // namespace Mantid
@@ -3,6 +3,7 @@
 #include "MantidAPI/ColumnFactory.h"
 #include "MantidAPI/WorkspaceProperty.h"
 #include "MantidAPI/WorkspaceFactory.h"
+#include "MantidKernel/MultiThreaded.h"
 
 #include <iostream>
 #include <queue>
@@ -31,7 +32,7 @@ namespace Mantid
 
 
     /// Constructor
-    TableWorkspace::TableWorkspace(size_t nrows) : ITableWorkspace(), m_rowCount(0),
+    TableWorkspace::TableWorkspace(size_t nrows) : ITableWorkspace(), m_rowCount(0), m_appendMutex(),
     m_LogManager(new API::LogManager)
     {
       setRowCount(nrows);
@@ -106,6 +107,32 @@ namespace Mantid
         m_rowCount = count;
     }
 
+    /** Make room for rows so that they can be added later without any column reallocating.
+     *  Columns added afterwards are not affected.
+     *  @param count :: The total number of rows to make room for.
+     */
+    void TableWorkspace::reserveRows(size_t count)
+    {
+        for(column_it ci=m_columns.begin();ci!=m_columns.end();ci++)
+            reserveInColumn(ci->get(),count);
+    }
+
+    /** Append a block of rows in one go. Only calls to appendRows are serialised against each other,
+     *  so several threads may use it to claim separate blocks and then fill their own rows through
+     *  getColVector, provided that enough rows have been reserved with reserveRows beforehand so that
+     *  no column is reallocated while others are filled. rowCount, insertRow, removeRow and
+     *  setRowCount are not locked and must not be called while rows are being claimed.
+     *  @param count :: The number of rows to add.
+     *  @return The index of the first new row.
+     */
+    size_t TableWorkspace::appendRows(size_t count)
+    {
+        Kernel::Mutex::ScopedLock lock(m_appendMutex);
+        const size_t first = rowCount();
+        setRowCount(first + count);
+        return first;
+    }
+
     /// Gets the shared pointer to a column.
     API::Column_sptr TableWorkspace::getColumn(const std::string& name)
     {
@@ -303,11 +330,28 @@ namespace Mantid
 
       }
 
-      // finally sort the rows
-      const size_t nCols = columnCount();
-      for( size_t i = 0; i < nCols; ++i)
+      // finally sort the rows, the columns are independent of each other.
+      // Exceptions must not escape the parallel region so the first one is kept and rethrown.
+      const int64_t nCols = static_cast<int64_t>(columnCount());
+      std::string error;
+      PARALLEL_FOR_NO_WSP_CHECK()
+      for( int64_t i = 0; i < nCols; ++i)
+      {
+        try
+        {
+          m_columns[static_cast<size_t>(i)]->sortValues( indexVec );
+        }
+        catch(std::exception & ex)
+        {
+          PARALLEL_CRITICAL(TableWorkspace_sort)
+          {
+            if ( error.empty() ) error = ex.what();
+          }
+        }
+      }
+      if ( !error.empty() )
       {
-        getColumn( i )->sortValues( indexVec );
+        throw std::runtime_error( error );
       }
 
     }
@@ -0,0 +1,115 @@
+#ifndef MANTID_DATAOBJECTS_PEAKQINDEXTEST_H_
+#define MANTID_DATAOBJECTS_PEAKQINDEXTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidDataObjects/PeakQIndex.h"
+#include "MantidTestHelpers/ComponentCreationHelper.h"
+
+#include <algorithm>
+#include <limits>
+
+using namespace Mantid::DataObjects;
+using namespace Mantid::Geometry;
+using namespace Mantid::Kernel;
+
+class PeakQIndexTest : public CxxTest::TestSuite
+{
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static PeakQIndexTest *createSuite() { return new PeakQIndexTest(); }
+  static void destroySuite( PeakQIndexTest *suite ) { delete suite; }
+
+  PeakQIndexTest()
+  {
+    m_inst = ComponentCreationHelper::createTestInstrumentRectangular(5, 100);
+    // A scattered set of HKLs, with some repeated so that points share coordinates
+    for (int i = 0; i < 200; ++i)
+    {
+      V3D hkl(static_cast<double>((i * 7) % 13), static_cast<double>((i * 11) % 17) - 8.0,
+              static_cast<double>((i * 5) % 9) * 0.5);
+      m_peaks.push_back(Peak(m_inst, 10000 + (i % 50), 2.0, hkl));
+    }
+  }
+
+  void test_Empty_Index()
+  {
+    PeakQIndex index(std::vector<Peak>(), PeakQIndex::HKL);
+    TS_ASSERT_EQUALS(index.size(), 0);
+    TS_ASSERT(index.peaksInBox(V3D(-1,-1,-1), V3D(1,1,1)).empty());
+    TS_ASSERT(!index.hasPeakInBox(V3D(-1,-1,-1), V3D(1,1,1)));
+    TS_ASSERT_THROWS(index.nearestPeak(V3D()), std::runtime_error);
+  }
+
+  void test_Default_Frame_Is_QSample()
+  {
+    PeakQIndex index(m_peaks);
+    TS_ASSERT_EQUALS(index.frame(), PeakQIndex::QSample);
+    TS_ASSERT_EQUALS(index.size(), m_peaks.size());
+
+    const V3D q = m_peaks[3].getQSampleFrame();
+    double distanceSq(-1.0);
+    size_t nearest = index.nearestPeak(q, &distanceSq);
+    TS_ASSERT_DELTA(distanceSq, 0.0, 1e-12);
+    TS_ASSERT_DELTA((m_peaks[nearest].getQSampleFrame() - q).norm(), 0.0, 1e-9);
+  }
+
+  void test_peaksInBox_Matches_Linear_Search()
+  {
+    PeakQIndex index(m_peaks, PeakQIndex::HKL);
+    checkBox(index, V3D(2, -3, 0.5), V3D(6, 2, 2.5));
+    checkBox(index, V3D(0, -8, 0), V3D(12, 8, 4));
+    checkBox(index, V3D(3, 3, 3), V3D(3, 3, 3));
+    checkBox(index, V3D(100, 100, 100), V3D(101, 101, 101));
+  }
+
+  void test_Box_Edges_Are_Included()
+  {
+    PeakQIndex index(m_peaks, PeakQIndex::HKL);
+    const V3D hkl = m_peaks[10].getHKL();
+    TS_ASSERT(index.hasPeakInBox(hkl, hkl));
+    std::vector<size_t> found = index.peaksInBox(hkl, hkl);
+    TS_ASSERT(std::find(found.begin(), found.end(), size_t(10)) != found.end());
+  }
+
+  void test_nearestPeak_Matches_Linear_Search()
+  {
+    PeakQIndex index(m_peaks, PeakQIndex::HKL);
+    const V3D points[] = {V3D(0.3, -7.6, 1.1), V3D(5.5, 0.5, 2.2), V3D(20, 20, 20), V3D(-4, 3, -1)};
+    for (size_t i = 0; i < sizeof(points) / sizeof(points[0]); ++i)
+    {
+      double expected = std::numeric_limits<double>::max();
+      for (size_t j = 0; j < m_peaks.size(); ++j)
+        expected = std::min(expected, (m_peaks[j].getHKL() - points[i]).norm2());
+
+      double distanceSq(-1.0);
+      size_t nearest = index.nearestPeak(points[i], &distanceSq);
+      TS_ASSERT_DELTA(distanceSq, expected, 1e-12);
+      TS_ASSERT_DELTA((m_peaks[nearest].getHKL() - points[i]).norm2(), expected, 1e-12);
+    }
+  }
+
+private:
+  void checkBox(const PeakQIndex & index, const V3D & min, const V3D & max)
+  {
+    std::vector<size_t> expected;
+    for (size_t i = 0; i < m_peaks.size(); ++i)
+    {
+      const V3D hkl = m_peaks[i].getHKL();
+      if (hkl.X() >= min.X() && hkl.X() <= max.X() && hkl.Y() >= min.Y() && hkl.Y() <= max.Y()
+          && hkl.Z() >= min.Z() && hkl.Z() <= max.Z())
+        expected.push_back(i);
+    }
+    std::vector<size_t> found = index.peaksInBox(min, max);
+    std::sort(found.begin(), found.end());
+    TS_ASSERT_EQUALS(found, expected);
+    TS_ASSERT_EQUALS(index.hasPeakInBox(min, max), !expected.empty());
+  }
+
+  Instrument_sptr m_inst;
+  std::vector<Peak> m_peaks;
+};
+
+
+#endif /* MANTID_DATAOBJECTS_PEAKQINDEXTEST_H_ */
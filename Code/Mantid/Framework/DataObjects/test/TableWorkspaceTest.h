@@ -11,6 +11,7 @@
 #include "MantidAPI/TableRow.h" 
 #include "MantidAPI/ColumnFactory.h" 
 #include "MantidAPI/WorkspaceProperty.h"
+#include "MantidKernel/MultiThreaded.h"
 
 #include <limits>
 
@@ -618,6 +619,113 @@ public:
 
   }
 
+  void test_appendRows()
+  {
+    TableWorkspace ws(2);
+    ws.addColumn("int","col1");
+    ws.addColumn("str","col2");
+    ws.reserveRows(10);
+
+    TS_ASSERT_EQUALS( ws.appendRows(3), 2 );
+    TS_ASSERT_EQUALS( ws.appendRows(5), 5 );
+    TS_ASSERT_EQUALS( ws.rowCount(), 10 );
+    TS_ASSERT_EQUALS( ws.getColumn("col1")->size(), 10 );
+    TS_ASSERT_EQUALS( ws.getColumn("col2")->size(), 10 );
+
+    auto &data1 = ws.getColVector<int>("col1");
+    TS_ASSERT( data1.capacity() >= 10 );
+    for(size_t i = 2; i < data1.size(); ++i)
+    {
+      TS_ASSERT_EQUALS( data1[i], 0 );
+    }
+  }
+
+  void test_appendRows_from_several_threads()
+  {
+    const int64_t nBlocks = 100;
+    const size_t blockSize = 7;
+    TableWorkspace ws;
+    ws.addColumn("int","block");
+    ws.addColumn("int","item");
+    ws.reserveRows(nBlocks * blockSize);
+    auto &blockCol = ws.getColVector<int>("block");
+    auto &itemCol = ws.getColVector<int>("item");
+    const int *start = blockCol.data();
+
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for(int64_t block = 0; block < nBlocks; ++block)
+    {
+      const size_t first = ws.appendRows(blockSize);
+      for(size_t i = 0; i < blockSize; ++i)
+      {
+        blockCol[first + i] = static_cast<int>(block);
+        itemCol[first + i] = static_cast<int>(i);
+      }
+    }
+
+    TS_ASSERT_EQUALS( ws.rowCount(), nBlocks * blockSize );
+    TS_ASSERT_EQUALS( blockCol.data(), start );
+    // every block was claimed whole and exactly once
+    std::vector<size_t> seen(nBlocks, 0);
+    for(size_t row = 0; row < ws.rowCount(); row += blockSize)
+    {
+      const int block = blockCol[row];
+      TS_ASSERT( block >= 0 && block < nBlocks );
+      if ( block < 0 || block >= nBlocks ) break;
+      ++seen[block];
+      for(size_t i = 0; i < blockSize; ++i)
+      {
+        TS_ASSERT_EQUALS( blockCol[row + i], block );
+        TS_ASSERT_EQUALS( itemCol[row + i], static_cast<int>(i) );
+      }
+    }
+    TS_ASSERT_EQUALS( std::count(seen.begin(), seen.end(), 1), nBlocks );
+  }
+
+  void test_sort_throws_for_column_that_cannot_be_sorted()
+  {
+    TableWorkspace ws(3);
+    ws.addColumn("int","col1");
+    ws.addColumn("vector_int","col2");
+    ws.addColumn("double","col3");
+    auto &data1 = ws.getColVector<int>("col1");
+    data1[0] = 3; data1[1] = 1; data1[2] = 2;
+
+    std::vector<std::pair<std::string, bool>> criteria(1, std::make_pair("col1",true));
+    TS_ASSERT_THROWS( ws.sort(criteria), std::runtime_error );
+  }
+
+  void test_sort_many_rows_with_ties()
+  {
+    const size_t nRows = 1000;
+    TableWorkspace ws(nRows);
+    ws.addColumn("double","col1");
+    ws.addColumn("int","col2");
+    auto &data1 = ws.getColVector<double>("col1");
+    auto &data2 = ws.getColVector<int>("col2");
+    for(size_t i = 0; i < nRows; ++i)
+    {
+      data1[i] = static_cast<double>( (i * 7) % 10 );
+      data2[i] = static_cast<int>(i);
+    }
+
+    std::vector<std::pair<std::string, bool>> criteria(2);
+    criteria[0] = std::make_pair("col1",false);
+    criteria[1] = std::make_pair("col2",true);
+    TS_ASSERT_THROWS_NOTHING( ws.sort(criteria) );
+
+    for(size_t i = 1; i < nRows; ++i)
+    {
+      TS_ASSERT( data1[i-1] >= data1[i] );
+      if ( data1[i-1] == data1[i] )
+      {
+        TS_ASSERT( data2[i-1] < data2[i] );
+      }
+    }
+    TS_ASSERT_EQUALS( data1[0], 9.0 );
+    TS_ASSERT_EQUALS( data1[nRows-1], 0.0 );
+  }
+
 };
 
 
@@ -0,0 +1,105 @@
+#ifndef MANTID_KERNEL_FFTPLANCACHE_H_
+#define MANTID_KERNEL_FFTPLANCACHE_H_
+
+//----------------------------------------------------------------------
+// Includes
+//----------------------------------------------------------------------
+#include "MantidKernel/DllConfig.h"
+#include "MantidKernel/MultiThreaded.h"
+#include "MantidKernel/SingletonHolder.h"
+
+#ifndef Q_MOC_RUN
+# include <boost/shared_ptr.hpp>
+#endif
+
+#include <gsl/gsl_fft_complex.h>
+#include <gsl/gsl_fft_halfcomplex.h>
+#include <gsl/gsl_fft_real.h>
+
+#include <map>
+
+namespace Mantid
+{
+  namespace Kernel
+  {
+    /**
+    Keeps the GSL FFT wavetables (the trigonometric tables and the factorisation
+    of the transform length) so that they are computed once per length and type
+    instead of once per transform.
+
+    A wavetable is read-only once created and can be used by several threads at
+    the same time. The scratch workspaces passed to the GSL transforms are not
+    cached as each thread needs its own.
+
+    Copyright &copy; 2014 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge National Laboratory & European Spallation Source
+
+    This file is part of Mantid.
+
+    Mantid is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 3 of the License, or
+    (at your option) any later version.
+
+    Mantid is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+    File change history is stored at: <https://github.com/mantidproject/mantid>.
+    Code Documentation is available at: <http://doxygen.mantidproject.org>
+    */
+    class MANTID_KERNEL_DLL FFTPlanCacheImpl
+    {
+    public:
+      typedef boost::shared_ptr<const gsl_fft_real_wavetable> RealWavetable_const_sptr;
+      typedef boost::shared_ptr<const gsl_fft_halfcomplex_wavetable> HalfComplexWavetable_const_sptr;
+      typedef boost::shared_ptr<const gsl_fft_complex_wavetable> ComplexWavetable_const_sptr;
+
+      /// Wavetable for the forward transform of real data of length n
+      RealWavetable_const_sptr realWavetable(const size_t n);
+      /// Wavetable for the inverse transform of half-complex data of length n
+      HalfComplexWavetable_const_sptr halfComplexWavetable(const size_t n);
+      /// Wavetable for the transforms of complex data of length n
+      ComplexWavetable_const_sptr complexWavetable(const size_t n);
+
+      /// Number of cached wavetables of all types
+      size_t size() const;
+      /// Remove all the cached wavetables
+      void clear();
+
+    private:
+      friend struct Mantid::Kernel::CreateUsingNew<FFTPlanCacheImpl>;
+
+      /// Private Constructor
+      FFTPlanCacheImpl();
+      /// Private copy constructor - NO COPY ALLOWED
+      FFTPlanCacheImpl(const FFTPlanCacheImpl&);
+      /// Private assignment operator - NO ASSIGNMENT ALLOWED
+      FFTPlanCacheImpl& operator = (const FFTPlanCacheImpl&);
+      /// Private Destructor
+      virtual ~FFTPlanCacheImpl();
+
+      /// Cached real wavetables keyed by length
+      std::map<size_t, RealWavetable_const_sptr> m_real;
+      /// Cached half-complex wavetables keyed by length
+      std::map<size_t, HalfComplexWavetable_const_sptr> m_halfComplex;
+      /// Cached complex wavetables keyed by length
+      std::map<size_t, ComplexWavetable_const_sptr> m_complex;
+      /// Guards the maps
+      mutable Mutex m_mutex;
+    };
+
+    ///Forward declaration of a specialisation of SingletonHolder for FFTPlanCacheImpl (needed for dllexport/dllimport) and a typedef for it.
+#if defined(__APPLE__) && defined(__INTEL_COMPILER)
+    inline
+#endif
+      template class MANTID_KERNEL_DLL Mantid::Kernel::SingletonHolder<FFTPlanCacheImpl>;
+    typedef MANTID_KERNEL_DLL Mantid::Kernel::SingletonHolder<FFTPlanCacheImpl> FFTPlanCache;
+
+  } // namespace Kernel
+} // namespace Mantid
+
+#endif //MANTID_KERNEL_FFTPLANCACHE_H_
@@ -23,6 +23,8 @@ namespace Mantid
         Defines a wrapper around a file whose internal structure can be accessed using the NeXus API
 
         On construction the simple details about the layout of the file are cached for faster querying later.
+        Queries about given paths only list the groups on the way to them; the whole tree is only walked
+        when a query needs it, e.g. classTypeExists.
 
         Copyright &copy; 2013 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge National Laboratory & European Spallation Source
 
@@ -102,9 +104,17 @@ namespace Mantid
 
       /// Initialize object with filename
       void initialize(const std::string& filename);
+      /// Walk the whole tree and cache the structure, if not done already
+      void walkFileIfRequired() const;
       /// Walk the tree and cache the structure
       void walkFile(::NeXus::File & file, const std::string & rootPath, const std::string & className,
-                    std::map<std::string, std::string> & pmap, int level);
+                    std::map<std::string, std::string> & pmap) const;
+      /// Return the type of a path by listing its parent group only
+      std::string pathType(const std::string & path) const;
+      /// Return the entries of a group, listing it if not done already
+      const std::map<std::string, std::string> & groupEntries(const std::string & groupPath) const;
+      /// Leave the file at the root, as after initialization
+      void resetToRoot() const;
 
       /// Full filename
       std::string m_filename;
@@ -115,7 +125,11 @@ namespace Mantid
       /// Root attributes
       std::set<std::string> m_rootAttrs;
       /// Map of full path strings to types. Can check if path exists quickly
-      std::map<std::string, std::string> m_pathsToTypes;
+      mutable std::map<std::string, std::string> m_pathsToTypes;
+      /// True once the whole tree has been walked into m_pathsToTypes
+      mutable bool m_walked;
+      /// Entries (name to type) of the groups listed so far, keyed by group path
+      mutable std::map<std::string, std::map<std::string, std::string> > m_groupEntries;
 
       /// Open NeXus handle
       ::NeXus::File *m_file;
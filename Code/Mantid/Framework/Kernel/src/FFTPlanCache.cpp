@@ -0,0 +1,113 @@
+//----------------------------------------------------------------------
+// Includes
+//----------------------------------------------------------------------
+#include "MantidKernel/FFTPlanCache.h"
+
+#include <stdexcept>
+
+namespace Mantid
+{
+  namespace Kernel
+  {
+    namespace
+    {
+      /// Maximum number of wavetables of one type kept in the cache
+      const size_t MAX_CACHED_WAVETABLES = 64;
+
+      /**
+       * Find a wavetable in a cache or create and add it.
+       * @param cache :: The cache to look in
+       * @param n :: The transform length
+       * @param alloc :: GSL function allocating the wavetable
+       * @param free :: GSL function freeing the wavetable
+       * @return The wavetable for length n
+       */
+      template<typename Wavetable>
+      boost::shared_ptr<const Wavetable> findOrCreate(std::map<size_t, boost::shared_ptr<const Wavetable> >& cache,
+                                                      const size_t n, Wavetable* (*alloc)(size_t),
+                                                      void (*free)(Wavetable*))
+      {
+        auto it = cache.find(n);
+        if (it != cache.end())
+        {
+          return it->second;
+        }
+        if (n == 0)
+        {
+          throw std::invalid_argument("FFT length must be positive");
+        }
+        Wavetable* wavetable = alloc(n);
+        if (!wavetable)
+        {
+          throw std::runtime_error("Failed to allocate FFT wavetable");
+        }
+        // Wavetables still used by a caller stay valid after they are dropped from the cache
+        if (cache.size() >= MAX_CACHED_WAVETABLES)
+        {
+          cache.clear();
+        }
+        boost::shared_ptr<const Wavetable> result(wavetable, free);
+        cache[n] = result;
+        return result;
+      }
+    }
+
+    /// Constructor
+    FFTPlanCacheImpl::FFTPlanCacheImpl() : m_real(), m_halfComplex(), m_complex(), m_mutex()
+    {
+    }
+
+    /// Destructor
+    FFTPlanCacheImpl::~FFTPlanCacheImpl()
+    {
+    }
+
+    /**
+     * @param n :: The length of the real data
+     * @return A wavetable to pass to gsl_fft_real_transform
+     */
+    FFTPlanCacheImpl::RealWavetable_const_sptr FFTPlanCacheImpl::realWavetable(const size_t n)
+    {
+      Mutex::ScopedLock lock(m_mutex);
+      return findOrCreate(m_real, n, gsl_fft_real_wavetable_alloc, gsl_fft_real_wavetable_free);
+    }
+
+    /**
+     * @param n :: The length of the (unpacked) real data
+     * @return A wavetable to pass to gsl_fft_halfcomplex_inverse or gsl_fft_halfcomplex_transform
+     */
+    FFTPlanCacheImpl::HalfComplexWavetable_const_sptr FFTPlanCacheImpl::halfComplexWavetable(const size_t n)
+    {
+      Mutex::ScopedLock lock(m_mutex);
+      return findOrCreate(m_halfComplex, n, gsl_fft_halfcomplex_wavetable_alloc, gsl_fft_halfcomplex_wavetable_free);
+    }
+
+    /**
+     * @param n :: The number of complex values
+     * @return A wavetable to pass to gsl_fft_complex_forward or gsl_fft_complex_inverse
+     */
+    FFTPlanCacheImpl::ComplexWavetable_const_sptr FFTPlanCacheImpl::complexWavetable(const size_t n)
+    {
+      Mutex::ScopedLock lock(m_mutex);
+      return findOrCreate(m_complex, n, gsl_fft_complex_wavetable_alloc, gsl_fft_complex_wavetable_free);
+    }
+
+    /**
+     * @return The number of wavetables in the cache
+     */
+    size_t FFTPlanCacheImpl::size() const
+    {
+      Mutex::ScopedLock lock(m_mutex);
+      return m_real.size() + m_halfComplex.size() + m_complex.size();
+    }
+
+    void FFTPlanCacheImpl::clear()
+    {
+      Mutex::ScopedLock lock(m_mutex);
+      m_real.clear();
+      m_halfComplex.clear();
+      m_complex.clear();
+    }
+
+  } // namespace Kernel
+} // namespace Mantid
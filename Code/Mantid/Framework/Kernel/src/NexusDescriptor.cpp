@@ -99,7 +99,7 @@ namespace Mantid
      */
     NexusDescriptor::NexusDescriptor(const std::string & filename)
       : m_filename(), m_extension(), m_firstEntryNameType(),
-        m_rootAttrs(), m_pathsToTypes(), m_file(NULL)
+        m_rootAttrs(), m_pathsToTypes(), m_walked(false), m_groupEntries(), m_file(NULL)
     {
       if(filename.empty())
       {
@@ -147,7 +147,8 @@ namespace Mantid
      */
     bool NexusDescriptor::pathExists(const std::string& path) const
     {
-      return (m_pathsToTypes.find(path) != m_pathsToTypes.end());
+      if(m_walked) return (m_pathsToTypes.find(path) != m_pathsToTypes.end());
+      return !pathType(path).empty();
     }
 
     /**
@@ -157,6 +158,7 @@ namespace Mantid
      */
     bool NexusDescriptor::pathOfTypeExists(const std::string& path, const std::string & type) const
     {
+      if(!m_walked) return (pathType(path) == type);
       auto it = m_pathsToTypes.find(path);
       if(it != m_pathsToTypes.end())
       {
@@ -171,6 +173,7 @@ namespace Mantid
      */
     std::string NexusDescriptor::pathOfType(const std::string & type) const
     {
+      walkFileIfRequired();
       auto iend = m_pathsToTypes.end();
       for (auto it = m_pathsToTypes.begin(); it != iend; ++it)
       {
@@ -187,6 +190,7 @@ namespace Mantid
      */
     bool NexusDescriptor::classTypeExists(const std::string & classType) const
     {
+      walkFileIfRequired();
       auto iend = m_pathsToTypes.end();
       for(auto it = m_pathsToTypes.begin(); it != iend; ++it)
       {
@@ -200,7 +204,7 @@ namespace Mantid
     //---------------------------------------------------------------------------------------------------------------------------
 
     /**
-     * Creates the internal cached structure of the file as a tree of nodes
+     * Opens the file and caches the root attributes and entries
      */
     void NexusDescriptor::initialize(const std::string& filename)
     {
@@ -212,7 +216,34 @@ namespace Mantid
       m_file->openPath("/");
       m_rootAttrs.clear();
       m_pathsToTypes.clear();
-      walkFile(*m_file, "", "", m_pathsToTypes,0);
+      m_groupEntries.clear();
+      m_walked = false;
+
+      auto attrInfos = m_file->getAttrInfos();
+      for(size_t i = 0; i < attrInfos.size(); ++i)
+      {
+        m_rootAttrs.insert(attrInfos[i].name);
+      }
+      auto & rootEntries = m_groupEntries[""];
+      rootEntries = m_file->getEntries();
+      for(auto it = rootEntries.begin(); it != rootEntries.end(); ++it)
+      {
+        // the last group listed is the one reported, as it always has been
+        if(it->second != "SDS" && it->second != "CDF0.0") m_firstEntryNameType = (*it);
+      }
+      m_file->closeGroup();
+    }
+
+    /**
+     * Walk the whole file and cache the type of every path. Only done once.
+     */
+    void NexusDescriptor::walkFileIfRequired() const
+    {
+      if(m_walked) return;
+      m_file->openPath("/");
+      m_pathsToTypes.clear();
+      walkFile(*m_file, "", "", m_pathsToTypes);
+      m_walked = true;
     }
 
     /**
@@ -221,23 +252,14 @@ namespace Mantid
      * @param rootPath The current path that is open in the file
      * @param className The class of the current open path
      * @param pmap [Out] An output map filled with mappings of path->type
-     * @param level An integer defining the current level in the file
      */
     void NexusDescriptor::walkFile(::NeXus::File & file,const std::string & rootPath, const std::string & className,
-                                 std::map<std::string, std::string> & pmap, int level)
+                                 std::map<std::string, std::string> & pmap) const
     {
       if (!rootPath.empty())
       {
         pmap.insert(std::make_pair(rootPath, className));
       }
-      if(level == 0)
-      {
-        auto attrInfos = file.getAttrInfos();
-        for(size_t i = 0; i < attrInfos.size(); ++i)
-        {
-          m_rootAttrs.insert(attrInfos[i].name);
-        }
-      }
 
       auto dirents = file.getEntries();
       auto itend = dirents.end();
@@ -248,7 +270,6 @@ namespace Mantid
         const std::string entryPath = rootPath + "/" + entryName;
         if(entryClass == "SDS")
         {
-          //tmap.insert(std::make_pair(entryClass, entryPath));
           pmap.insert(std::make_pair(entryPath, entryClass));
         }
         else if(entryClass == "CDF0.0")
@@ -257,15 +278,67 @@ namespace Mantid
         }
         else
         {
-          if(level == 0) m_firstEntryNameType = (*it); //copy first entry name & type
           file.openGroup(entryName, entryClass);
-          walkFile(file, entryPath, entryClass, pmap,level+1);
+          walkFile(file, entryPath, entryClass, pmap);
         }
       }
       file.closeGroup();
     }
 
+    /**
+     * Find the type of a path without walking the whole file: only the parent group is listed.
+     * @param path A string giving a path using UNIX-style path separators (/), e.g. /raw_data_1, /entry/bank1
+     * @return The type of the path, e.g. NXentry or SDS, or an empty string if it does not exist
+     */
+    std::string NexusDescriptor::pathType(const std::string & path) const
+    {
+      if(path.size() < 2 || path[0] != '/') return "";
+      const size_t sep = path.rfind('/');
+      const std::string name = path.substr(sep + 1);
+      if(name.empty()) return "";
 
+      const auto & entries = groupEntries(path.substr(0, sep));
+      auto it = entries.find(name);
+      if(it == entries.end() || it->second == "CDF0.0") return "";
+      return it->second;
+    }
+
+    /**
+     * @param groupPath The path of a group, empty for the root
+     * @return The entries of the group mapped to their type, empty if the group does not exist
+     */
+    const std::map<std::string, std::string> & NexusDescriptor::groupEntries(const std::string & groupPath) const
+    {
+      auto cached = m_groupEntries.find(groupPath);
+      if(cached != m_groupEntries.end()) return cached->second;
+
+      auto & entries = m_groupEntries[groupPath];
+      // Check the parent group lists this one as a group first, as opening a missing path is slow in HDF
+      const std::string parentType = pathType(groupPath);
+      if(!parentType.empty() && parentType != "SDS")
+      {
+        try
+        {
+          m_file->openPath(groupPath);
+          entries = m_file->getEntries();
+        }
+        catch(::NeXus::Exception &)
+        {
+          entries.clear();
+        }
+        resetToRoot();
+      }
+      return entries;
+    }
+
+    /**
+     * Leave the file in the state it is after initialization
+     */
+    void NexusDescriptor::resetToRoot() const
+    {
+      m_file->openPath("/");
+      m_file->closeGroup();
+    }
 
   } // namespace Kernel
 } // namespace Mantid
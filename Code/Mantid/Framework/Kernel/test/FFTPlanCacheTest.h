@@ -0,0 +1,84 @@
+#ifndef MANTID_KERNEL_FFTPLANCACHETEST_H_
+#define MANTID_KERNEL_FFTPLANCACHETEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidKernel/FFTPlanCache.h"
+
+#include <cmath>
+#include <vector>
+
+using namespace Mantid::Kernel;
+
+class FFTPlanCacheTest : public CxxTest::TestSuite
+{
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static FFTPlanCacheTest *createSuite() { return new FFTPlanCacheTest(); }
+  static void destroySuite( FFTPlanCacheTest *suite ) { delete suite; }
+
+  void setUp()
+  {
+    FFTPlanCache::Instance().clear();
+  }
+
+  void test_same_length_returns_same_wavetable()
+  {
+    auto w1 = FFTPlanCache::Instance().realWavetable(100);
+    auto w2 = FFTPlanCache::Instance().realWavetable(100);
+    TS_ASSERT(w1);
+    TS_ASSERT_EQUALS(w1.get(), w2.get());
+    TS_ASSERT_EQUALS(w1->n, 100);
+    TS_ASSERT_EQUALS(FFTPlanCache::Instance().size(), 1);
+  }
+
+  void test_different_lengths_and_types_are_cached_separately()
+  {
+    auto real = FFTPlanCache::Instance().realWavetable(64);
+    auto other = FFTPlanCache::Instance().realWavetable(65);
+    auto halfComplex = FFTPlanCache::Instance().halfComplexWavetable(64);
+    auto complex = FFTPlanCache::Instance().complexWavetable(64);
+    TS_ASSERT_DIFFERS(real.get(), other.get());
+    TS_ASSERT_EQUALS(other->n, 65);
+    TS_ASSERT_EQUALS(halfComplex->n, 64);
+    TS_ASSERT_EQUALS(complex->n, 64);
+    TS_ASSERT_EQUALS(FFTPlanCache::Instance().size(), 4);
+  }
+
+  void test_zero_length_throws()
+  {
+    TS_ASSERT_THROWS(FFTPlanCache::Instance().realWavetable(0), std::invalid_argument);
+    TS_ASSERT_THROWS(FFTPlanCache::Instance().complexWavetable(0), std::invalid_argument);
+    TS_ASSERT_EQUALS(FFTPlanCache::Instance().size(), 0);
+  }
+
+  void test_wavetable_stays_valid_after_clear()
+  {
+    const size_t n = 30;
+    auto forward = FFTPlanCache::Instance().realWavetable(n);
+    auto inverse = FFTPlanCache::Instance().halfComplexWavetable(n);
+    FFTPlanCache::Instance().clear();
+    TS_ASSERT_EQUALS(FFTPlanCache::Instance().size(), 0);
+
+    std::vector<double> data(n);
+    for(size_t i = 0; i < n; ++i)
+    {
+      data[i] = std::sin(0.3 * static_cast<double>(i)) + 0.1 * static_cast<double>(i);
+    }
+    std::vector<double> original(data);
+
+    gsl_fft_real_workspace * workspace = gsl_fft_real_workspace_alloc(n);
+    gsl_fft_real_transform(&data[0], 1, n, forward.get(), workspace);
+    gsl_fft_halfcomplex_inverse(&data[0], 1, n, inverse.get(), workspace);
+    gsl_fft_real_workspace_free(workspace);
+
+    for(size_t i = 0; i < n; ++i)
+    {
+      TS_ASSERT_DELTA(data[i], original[i], 1e-12);
+    }
+  }
+
+};
+
+#endif /* MANTID_KERNEL_FFTPLANCACHETEST_H_ */
@@ -169,6 +169,23 @@ public:
     TS_ASSERT(m_testHDF5->classTypeExists("NXlog"));
   }
 
+  void test_Path_Queries_Give_Same_Answers_Before_And_After_Whole_File_Is_Read()
+  {
+    NexusDescriptor descriptor(m_testHDF5Path);
+    TS_ASSERT(descriptor.pathExists("/entry/bank1/data_x_y"));
+    TS_ASSERT(descriptor.pathOfTypeExists("/entry/bank1_events","NXevent_data"));
+    TS_ASSERT(!descriptor.pathExists("/entry/bank1_events/missing"));
+    TS_ASSERT(!descriptor.pathExists("/entry/bank1/data_x_y/missing"));
+    TS_ASSERT_EQUALS("", descriptor.data().getPath());
+
+    TS_ASSERT(descriptor.classTypeExists("NXevent_data"));
+
+    TS_ASSERT(descriptor.pathExists("/entry/bank1/data_x_y"));
+    TS_ASSERT(descriptor.pathOfTypeExists("/entry/bank1_events","NXevent_data"));
+    TS_ASSERT(!descriptor.pathExists("/entry/bank1_events/missing"));
+    TS_ASSERT_EQUALS("", descriptor.data().getPath());
+  }
+
 private:
 
   std::string m_testHDF5Path;
@@ -183,6 +183,14 @@ public:
         const Event * firstEvent() const;
         const Event * nextEvent() const;
 
+        // Bank at a time access: the events of a bank are contiguous in the
+        // packet.  The event returned by firstEvent() or nextBankEvents() is
+        // the first of curBankEventCount() events.  nextBankEvents() skips the
+        // rest of the current bank and returns the first event of the next
+        // bank that has any (or NULL if there are none left).
+        const Event * nextBankEvents() const;
+        uint32_t curBankEventCount() const { return m_eventCount; }
+
         bool     getSourceCORFlag() const   { return m_isCorrected; }
         uint32_t getSourceTOFOffset() const { return m_TOFOffset; }
         uint32_t curBankId() const { return m_bankId; }
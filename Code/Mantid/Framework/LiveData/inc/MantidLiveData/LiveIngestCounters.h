@@ -0,0 +1,80 @@
+#ifndef MANTID_LIVEDATA_LIVEINGESTCOUNTERS_H_
+#define MANTID_LIVEDATA_LIVEINGESTCOUNTERS_H_
+
+//----------------------------------------------------------------------
+// Includes
+//----------------------------------------------------------------------
+#include "MantidAPI/Run.h"
+#include "MantidKernel/DateAndTime.h"
+#include "MantidKernel/System.h"
+
+#include <stdint.h>
+
+namespace Mantid
+{
+namespace LiveData
+{
+
+/** Counts the events a live listener receives and drops between two calls to extractData(),
+    and reports them as logs of the extracted workspace:
+      - live_events_received: events added to the workspace
+      - live_events_dropped: events thrown away
+      - live_event_rate: events received per second
+      - live_backlog: seconds between the extraction and the pulse time of the latest events
+
+    The logs are time series with a single entry stamped with the extraction time, so that
+    LoadLiveData's accumulation keeps one entry per chunk instead of the values of the first one.
+    The class does no locking of its own.
+
+    Copyright &copy; 2014 ISIS Rutherford Appleton Laboratory, NScD Oak Ridge National Laboratory & European Spallation Source
+
+    This file is part of Mantid.
+
+    Mantid is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 3 of the License, or
+    (at your option) any later version.
+
+    Mantid is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+    File change history is stored at: <https://github.com/mantidproject/mantid>.
+    Code Documentation is available at: <http://doxygen.mantidproject.org>
+*/
+class DLLExport LiveIngestCounters
+{
+public:
+  LiveIngestCounters();
+
+  /// Count events added to the workspace, along with their pulse time
+  void eventsReceived(uint64_t count, const Kernel::DateAndTime & pulseTime);
+  /// Count events that were thrown away
+  void eventsDropped(uint64_t count);
+  /// Start counting again, keeping the latest pulse time
+  void resetCounts();
+
+  /// The number of events received since the counts were reset
+  uint64_t received() const { return m_received; }
+  /// The number of events dropped since the counts were reset
+  uint64_t dropped() const { return m_dropped; }
+  /// The pulse time of the latest events received
+  const Kernel::DateAndTime & lastPulseTime() const { return m_lastPulseTime; }
+
+  /// Add the counts as logs of a run, replacing any previous ones
+  void addLogs(API::Run & run, const Kernel::DateAndTime & since, const Kernel::DateAndTime & now) const;
+
+private:
+  uint64_t m_received;
+  uint64_t m_dropped;
+  Kernel::DateAndTime m_lastPulseTime;
+};
+
+} // namespace LiveData
+} // namespace Mantid
+
+#endif  /* MANTID_LIVEDATA_LIVEINGESTCOUNTERS_H_ */
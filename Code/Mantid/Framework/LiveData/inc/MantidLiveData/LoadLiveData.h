@@ -58,10 +58,12 @@ namespace LiveData
     Mantid::API::Workspace_sptr processChunk(Mantid::API::Workspace_sptr chunkWS);
     void runPostProcessing();
 
-    void replaceChunk(Mantid::API::Workspace_sptr chunkWS);
-    void addChunk(Mantid::API::Workspace_sptr chunkWS);
+    void accumulateChunk(const std::string &accum, API::Workspace_sptr &accumWS, API::Workspace_sptr chunkWS);
+    void replaceChunk(API::Workspace_sptr &accumWS, API::Workspace_sptr chunkWS);
+    void addChunk(API::Workspace_sptr &accumWS, API::Workspace_sptr chunkWS);
     void addMatrixWSChunk(const std::string &algoName, API::Workspace_sptr accumWS, API::Workspace_sptr chunkWS);
-    void appendChunk(Mantid::API::Workspace_sptr chunkWS);
+    bool addMatrixWSChunkInPlace(API::Workspace_sptr accumWS, API::Workspace_sptr chunkWS);
+    void appendChunk(API::Workspace_sptr &accumWS, API::Workspace_sptr chunkWS);
     API::Workspace_sptr appendMatrixWSChunk(API::Workspace_sptr accumWS, Mantid::API::Workspace_sptr chunkWS);
 
     void doSortEvents(Mantid::API::Workspace_sptr ws);
@@ -71,6 +73,9 @@ namespace LiveData
 
     /// The final output = the post-processed accumulation workspace
     Mantid::API::Workspace_sptr m_outputWS;
+
+    /// Post-process each chunk and accumulate the results instead of post-processing m_accumWS
+    bool m_postProcessIncrementally;
   };
 
 
@@ -5,6 +5,7 @@
 // Includes
 //----------------------------------------------------------------------
 #include "MantidLiveData/ADARA/ADARAParser.h"
+#include "MantidLiveData/LiveIngestCounters.h"
 #include "MantidAPI/ILiveListener.h"
 #include "MantidDataObjects/EventWorkspace.h"
 #include "MantidKernel/MultiThreaded.h"
@@ -39,7 +40,7 @@ namespace Mantid
         You should have received a copy of the GNU General Public License
         along with this program.  If not, see <http://www.gnu.org/licenses/>.
      */
-    class SNSLiveEventDataListener : public API::ILiveListener,
+    class DLLExport SNSLiveEventDataListener : public API::ILiveListener,
                                      public Poco::Runnable,
                                      public ADARA::Parser
     {
@@ -63,6 +64,9 @@ namespace Mantid
 
       int runNumber() const {return m_runNumber;};
 
+      // A copy of the events received and dropped since the last call to extractData()
+      LiveIngestCounters ingestCounters();
+
       bool isConnected();
 
       virtual void run();  // the background thread.  What gets executed when we call
@@ -113,12 +117,8 @@ namespace Mantid
       // Returns true if we've got a value for every log listed in m_requiredLogs
       bool haveRequiredLogs();
 
-      void appendEvent( uint32_t pixelId, double tof, const Mantid::Kernel::DateAndTime pulseTime);
-      // tof is "Time Of Flight" and is in units of microsecondss relative to the start of the pulse
-      // (There's some documentation that says nanoseconds, but Russell Taylor assures me it's really
-      // is microseconds!)
-      // pulseTime is the start of the pulse relative to Jan 1, 1990.
-      // Both values are designed to be passed straight into the TofEvent constructor.
+      // Finds the workspace index for a pixel id.  Returns false if the id is invalid.
+      bool findWorkspaceIndex( uint32_t pixelId, size_t &workspaceIndex) const;
 
       ILiveListener::RunStatus m_status;
       int m_runNumber;
@@ -127,6 +127,8 @@ namespace Mantid
       bool m_workspaceInitialized;
       std::string m_wsName;
       detid2index_map m_indexMap;  // maps pixel id's to workspace indexes
+      std::vector<size_t> m_pixelIndexTable;  // same as m_indexMap, indexed by pixel id (empty if
+                                              // the ids are too sparse)
       detid2index_map m_monitorIndexMap;  // Same as above for the monitor workspace
 
       // We need these 2 strings to initialize m_buffer
@@ -206,6 +208,16 @@ namespace Mantid
       // extractData() and retrieved the last data from the previous state (which was probably NO_RUN).
       // This holds a copy of the RunStatusPkt until we can call setRunDetails().
       boost::shared_ptr<ADARA::RunStatusPkt>  m_deferredRunDetailsPkt;
+
+      // Events of the current BankedEventPkt with their workspace indexes.  They are decoded
+      // without holding m_mutex and appended to m_eventBuffer all at once.  (Only used by the
+      // background thread, it's a member so its memory is reused from packet to packet.)
+      std::vector<std::pair<size_t, DataObjects::TofEvent> > m_stagedEvents;
+
+      // Events received and dropped since the last call to extractData(), which reports
+      // them as logs.  Protected by m_mutex.
+      LiveIngestCounters m_ingestCounters;
+      Kernel::DateAndTime m_lastExtractTime;  // when extractData() was last called
     };
 
   } // namespace LiveData
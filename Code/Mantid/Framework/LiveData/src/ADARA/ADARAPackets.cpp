@@ -195,6 +195,17 @@ const Event * BankedEventPkt::nextEvent() const
   return m_curEvent;
 }
 
+const Event * BankedEventPkt::nextBankEvents() const
+{
+  if (m_curEvent)
+  {
+    // Pretend we're at the last event of the bank and let nextEvent() find
+    // the start of the next bank (or source section)
+    m_curFieldIndex = m_bankStartIndex + (2*m_eventCount);
+  }
+  return nextEvent();
+}
+
 // Helper functions for firstEvent() & nextEvent()
 
 // Assumes m_curFieldIndex points to the start of a source section.
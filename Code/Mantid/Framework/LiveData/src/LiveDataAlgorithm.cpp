@@ -100,6 +100,12 @@ namespace LiveData
     declareProperty(new PropertyWithValue<std::string>("PostProcessingScript","",Direction::Input),
         "A Python script that will be run to process the accumulated data.");
 
+    declareProperty("PostProcessIncrementally", false,
+        "Run the post-processing on each chunk and accumulate the results, instead of\n"
+        "post-processing all of the accumulated data at every update. Default False.\n"
+        "This only gives the same result when the post-processing is linear in the counts\n"
+        "(e.g. rebinning, unit conversion or summing spectra, but not normalisation).");
+
     std::vector<std::string> runOptions;
     runOptions.push_back("Restart");
     runOptions.push_back("Stop");
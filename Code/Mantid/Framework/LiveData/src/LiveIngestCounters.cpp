@@ -0,0 +1,83 @@
+#include "MantidLiveData/LiveIngestCounters.h"
+#include "MantidKernel/TimeSeriesProperty.h"
+
+// Names of the logs describing how the listener keeps up with the stream
+#define EVENTS_RECEIVED_LOG "live_events_received"
+#define EVENTS_DROPPED_LOG "live_events_dropped"
+#define EVENT_RATE_LOG "live_event_rate"
+#define BACKLOG_LOG "live_backlog"
+
+namespace Mantid
+{
+namespace LiveData
+{
+  using Kernel::DateAndTime;
+  using Kernel::TimeSeriesProperty;
+
+  namespace
+  {
+    /// Replace a log of the run with a time series holding the single given value
+    void setLog(API::Run & run, const std::string & name, const DateAndTime & time, double value)
+    {
+      TimeSeriesProperty<double> * log = new TimeSeriesProperty<double>(name);
+      log->addValue(time, value);
+      run.addProperty(log, true);
+    }
+  }
+
+  /// Constructor
+  LiveIngestCounters::LiveIngestCounters() : m_received(0), m_dropped(0), m_lastPulseTime()
+  {
+  }
+
+  /** Count events added to the workspace
+   *  @param count :: The number of events
+   *  @param pulseTime :: Their pulse time
+   */
+  void LiveIngestCounters::eventsReceived(uint64_t count, const DateAndTime & pulseTime)
+  {
+    m_received += count;
+    m_lastPulseTime = pulseTime;
+  }
+
+  /** Count events that were thrown away
+   *  @param count :: The number of events
+   */
+  void LiveIngestCounters::eventsDropped(uint64_t count)
+  {
+    m_dropped += count;
+  }
+
+  /** Zero the counts. The latest pulse time is kept so the backlog can still be reported
+   *  if no events arrive before the next extraction.
+   */
+  void LiveIngestCounters::resetCounts()
+  {
+    m_received = 0;
+    m_dropped = 0;
+  }
+
+  /** Add the counts as logs of a run. Logs of the same names are replaced, so a workspace
+   *  that inherited them from an earlier chunk only reports its own counts.
+   *  @param run :: The run to add the logs to
+   *  @param since :: When counting started, used for the event rate
+   *  @param now :: The time the logs are stamped with
+   */
+  void LiveIngestCounters::addLogs(API::Run & run, const DateAndTime & since, const DateAndTime & now) const
+  {
+    const double elapsed = DateAndTime::secondsFromDuration(now - since);
+    setLog(run, EVENTS_RECEIVED_LOG, now, static_cast<double>(m_received));
+    setLog(run, EVENTS_DROPPED_LOG, now, static_cast<double>(m_dropped));
+    setLog(run, EVENT_RATE_LOG, now, elapsed > 0 ? static_cast<double>(m_received) / elapsed : 0.0);
+    if (m_lastPulseTime != DateAndTime())
+    {
+      setLog(run, BACKLOG_LOG, now, DateAndTime::secondsFromDuration(now - m_lastPulseTime));
+    }
+    else if (run.hasProperty(BACKLOG_LOG))
+    {
+      run.removeProperty(BACKLOG_LOG);
+    }
+  }
+
+} // namespace LiveData
+} // namespace Mantid
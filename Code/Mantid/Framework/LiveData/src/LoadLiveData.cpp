@@ -5,13 +5,18 @@
 #include "MantidAPI/AlgorithmManager.h"
 #include "MantidAPI/Workspace.h"
 #include "MantidDataObjects/EventWorkspace.h"
+#include "MantidDataObjects/RebinnedOutput.h"
+#include "MantidDataObjects/Workspace2D.h"
 #include "MantidKernel/CPUTimer.h"
+#include "MantidKernel/MultiThreaded.h"
 
 #include <boost/algorithm/string.hpp>
 #include <boost/lexical_cast.hpp>
 
 #include <Poco/Thread.h>
 
+#include <cmath>
+
 using namespace Mantid::Kernel;
 using namespace Mantid::API;
 using namespace Mantid::DataObjects;
@@ -29,7 +34,7 @@ namespace LiveData
   /** Constructor
    */
   LoadLiveData::LoadLiveData()
-  : LiveDataAlgorithm()
+  : LiveDataAlgorithm(), m_postProcessIncrementally(false)
   {
   }
     
@@ -89,8 +94,14 @@ namespace LiveData
       // Transform the chunk in-place
       std::string outputName = inputName;
 
-      // Except, no need for anonymous names with the post-processing
-      if (PostProcess)
+      // Except, no need for anonymous names with the post-processing of the accumulated data.
+      // A post-processed chunk keeps anonymous names but must not be processed in-place
+      // as it is accumulated afterwards.
+      if (PostProcess && m_postProcessIncrementally)
+      {
+        outputName = "__anonymous_livedata_postprocessed_" + this->getPropertyValue("OutputWorkspace");
+      }
+      else if (PostProcess)
       {
         inputName = this->getPropertyValue("AccumulationWorkspace");
         outputName = this->getPropertyValue("OutputWorkspace");
@@ -181,15 +192,17 @@ namespace LiveData
         throw std::runtime_error("The " + alg->name() + " Algorithm's OutputWorkspace property is not a WorkspaceProperty!");
       Workspace_sptr temp = wsProp->getWorkspace();
 
-      if (!PostProcess)
+      if (!PostProcess || m_postProcessIncrementally)
       {
           if ( !temp )
           {
             // a group workspace cannot be returned by wsProp
-            temp = AnalysisDataService::Instance().retrieve(inputName);
+            temp = AnalysisDataService::Instance().retrieve(outputName);
           }
-        // Remove the chunk workspace from the ADS, it is no longer needed there.
+        // Remove the chunk workspaces from the ADS, they are no longer needed there.
         AnalysisDataService::Instance().remove(inputName);
+        if (outputName != inputName && AnalysisDataService::Instance().doesExist(outputName))
+          AnalysisDataService::Instance().remove(outputName);
       }
       else if ( !temp )
       {
@@ -229,17 +242,36 @@ namespace LiveData
   }
 
 
+  //----------------------------------------------------------------------------------------------
+  /** Accumulate a chunk into a workspace using the given method.
+   *
+   * @param accum :: accumulation method: "Replace", "Append" or "Add"
+   * @param accumWS :: the workspace accumulated into. Reset if the method requires it.
+   * @param chunkWS :: processed live data chunk workspace
+   */
+  void LoadLiveData::accumulateChunk(const std::string &accum, Workspace_sptr &accumWS, Workspace_sptr chunkWS)
+  {
+    if (accum == "Replace")
+      this->replaceChunk(accumWS, chunkWS);
+    else if (accum == "Append")
+      this->appendChunk(accumWS, chunkWS);
+    else
+      // Default to Add.
+      this->addChunk(accumWS, chunkWS);
+  }
+
+
   //----------------------------------------------------------------------------------------------
   /** Accumulate the data by adding (summing) to the output workspace.
-   * Calls the Plus algorithm
-   * Sets m_accumWS.
+   * Adds matrix workspaces in place when possible, otherwise calls the Plus algorithm.
    *
+   * @param accumWS :: the workspace accumulated into
    * @param chunkWS :: processed live data chunk workspace
    */
-  void LoadLiveData::addChunk(Mantid::API::Workspace_sptr chunkWS)
+  void LoadLiveData::addChunk(Workspace_sptr &accumWS, Workspace_sptr chunkWS)
   {
     // Acquire locks on the workspaces we use
-    WriteLock _lock1(*m_accumWS);
+    WriteLock _lock1(*accumWS);
     ReadLock _lock2(*chunkWS);
 
     // Choose the appropriate algorithm to add chunks
@@ -251,7 +283,7 @@ namespace LiveData
 
     if ( gws )
     {
-      WorkspaceGroup_sptr accum_gws = boost::dynamic_pointer_cast<WorkspaceGroup>(m_accumWS);
+      WorkspaceGroup_sptr accum_gws = boost::dynamic_pointer_cast<WorkspaceGroup>(accumWS);
       if ( !accum_gws )
       {
         throw std::runtime_error("Two workspace groups are expected.");
@@ -269,7 +301,7 @@ namespace LiveData
     else
     {
       // just add the chunk
-      addMatrixWSChunk( algoName, m_accumWS, chunkWS );
+      addMatrixWSChunk( algoName, accumWS, chunkWS );
     }
   }
 
@@ -294,6 +326,14 @@ namespace LiveData
       if ( accumMon && chunkMon ) accumMon += chunkMon;
     }
 
+    // Live chunks normally match the accumulation workspace spectrum for spectrum,
+    // so skip the copying done by Plus when we can
+    if ( addMatrixWSChunkInPlace(accumWS, chunkWS) )
+    {
+      doSortEvents(accumWS);
+      return;
+    }
+
     // Now do the main workspace
     IAlgorithm_sptr alg = this->createChildAlgorithm(algoName);
     alg->setProperty("LHSWorkspace", accumWS);
@@ -319,20 +359,116 @@ namespace LiveData
     }
   }
 
+  //----------------------------------------------------------------------------------------------
+  /**
+   * Add a matrix workspace chunk to the accumulation workspace without running Plus.
+   * Only done when both are EventWorkspaces or both are Workspace2Ds with the same spectra,
+   * units and (for histograms) binning; nothing is changed otherwise.
+   * RebinnedOutput workspaces are left to Plus, which weights their counts by the fractional areas.
+   * The events of the chunk are moved into the accumulation workspace, which leaves
+   * the chunk empty.
+   *
+   * @param accumWS :: accumulation matrix workspace
+   * @param chunkWS :: processed live data chunk matrix workspace
+   * @return true if the chunk was added
+   */
+  bool LoadLiveData::addMatrixWSChunkInPlace(Workspace_sptr accumWS, Workspace_sptr chunkWS)
+  {
+    auto accumMW = boost::dynamic_pointer_cast<MatrixWorkspace>(accumWS);
+    auto chunkMW = boost::dynamic_pointer_cast<MatrixWorkspace>(chunkWS);
+    if ( !accumMW || !chunkMW || accumMW == chunkMW )
+      return false;
+
+    const size_t numHist = accumMW->getNumberHistograms();
+    if ( chunkMW->getNumberHistograms() != numHist
+        || accumMW->YUnit() != chunkMW->YUnit()
+        || accumMW->isDistribution() != chunkMW->isDistribution() )
+      return false;
+    auto accumUnit = accumMW->getAxis(0)->unit();
+    auto chunkUnit = chunkMW->getAxis(0)->unit();
+    if ( !accumUnit || !chunkUnit || accumUnit->unitID() != chunkUnit->unitID() )
+      return false;
+    for (size_t i = 0; i < numHist; ++i)
+    {
+      if ( accumMW->getSpectrum(i)->getSpectrumNo() != chunkMW->getSpectrum(i)->getSpectrumNo() )
+        return false;
+    }
+
+    auto accumEvents = boost::dynamic_pointer_cast<EventWorkspace>(accumWS);
+    auto chunkEvents = boost::dynamic_pointer_cast<EventWorkspace>(chunkWS);
+    auto accum2D = boost::dynamic_pointer_cast<Workspace2D>(accumWS);
+    auto chunk2D = boost::dynamic_pointer_cast<Workspace2D>(chunkWS);
+    if ( boost::dynamic_pointer_cast<RebinnedOutput>(accumWS) || boost::dynamic_pointer_cast<RebinnedOutput>(chunkWS) )
+      return false;
+
+    if ( accumEvents && chunkEvents )
+    {
+      PARALLEL_FOR_NO_WSP_CHECK()
+      for (int64_t i = 0; i < int64_t(numHist); ++i)
+      {
+        EventList & accumList = accumEvents->getEventList(i);
+        EventList & chunkList = chunkEvents->getEventList(i);
+        if ( accumList.getNumberEvents() == 0 && accumList.getEventType() == TOF && chunkList.getEventType() == TOF )
+        {
+          // Nothing to append to: take over the chunk's events
+          accumList.getEvents().swap(chunkList.getEvents());
+          accumList.setSortOrder(UNSORTED);
+          accumList.addDetectorIDs(chunkList.getDetectorIDs());
+        }
+        else
+        {
+          accumList += chunkList;
+        }
+        chunkList.clear(false);
+      }
+      accumEvents->clearMRU();
+      chunkEvents->clearMRU();
+    }
+    else if ( accum2D && chunk2D )
+    {
+      for (size_t i = 0; i < numHist; ++i)
+      {
+        if ( chunk2D->hasMaskedBins(i) || accum2D->readX(i) != chunk2D->readX(i) )
+          return false;
+      }
+      PARALLEL_FOR_NO_WSP_CHECK()
+      for (int64_t i = 0; i < int64_t(numHist); ++i)
+      {
+        MantidVec & accumY = accum2D->dataY(i);
+        MantidVec & accumE = accum2D->dataE(i);
+        const MantidVec & chunkY = chunk2D->readY(i);
+        const MantidVec & chunkE = chunk2D->readE(i);
+        for (size_t j = 0; j < accumY.size(); ++j)
+        {
+          accumY[j] += chunkY[j];
+          accumE[j] = std::sqrt(accumE[j] * accumE[j] + chunkE[j] * chunkE[j]);
+        }
+      }
+    }
+    else
+    {
+      return false;
+    }
+
+    // As Plus does: add the proton charge and merge the logs
+    accumMW->mutableRun() += chunkMW->run();
+    return true;
+  }
+
 
   //----------------------------------------------------------------------------------------------
   /** Accumulate the data by replacing the output workspace.
-   * Sets m_accumWS.
    *
+   * @param accumWS :: set to the chunk
    * @param chunkWS :: processed live data chunk workspace
    */
-  void LoadLiveData::replaceChunk(Mantid::API::Workspace_sptr chunkWS)
+  void LoadLiveData::replaceChunk(Workspace_sptr &accumWS, Workspace_sptr chunkWS)
   {
     // When the algorithm exits the chunk workspace will be renamed
     // and overwrite the old one
-    m_accumWS = chunkWS;
+    accumWS = chunkWS;
     // And sort the events, if any
-    doSortEvents(m_accumWS);
+    doSortEvents(accumWS);
   }
 
 
@@ -341,18 +477,18 @@ namespace LiveData
    * the output workspace.
    * Checks if the chunk is a group and if it is calls appendMatrixWSChunk for each item.
    * If it's a matrix just calls appendMatrixWSChunk.
-   * Sets m_accumWS.
    *
+   * @param accumWS :: the workspace accumulated into
    * @param chunkWS :: processed live data chunk workspace
    */
-  void LoadLiveData::appendChunk(Mantid::API::Workspace_sptr chunkWS)
+  void LoadLiveData::appendChunk(Workspace_sptr &accumWS, Workspace_sptr chunkWS)
   {
       // ISIS multi-period data come in workspace groups
       WorkspaceGroup_sptr chunk_gws = boost::dynamic_pointer_cast<WorkspaceGroup>(chunkWS);
 
       if ( chunk_gws )
       {
-          WorkspaceGroup_sptr accum_gws = boost::dynamic_pointer_cast<WorkspaceGroup>(m_accumWS);
+          WorkspaceGroup_sptr accum_gws = boost::dynamic_pointer_cast<WorkspaceGroup>(accumWS);
           if ( !accum_gws )
           {
               throw std::runtime_error("Two workspace groups are expected.");
@@ -378,7 +514,7 @@ namespace LiveData
       else
       {
           // just append the chunk
-          m_accumWS = appendMatrixWSChunk( m_accumWS, chunkWS );
+          accumWS = appendMatrixWSChunk( accumWS, chunkWS );
       }
   }
 
@@ -457,6 +593,8 @@ namespace LiveData
       // No post-processing, so the accumulation and output are the same
       m_accumWS = m_outputWS;
     }
+    bool postProcessIncrementally = this->getProperty("PostProcessIncrementally");
+    m_postProcessIncrementally = postProcessIncrementally && this->hasPostProcessing();
 
     // Get or create the live listener
     ILiveListener_sptr listener = this->getLiveListener();
@@ -532,18 +670,27 @@ namespace LiveData
 
     g_log.notice() << "Performing the " << accum << " operation." << std::endl;
 
+    // Post-process the chunk on its own before accumulating it, which may consume its events
+    Workspace_sptr postProcessed;
+    if (m_postProcessIncrementally)
+      postProcessed = runProcessing(processed, true);
+
     // Perform the accumulation and set the AccumulationWorkspace workspace
-    if (accum == "Replace")
-      this->replaceChunk(processed);
-    else if (accum == "Append")
-      this->appendChunk(processed);
-    else
-      // Default to Add.
-      this->addChunk(processed);
+    this->accumulateChunk(accum, m_accumWS, processed);
 
     // At this point, m_accumWS is set.
 
-    if (this->hasPostProcessing())
+    if (m_postProcessIncrementally)
+    {
+      // ----------- Accumulate the post-processed chunk -------------
+      std::string outputAccum = accum;
+      if (!m_outputWS || dataReset)
+        outputAccum = "Replace";
+      this->accumulateChunk(outputAccum, m_outputWS, postProcessed);
+      this->setProperty("AccumulationWorkspace", m_accumWS);
+      this->setProperty("OutputWorkspace", m_outputWS);
+    }
+    else if (this->hasPostProcessing())
     {
       // ----------- Run post-processing -------------
       this->runPostProcessing();
@@ -28,7 +28,9 @@
 #include <time.h>
 #include <sstream>    // for ostringstream
 #include <string>
+#include <algorithm>
 #include <exception>
+#include <limits>
 
 using namespace Mantid::Kernel;
 using namespace Mantid::API;
@@ -43,6 +45,9 @@ using namespace Mantid::API;
 #define SCAN_PROPERTY "scan_index"
 #define PROTON_CHARGE_PROPERTY "proton_charge"
 
+// Marks the pixel IDs without a workspace index in the pixel lookup table
+#define INVALID_INDEX std::numeric_limits<size_t>::max()
+
 
 // Helper function to get a DateAndTime value from an ADARA packet header
 Mantid::Kernel::DateAndTime timeFromPacket( const ADARA::PacketHeader &hdr)
@@ -79,7 +84,8 @@ namespace LiveData
       m_isConnected( false), m_pauseNetRead(false), m_stopThread( false),
       m_runPaused( false),
       m_ignorePackets( true),
-      m_filterUntilRunStart( false)
+      m_filterUntilRunStart( false),
+      m_ingestCounters(), m_lastExtractTime( DateAndTime::getCurrentTime())
     // ADARA::Parser() will accept values for buffer size and max packet size, but the
     // defaults will work fine
   {
@@ -177,6 +183,17 @@ namespace LiveData
     return m_isConnected;
   }
 
+  /// Get the ingest counters
+
+  /// Returns a copy of the counts of events received and dropped since the last
+  /// call to extractData().  (extractData() resets them.)
+  /// @return Returns the counters
+  LiveIngestCounters SNSLiveEventDataListener::ingestCounters()
+  {
+    Poco::ScopedLock<Poco::FastMutex> scopedLock( m_mutex);
+    return m_ingestCounters;
+  }
+
   /// Start the background thread
 
   /// Starts the background thread which reads data from the network, parses it and
@@ -373,6 +390,15 @@ namespace LiveData
         // Note: One error message per BankedEventPkt is likely to absolutely flood the error log.
         // Might want to think about rate limiting this somehow...
 
+        // Report the events as dropped
+        uint64_t droppedEvents = 0;
+        for (const ADARA::Event *event = pkt.firstEvent(); event != NULL; event = pkt.nextBankEvents())
+        {
+          droppedEvents += pkt.curBankEventCount();
+        }
+        Poco::ScopedLock<Poco::FastMutex> scopedLock(m_mutex);
+        m_ingestCounters.eventsDropped( droppedEvents);
+
         return false; // We still return false (ie: "no error") because there's no reason to stop
                       // parsing the data stream
       }
@@ -390,52 +416,86 @@ namespace LiveData
       return false;
     }
 
-    // Append the events
+    // Decode the events and look up their workspace indexes before taking the mutex,
+    // so that extractData() only has to wait while the whole batch is appended.
+    // (m_indexMap is only modified by this thread.)
     g_log.debug() << "----- Pulse ID: " << pkt.pulseId() << " -----\n";
-    // Scope braces
-    {
-      Poco::ScopedLock<Poco::FastMutex> scopedLock(m_mutex);
 
-      // Timestamp for the events
-      Mantid::Kernel::DateAndTime eventTime = timeFromPacket( pkt);
+    // Timestamp for the events
+    Mantid::Kernel::DateAndTime eventTime = timeFromPacket( pkt);
 
-      // Save the pulse charge in the logs (*10 because we want the units to be
-      // picoCulombs, and ADARA sends them out in units of 10pC)
-      m_eventBuffer->mutableRun().getTimeSeriesProperty<double>( PROTON_CHARGE_PROPERTY)
-                    ->addValue( eventTime, pkt.pulseCharge()*10);
+    m_stagedEvents.clear();
+    uint64_t invalidEvents = 0;
+    uint32_t firstInvalidPixel = 0;
 
-      // Iterate through each event
-      const ADARA::Event *event = pkt.firstEvent();
-      unsigned lastBankID = pkt.curBankId();
-      // A counter that we use for logging purposes
-      unsigned eventsPerBank = 0;
-      while (event != NULL)
+    // Iterate through each bank.  The events of a bank are contiguous in the packet,
+    // so they're unpacked with a simple loop over the array.
+    const ADARA::Event *event = pkt.firstEvent();
+    while (event != NULL)
+    {
+      const unsigned bankID = pkt.curBankId();
+      const uint32_t eventsInBank = pkt.curBankEventCount();
+      totalEvents += eventsInBank;
+      g_log.debug() << "BankID " << bankID << " had " << eventsInBank << " events\n";
+
+      if (bankID < 0xFFFFFFFE)  // Bank ID -1 & -2 are special cases and are not valid pixels
       {
-        eventsPerBank++;
-        totalEvents++;
-        if (lastBankID < 0xFFFFFFFE)  // Bank ID -1 & -2 are special cases and are not valid pixels
+        // TofEvent needs tof to be in units of microseconds, but it comes
+        // from the ADARA stream in units of 100ns.
+        const uint32_t tofOffset = pkt.getSourceCORFlag() ? 0 : pkt.getSourceTOFOffset();
+        for (uint32_t i = 0; i < eventsInBank; ++i)
         {
-          // appendEvent needs tof to be in units of microseconds, but it comes
-          // from the ADARA stream in units of 100ns.
-          if (pkt.getSourceCORFlag())
+          const double tof = (event[i].tof + tofOffset) / 10.0;
+          size_t workspaceIndex;
+          if (findWorkspaceIndex( event[i].pixel, workspaceIndex))
           {
-            appendEvent(event->pixel, event->tof / 10.0, eventTime);
+            m_stagedEvents.push_back( std::make_pair( workspaceIndex, DataObjects::TofEvent( tof, eventTime)));
           }
           else
           {
-            appendEvent(event->pixel, (event->tof + pkt.getSourceTOFOffset()) / 10.0, eventTime);
+            if (invalidEvents == 0)
+            {
+              firstInvalidPixel = event[i].pixel;
+            }
+            invalidEvents++;
           }
         }
+      }
 
-        event = pkt.nextEvent();
-        if (pkt.curBankId() != lastBankID)
-        {
-          g_log.debug() << "BankID " << lastBankID << " had " << eventsPerBank << " events\n";
+      event = pkt.nextBankEvents();
+    }
 
-          lastBankID = pkt.curBankId();
-          eventsPerBank = 0;
-        }
+    if (invalidEvents > 0)
+    {
+      g_log.warning() << invalidEvents << " events with invalid pixel IDs (first one: "
+                      << firstInvalidPixel << ") were dropped" << std::endl;
+    }
+
+    // Append the events
+    // Scope braces
+    {
+      Poco::ScopedLock<Poco::FastMutex> scopedLock(m_mutex);
+
+      // runStatus() replaces the workspace at run transitions.  The events can't go
+      // into the new one until it has been initialized again.
+      if (! m_workspaceInitialized)
+      {
+        m_ingestCounters.eventsDropped( m_stagedEvents.size() + invalidEvents);
+        return false;
+      }
+
+      // Save the pulse charge in the logs (*10 because we want the units to be
+      // picoCulombs, and ADARA sends them out in units of 10pC)
+      m_eventBuffer->mutableRun().getTimeSeriesProperty<double>( PROTON_CHARGE_PROPERTY)
+                    ->addValue( eventTime, pkt.pulseCharge()*10);
+
+      for (auto it = m_stagedEvents.begin(); it != m_stagedEvents.end(); ++it)
+      {
+        m_eventBuffer->getEventList( it->first).addEventQuickly( it->second);
       }
+
+      m_ingestCounters.eventsReceived( m_stagedEvents.size(), eventTime);
+      m_ingestCounters.eventsDropped( invalidEvents);
     }  // mutex automatically unlocks here
 
     g_log.debug() << "Total Events: " << totalEvents << "\n";
@@ -1288,6 +1348,28 @@ namespace LiveData
 
     m_indexMap = m_eventBuffer->getDetectorIDToWorkspaceIndexMap( true /* bool throwIfMultipleDets */ );
 
+    // Pixel IDs are usually dense, so make a flat lookup table for the event decoding
+    // as long as it's not much bigger than the map
+    m_pixelIndexTable.clear();
+    if ( ! m_indexMap.empty())
+    {
+      detid_t minID = m_indexMap.begin()->first;
+      detid_t maxID = minID;
+      for (auto it = m_indexMap.begin(); it != m_indexMap.end(); ++it)
+      {
+        minID = std::min( minID, it->first);
+        maxID = std::max( maxID, it->first);
+      }
+      if (minID >= 0 && static_cast<size_t>(maxID) < 4 * m_indexMap.size() + 1024)
+      {
+        m_pixelIndexTable.assign( static_cast<size_t>(maxID) + 1, INVALID_INDEX);
+        for (auto it = m_indexMap.begin(); it != m_indexMap.end(); ++it)
+        {
+          m_pixelIndexTable[it->first] = it->second;
+        }
+      }
+    }
+
     // We always want to have at least one value for the the scan index time series.  We may have
     // already gotten a scan start packet by the time we get here and therefor don't need to do
     // anything.  If not, we need to put a 0 into the time series.
@@ -1345,26 +1427,32 @@ namespace LiveData
     return allFound;
   }
 
-  /// Adds an event to the workspace
-  void SNSLiveEventDataListener::appendEvent(uint32_t pixelId, double tof,
-                                             const Mantid::Kernel::DateAndTime pulseTime)
-  // NOTE: This function does NOT lock the mutex!  Make sure you do that
-  // before calling this function!
+  /// Look up the workspace index of a pixel
+
+  /// Uses the flat table built in initWorkspacePart2() if there is one, m_indexMap
+  /// otherwise.
+  /// @param pixelId The pixel ID from the ADARA stream
+  /// @param workspaceIndex Set to the workspace index of the pixel
+  /// @return Returns false if the pixel ID is invalid
+  bool SNSLiveEventDataListener::findWorkspaceIndex( uint32_t pixelId, size_t &workspaceIndex) const
   {
-    // It'd be nice to use operator[], but we might end up inserting a value....
-    // Have to use find() instead.
-    detid2index_map::iterator it = m_indexMap.find( pixelId);
-    if (it != m_indexMap.end())
+    if ( ! m_pixelIndexTable.empty())
     {
-      std::size_t workspaceIndex = it->second;
-      Mantid::DataObjects::TofEvent event( tof, pulseTime);
-      m_eventBuffer->getEventList( workspaceIndex).addEventQuickly( event);
+      if (pixelId >= m_pixelIndexTable.size())
+      {
+        return false;
+      }
+      workspaceIndex = m_pixelIndexTable[pixelId];
+      return workspaceIndex != INVALID_INDEX;
     }
-    else
+
+    detid2index_map::const_iterator it = m_indexMap.find( static_cast<detid_t>(pixelId));
+    if (it == m_indexMap.end())
     {
-      g_log.warning() << "Invalid pixel ID: " << pixelId << " (TofF: " << tof
-                      << " microseconds)" << std::endl;
+      return false;
     }
+    workspaceIndex = it->second;
+    return true;
   }
 
   /// Retrieve buffered data
@@ -1431,11 +1519,21 @@ namespace LiveData
     temp->setMonitorWorkspace(newMonitorBuffer);
 
     // Lock the mutex and swap the workspaces
+    LiveIngestCounters counters;
     {
       Poco::ScopedLock<Poco::FastMutex> scopedLock( m_mutex);
       std::swap(m_eventBuffer, temp);
+
+      counters = m_ingestCounters;
+      m_ingestCounters.resetCounts();
     }  // mutex automatically unlocks here
 
+    // Tell the user how well we keep up with the stream.  The logs are time series
+    // so that they are kept for every chunk when LoadLiveData accumulates them.
+    const DateAndTime now = DateAndTime::getCurrentTime();
+    counters.addLogs( temp->mutableRun(), m_lastExtractTime, now);
+    m_lastExtractTime = now;
+
     return temp;
   }
 
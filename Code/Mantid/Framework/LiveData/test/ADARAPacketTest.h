@@ -67,6 +67,29 @@ public:
       // Get the next event and verify it's null
       event = pkt->nextEvent();
       TS_ASSERT( ! event);
+
+      // Same again, a bank at a time
+      event = pkt->firstEvent();
+      TS_ASSERT( event);
+      if (event)
+      {
+        TS_ASSERT_EQUALS( pkt->curBankId(), 0x02);
+        TS_ASSERT_EQUALS( pkt->curBankEventCount(), 1);
+        TS_ASSERT_EQUALS( event[0].pixel, 0x043C);
+      }
+
+      event = pkt->nextBankEvents();
+      TS_ASSERT( event);
+      if (event)
+      {
+        TS_ASSERT_EQUALS( pkt->curBankId(), 0x13);
+        TS_ASSERT_EQUALS( pkt->curBankEventCount(), 1);
+        TS_ASSERT_EQUALS( event[0].tof, 0x00023F3A);
+        TS_ASSERT_EQUALS( event[0].pixel, 0x49E2);
+      }
+
+      event = pkt->nextBankEvents();
+      TS_ASSERT( ! event);
     }
   }
 
@@ -0,0 +1,182 @@
+#ifndef MANTID_LIVEDATA_LIVEINGESTCOUNTERSTEST_H_
+#define MANTID_LIVEDATA_LIVEINGESTCOUNTERSTEST_H_
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidLiveData/LiveIngestCounters.h"
+#include "MantidLiveData/SNSLiveEventDataListener.h"
+#include "MantidAPI/FrameworkManager.h"
+#include "MantidKernel/TimeSeriesProperty.h"
+
+#include <cstring>
+
+using namespace Mantid::LiveData;
+using Mantid::API::Run;
+using Mantid::Kernel::DateAndTime;
+using Mantid::Kernel::TimeSeriesProperty;
+
+namespace
+{
+  // Type:        "Banked Event Data" (version 0), with one event in each of 2 banks
+  // Pulse ID:    728504567.761741666
+  const unsigned char bankedEventPacket[96] = {
+    0x50, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x00, 0xf7, 0x18, 0x6c, 0x2b, 0x62, 0x41, 0x67, 0x2d,
+    0x87, 0xa5, 0x17, 0x00, 0xe4, 0x8d, 0xe8, 0x37, 0x3c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x0b, 0xb0, 0x3c, 0x15, 0x06, 0x8b, 0x02, 0x00, 0x88, 0xf6, 0x00, 0x80, 0x02, 0x00, 0x00, 0x00,
+    0x02, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0xd9, 0x3b, 0x02, 0x00, 0x3c, 0x04, 0x00, 0x00,
+    0x13, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x3a, 0x3f, 0x02, 0x00, 0xe2, 0x49, 0x00, 0x00,
+    0xc0, 0xdc, 0x3c, 0x15, 0x06, 0x8b, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
+
+  /// Feeds packets straight to the listener's parser, without a connection to an SMS
+  class UnconnectedSNSListener : public SNSLiveEventDataListener
+  {
+  public:
+    void parse(const unsigned char * data, unsigned int len)
+    {
+      memcpy(bufferFillAddress(), data, len);
+      bufferBytesAppended(len);
+      bufferParse();
+    }
+  };
+}
+
+class LiveIngestCountersTest : public CxxTest::TestSuite
+{
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static LiveIngestCountersTest *createSuite() { return new LiveIngestCountersTest(); }
+  static void destroySuite( LiveIngestCountersTest *suite ) { delete suite; }
+
+  LiveIngestCountersTest()
+  {
+    Mantid::API::FrameworkManager::Instance();
+  }
+
+  void test_Counts_Accumulate_Until_Reset()
+  {
+    LiveIngestCounters counters;
+    TS_ASSERT_EQUALS(counters.received(), 0);
+    TS_ASSERT_EQUALS(counters.dropped(), 0);
+    TS_ASSERT_EQUALS(counters.lastPulseTime(), DateAndTime());
+
+    const DateAndTime pulse("2013-01-31T13:22:47");
+    counters.eventsReceived(10, pulse - 1.0);
+    counters.eventsReceived(5, pulse);
+    counters.eventsDropped(3);
+    TS_ASSERT_EQUALS(counters.received(), 15);
+    TS_ASSERT_EQUALS(counters.dropped(), 3);
+    TS_ASSERT_EQUALS(counters.lastPulseTime(), pulse);
+
+    counters.resetCounts();
+    TS_ASSERT_EQUALS(counters.received(), 0);
+    TS_ASSERT_EQUALS(counters.dropped(), 0);
+    TS_ASSERT_EQUALS(counters.lastPulseTime(), pulse);
+  }
+
+  void test_addLogs_Adds_Single_Entry_Time_Series()
+  {
+    const DateAndTime since("2013-01-31T13:22:40");
+    const DateAndTime now = since + 4.0;
+    LiveIngestCounters counters;
+    counters.eventsReceived(100, since + 1.0);
+    counters.eventsDropped(2);
+
+    Run run;
+    counters.addLogs(run, since, now);
+
+    checkLog(run, "live_events_received", now, 100.0);
+    checkLog(run, "live_events_dropped", now, 2.0);
+    checkLog(run, "live_event_rate", now, 25.0);
+    checkLog(run, "live_backlog", now, 3.0);
+  }
+
+  void test_addLogs_Without_Pulses_Has_No_Backlog()
+  {
+    const DateAndTime since("2013-01-31T13:22:40");
+    LiveIngestCounters counters;
+    counters.eventsDropped(7);
+
+    Run run;
+    counters.addLogs(run, since, since);
+
+    checkLog(run, "live_events_received", since, 0.0);
+    checkLog(run, "live_events_dropped", since, 7.0);
+    checkLog(run, "live_event_rate", since, 0.0);
+    TS_ASSERT(!run.hasProperty("live_backlog"));
+  }
+
+  void test_addLogs_Replaces_Logs_Inherited_From_Earlier_Chunk()
+  {
+    const DateAndTime first("2013-01-31T13:22:40");
+    const DateAndTime second = first + 10.0;
+    LiveIngestCounters counters;
+    counters.eventsReceived(1, first);
+
+    Run run;
+    counters.addLogs(run, first - 1.0, first);
+    counters.resetCounts();
+    counters.eventsReceived(4, second);
+    counters.addLogs(run, first, second);
+
+    checkLog(run, "live_events_received", second, 4.0);
+  }
+
+  void test_Accumulated_Chunks_Keep_The_Counts_Of_Each_Chunk()
+  {
+    const DateAndTime first("2013-01-31T13:22:40");
+    const DateAndTime second = first + 2.0;
+    LiveIngestCounters counters;
+
+    Run accumulated;
+    counters.eventsReceived(10, first);
+    counters.addLogs(accumulated, first - 1.0, first);
+
+    Run chunk;
+    counters.resetCounts();
+    counters.eventsReceived(30, second);
+    counters.eventsDropped(1);
+    counters.addLogs(chunk, first, second);
+
+    accumulated += chunk;
+
+    TimeSeriesProperty<double> * received = accumulated.getTimeSeriesProperty<double>("live_events_received");
+    TS_ASSERT_EQUALS(received->size(), 2);
+    TS_ASSERT_EQUALS(received->lastTime(), second);
+    TS_ASSERT_EQUALS(received->lastValue(), 30.0);
+    TS_ASSERT_EQUALS(received->firstValue(), 10.0);
+    TimeSeriesProperty<double> * dropped = accumulated.getTimeSeriesProperty<double>("live_events_dropped");
+    TS_ASSERT_EQUALS(dropped->size(), 2);
+    TS_ASSERT_EQUALS(dropped->lastValue(), 1.0);
+  }
+
+  void test_SNS_Listener_Counts_Events_Dropped_Before_Initialization()
+  {
+    UnconnectedSNSListener listener;
+    TS_ASSERT_EQUALS(listener.ingestCounters().dropped(), 0);
+
+    // No geometry or run status has been received, so the workspace can't be initialized
+    TS_ASSERT_THROWS_NOTHING(listener.parse(bankedEventPacket, sizeof(bankedEventPacket)));
+    TS_ASSERT_EQUALS(listener.ingestCounters().received(), 0);
+    TS_ASSERT_EQUALS(listener.ingestCounters().dropped(), 2);
+
+    TS_ASSERT_THROWS_NOTHING(listener.parse(bankedEventPacket, sizeof(bankedEventPacket)));
+    TS_ASSERT_EQUALS(listener.ingestCounters().dropped(), 4);
+  }
+
+private:
+  void checkLog(Run & run, const std::string & name, const DateAndTime & time, double value)
+  {
+    TS_ASSERT(run.hasProperty(name));
+    if (!run.hasProperty(name)) return;
+    TimeSeriesProperty<double> * log = dynamic_cast<TimeSeriesProperty<double> *>(run.getProperty(name));
+    TS_ASSERT(log);
+    if (!log) return;
+    TS_ASSERT_EQUALS(log->size(), 1);
+    TS_ASSERT_EQUALS(log->firstTime(), time);
+    TS_ASSERT_DELTA(log->firstValue(), value, 1e-9);
+  }
+};
+
+
+#endif /* MANTID_LIVEDATA_LIVEINGESTCOUNTERSTEST_H_ */
@@ -58,7 +58,8 @@ public:
       std::string PostProcessingProperties = "",
       bool PreserveEvents = true,
       ILiveListener_sptr listener = ILiveListener_sptr(),
-      bool makeThrow = false
+      bool makeThrow = false,
+      bool PostProcessIncrementally = false
       )
   {
     FacilityHelper::ScopedFacilities loadTESTFacility("IDFs_for_UNIT_TESTING/UnitTestFacilities.xml", "TEST");
@@ -73,6 +74,7 @@ public:
     TS_ASSERT_THROWS_NOTHING( alg.setPropertyValue("PostProcessingAlgorithm", PostProcessingAlgorithm) );
     TS_ASSERT_THROWS_NOTHING( alg.setPropertyValue("PostProcessingProperties", PostProcessingProperties) );
     TS_ASSERT_THROWS_NOTHING( alg.setProperty("PreserveEvents", PreserveEvents) );
+    TS_ASSERT_THROWS_NOTHING( alg.setProperty("PostProcessIncrementally", PostProcessIncrementally) );
     if (!PostProcessingAlgorithm.empty())
       TS_ASSERT_THROWS_NOTHING( alg.setPropertyValue("AccumulationWorkspace", "fake_accum") );
     TS_ASSERT_THROWS_NOTHING( alg.setPropertyValue("OutputWorkspace", "fake") );
@@ -296,6 +298,32 @@ public:
     TSM_ASSERT( "Events are sorted", ws->getEventList(0).isSortedByTof());
   }
 
+  //--------------------------------------------------------------------------------------------
+  /** Post-process each chunk and add the results */
+  void test_add_PostProcessIncrementally()
+  {
+    EventWorkspace_sptr ws1 = doExec<EventWorkspace>("Add", "", "", "Rebin", "Params=40e3, 1e3, 60e3",
+                                                     true, ILiveListener_sptr(), false, true);
+    TS_ASSERT_EQUALS(ws1->getNumberEvents(), 200);
+    TS_ASSERT_EQUALS(ws1->blocksize(), 20);
+
+    EventWorkspace_sptr ws2 = doExec<EventWorkspace>("Add", "", "", "Rebin", "Params=40e3, 1e3, 60e3",
+                                                     true, ILiveListener_sptr(), false, true);
+    EventWorkspace_sptr ws_accum = AnalysisDataService::Instance().retrieveWS<EventWorkspace>("fake_accum");
+    TS_ASSERT( ws_accum )
+
+    // Both the accumulation and the output were added to in place
+    TSM_ASSERT( "Output workspace being added stayed the same pointer", ws1 == ws2 );
+    TS_ASSERT_EQUALS(ws_accum->getNumberEvents(), 400);
+    TS_ASSERT_EQUALS(ws_accum->blocksize(), 1);
+    TS_ASSERT_EQUALS(ws2->getNumberHistograms(), 2);
+    TS_ASSERT_EQUALS(ws2->getNumberEvents(), 400);
+    TS_ASSERT_EQUALS(ws2->blocksize(), 20);
+    TS_ASSERT_DELTA(ws2->dataX(0)[0], 40e3, 1e-4);
+    TS_ASSERT_EQUALS(AnalysisDataService::Instance().size(), 2);
+    TSM_ASSERT( "Events are sorted", ws2->getEventList(0).isSortedByTof());
+  }
+
   //--------------------------------------------------------------------------------------------
   /** Do some processing that converts to a different type of workspace */
   void test_ProcessToMDWorkspace_and_Add()
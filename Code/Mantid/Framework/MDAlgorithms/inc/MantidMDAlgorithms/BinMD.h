@@ -50,6 +50,9 @@ namespace MDAlgorithms
     virtual const std::string category() const { return "MDAlgorithms";}
 
   private:
+    /// Number of event centers transformed to the output coordinates with one call
+    enum {TRANSFORM_BLOCK_SIZE=1024};
+
     /// Initialise the properties
     void init();
     /// Run the algorithm
@@ -67,9 +70,17 @@ namespace MDAlgorithms
     template<typename MDE, size_t nd>
     void binMDBox(MDEvents::MDBox<MDE, nd> * box, const size_t * const chunkMin, const size_t * const chunkMax);
 
+    Mantid::Kernel::VMD toPreviousBinIndexes(const Mantid::Kernel::VMD & point) const;
+
+    bool copyPreviousOutput(std::vector<size_t> & overlapMin, std::vector<size_t> & overlapMax);
+
 
     /// The output MDHistoWorkspace
     Mantid::MDEvents::MDHistoWorkspace_sptr outWS;
+    /// Workspace binned before, whose bins overlapping with outWS are reused
+    Mantid::MDEvents::MDHistoWorkspace_sptr m_previousWS;
+    /// Number of points in the input workspace when the binning started
+    uint64_t m_inputNPoints;
     /// Progress reporting
     Mantid::API::Progress * prog;
     /// ImplicitFunction used
@@ -84,6 +84,8 @@ namespace MDAlgorithms
        bool doWeNeedNewTargetWorkspace(API::IMDEventWorkspace_sptr spws);
       /**Create new MD workspace using existing parameters for algorithm */
         API::IMDEventWorkspace_sptr createNewMDWorkspace(const MDEvents::MDWSDescription &NewMDWSDescription);
+      /**Make new MD workspace file-backed */
+        void setUpFileBackEnd(API::IMDEventWorkspace_sptr spws,const std::string &filename);
 
         bool buildTargetWSDescription(API::IMDEventWorkspace_sptr spws,const std::string &Q_mod_req,const std::string &dEModeRequested,const std::vector<std::string> &other_dim_names,
                                       std::vector<double> &dimMin,std::vector<double> &dimMax,
@@ -44,7 +44,11 @@ namespace DataObjects
       virtual int version() const;
       virtual const std::string category() const;
       virtual const std::string summary() const;
-      
+
+    protected:
+      /// Largest total size in bytes of the per-thread copies of the normalization grid
+      size_t m_maxPartialGridsMemory;
+
     private:
       void init();
       void exec();
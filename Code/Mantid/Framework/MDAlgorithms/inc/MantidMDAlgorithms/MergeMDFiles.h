@@ -68,7 +68,9 @@ namespace MDAlgorithms
     void finalizeOutput(const std::string &outputFile);
 
 
-    uint64_t loadEventsFromSubBoxes(API::IMDNode *TargetBox);
+    size_t findBlockEnd(const std::vector<API::IMDNode *> &leafBoxes, size_t blockStart)const;
+
+    uint64_t loadEventsFromSubBoxes(const std::vector<API::IMDNode *> &leafBoxes, size_t blockStart, size_t blockEnd, bool parallel);
 
     // the class which flatten the box structure and deal with it
     MDEvents::MDBoxFlatTree m_BoxStruct;
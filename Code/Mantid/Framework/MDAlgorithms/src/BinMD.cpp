@@ -14,12 +14,16 @@
 #include "MantidMDEvents/MDHistoWorkspace.h"
 #include "MantidMDAlgorithms/BinMD.h"
 #include <boost/algorithm/string.hpp>
+#include <boost/math/special_functions/fpclassify.hpp>
 #include <Poco/DOM/Document.h>
 #include <Poco/DOM/DOMParser.h>
 #include <Poco/DOM/Element.h>
 #include "MantidKernel/EnabledWhenProperty.h"
 #include "MantidMDEvents/CoordTransformAffine.h"
 
+#include <algorithm>
+#include <cmath>
+
 using Mantid::Kernel::CPUTimer;
 using Mantid::Kernel::EnabledWhenProperty;
 
@@ -36,11 +40,18 @@ namespace MDAlgorithms
   using namespace Mantid::Geometry;
   using namespace Mantid::MDEvents;
 
+  namespace
+  {
+    /// Log of the output workspace holding the number of points the input workspace had when binned
+    const char * INPUT_NPOINTS_LOG = "BinMD_InputNPoints";
+  }
+
 
   //----------------------------------------------------------------------------------------------
   /** Constructor
    */
   BinMD::BinMD()
+  : m_inputNPoints(0)
   {
   }
 
@@ -79,6 +90,13 @@ namespace MDAlgorithms
         "Temporary parameter: true to run in parallel. This is ignored for file-backed workspaces, where running in parallel makes things slower due to disk thrashing.");
     setPropertyGroup("Parallel", grp);
 
+    declareProperty(new WorkspaceProperty<IMDHistoWorkspace>("PreviousOutputWorkspace","",Direction::Input, PropertyMode::Optional),
+        "An MDHistoWorkspace binned before from the same InputWorkspace without an implicit function.\n"
+        "If its bins lie on the same grid as the new ones (e.g. the view was only panned or extended), the overlapping bins are copied\n"
+        "and only the events of the remaining bins are binned. It is ignored if the number of points of the InputWorkspace has changed\n"
+        "since, or if the grids do not match.");
+    setPropertyGroup("PreviousOutputWorkspace", grp);
+
     declareProperty(new WorkspaceProperty<Workspace>("OutputWorkspace","",Direction::Output), "A name for the output MDHistoWorkspace.");
 
   }
@@ -95,9 +113,6 @@ namespace MDAlgorithms
   template<typename MDE, size_t nd>
   inline void BinMD::binMDBox(MDBox<MDE, nd> * box, const size_t * const chunkMin, const size_t * const chunkMax)
   {
-    // An array to hold the rotated/transformed coordinates
-    coord_t * outCenter = new coord_t[m_outD];
-
     // Evaluate whether the entire box is in the same bin
     if (box->getNPoints() > (1 << nd) * 2)
     {
@@ -105,18 +120,17 @@ namespace MDAlgorithms
       size_t numVertexes = 0;
       coord_t * vertexes = box->getVertexesArray(numVertexes);
 
+      // Transform all the vertexes to the output dimensions at once
+      std::vector<coord_t> outVertexes(numVertexes * m_outD);
+      m_transform->applyMany(vertexes, outVertexes.data(), numVertexes);
+
       // All vertexes have to be within THE SAME BIN = have the same linear index.
       size_t lastLinearIndex = 0;
       bool badOne = false;
 
       for (size_t i=0; i<numVertexes; i++)
       {
-        // Cache the center of the event (again for speed)
-        const coord_t * inCenter = vertexes + i * nd;
-
-        // Now transform to the output dimensions
-        m_transform->apply(inCenter, outCenter);
-        //std::cout << "Input coord " << VMD(nd,inCenter) << " transformed to " <<  VMD(nd,outCenter) << std::endl;
+        const coord_t * outCenter = outVertexes.data() + i * m_outD;
 
         // To build up the linear index
         size_t linearIndex = 0;
@@ -173,7 +187,6 @@ namespace MDAlgorithms
         numEvents[lastLinearIndex] += static_cast<signal_t>(box->getNPoints());
 
         // And don't bother looking at each event. This may save lots of time loading from disk.
-        delete [] outCenter;
         return;
       }
     }
@@ -182,56 +195,194 @@ namespace MDAlgorithms
     // So you need to iterate through events.
 
     const std::vector<MDE> & events = box->getConstEvents();
-    typename std::vector<MDE>::const_iterator it = events.begin();
-    typename std::vector<MDE>::const_iterator it_end = events.end();
-    for (; it != it_end; it++)
+    // The event centers are transformed in blocks with one call to the transformation
+    const size_t numBoxEvents = events.size();
+    const size_t blockSize = std::min(numBoxEvents, size_t(TRANSFORM_BLOCK_SIZE));
+    std::vector<coord_t> inCenters(blockSize * nd);
+    std::vector<coord_t> outCenters(blockSize * m_outD);
+    for (size_t blockStart=0; blockStart < numBoxEvents; blockStart += blockSize)
     {
-      // Cache the center of the event (again for speed)
-      const coord_t * inCenter = it->getCenter();
-
+      const size_t numInBlock = std::min(blockSize, numBoxEvents - blockStart);
+      for (size_t i=0; i<numInBlock; i++)
+      {
+        const coord_t * inCenter = events[blockStart + i].getCenter();
+        std::copy(inCenter, inCenter + nd, inCenters.begin() + i * nd);
+      }
       // Now transform to the output dimensions
-      m_transform->apply(inCenter, outCenter);
+      m_transform->applyMany(inCenters.data(), outCenters.data(), numInBlock);
 
-      // To build up the linear index
-      size_t linearIndex = 0;
-      // To mark events outside range
-      bool badOne = false;
-
-      /// Loop through the dimensions on which we bin
-      for (size_t bd=0; bd<m_outD; bd++)
+      for (size_t i=0; i<numInBlock; i++)
       {
-        // What is the bin index in that dimension
-        coord_t x = outCenter[bd];
-        size_t ix = size_t(x);
-        // Within range (for this chunk)?
-        if ((x >= 0) && (ix >= chunkMin[bd]) && (ix < chunkMax[bd]))
+        const MDE & event = events[blockStart + i];
+        const coord_t * outCenter = outCenters.data() + i * m_outD;
+
+        // To build up the linear index
+        size_t linearIndex = 0;
+        // To mark events outside range
+        bool badOne = false;
+
+        /// Loop through the dimensions on which we bin
+        for (size_t bd=0; bd<m_outD; bd++)
         {
-          // Build up the linear index
-          linearIndex += indexMultiplier[bd] * ix;
-        }
-        else
+          // What is the bin index in that dimension
+          coord_t x = outCenter[bd];
+          size_t ix = size_t(x);
+          // Within range (for this chunk)?
+          if ((x >= 0) && (ix >= chunkMin[bd]) && (ix < chunkMax[bd]))
+          {
+            // Build up the linear index
+            linearIndex += indexMultiplier[bd] * ix;
+          }
+          else
+          {
+            // Outside the range
+            badOne = true;
+            break;
+          }
+        } // (for each dim in MDHisto)
+
+        if (!badOne)
         {
-          // Outside the range
-          badOne = true;
-          break;
+          // Sum the signals as doubles to preserve precision
+          signals[linearIndex] += static_cast<signal_t>(event.getSignal());
+          errors[linearIndex] += static_cast<signal_t>(event.getErrorSquared());
+          // TODO: If MDEvents get a weight, this would need to get the summed weight.
+          numEvents[linearIndex] += 1.0;
         }
-      } // (for each dim in MDHisto)
-
-      if (!badOne)
-      {
-        // Sum the signals as doubles to preserve precision
-        signals[linearIndex] += static_cast<signal_t>(it->getSignal());
-        errors[linearIndex] += static_cast<signal_t>(it->getErrorSquared());
-        // TODO: If MDEvents get a weight, this would need to get the summed weight.
-        numEvents[linearIndex] += 1.0;
       }
     }
     // Done with the events list
     box->releaseEvents();
+  }
 
-    delete [] outCenter;
+
+  //----------------------------------------------------------------------------------------------
+  /** Convert a point of the input workspace into the (fractional) bin indexes of
+   * the previous output workspace
+   *
+   * @param point :: point in the coordinates of the input workspace
+   * @return the position of the point in the bins of PreviousOutputWorkspace
+   */
+  VMD BinMD::toPreviousBinIndexes(const VMD & point) const
+  {
+    VMD inPrevious = m_previousWS->getTransformFromOriginal(0)->applyVMD(point);
+    for (size_t d=0; d<m_outD; d++)
+    {
+      IMDDimension_const_sptr dim = m_previousWS->getDimension(d);
+      inPrevious[d] = (inPrevious[d] - dim->getMinimum()) / dim->getBinWidth();
+    }
+    return inPrevious;
   }
 
+  //----------------------------------------------------------------------------------------------
+  /** Copy the bins of PreviousOutputWorkspace which overlap with the output workspace,
+   * if the previous workspace was binned from the same workspace on the same grid of bins,
+   * maybe shifted by a whole number of bins.
+   *
+   * @param overlapMin :: set to the first copied bin index in each dimension of the output workspace
+   * @param overlapMax :: set to the bin index after the last copied one in each dimension
+   * @return true if the overlapping bins were copied; false if nothing could be reused
+   */
+  bool BinMD::copyPreviousOutput(std::vector<size_t> & overlapMin, std::vector<size_t> & overlapMax)
+  {
+    // The previous output keeps NaNs where the implicit function was applied.
+    if (!m_previousWS || implicitFunction)
+      return false;
+    if (m_previousWS->getNumDims() != m_outD || m_previousWS->getNumberTransformsFromOriginal() == 0)
+      return false;
+    if (m_previousWS->getOriginalWorkspace(0) != m_inWS || !m_previousWS->getTransformFromOriginal(0))
+      return false;
+    // The input may have been changed in place since (e.g. live data): only reuse the bins if it
+    // still has the number of points it had then
+    if (m_previousWS->getNumExperimentInfo() == 0)
+      return false;
+    const Run & previousRun = m_previousWS->getExperimentInfo(0)->run();
+    if (!previousRun.hasProperty(INPUT_NPOINTS_LOG) ||
+        previousRun.getPropertyValueAsType<uint64_t>(INPUT_NPOINTS_LOG) != m_inputNPoints)
+      return false;
+    // The same bases also mean the same dimensions are integrated over
+    for (size_t d=0; d<m_outD; d++)
+      if (m_previousWS->getBasisVector(d) != m_bases[d])
+        return false;
+
+    // Bin indexes of both workspaces have to differ by the same whole number of bins everywhere,
+    // which is checked at the origin and one step along each basis vector.
+    const double tolerance = 1e-3;
+    VMD originInOutput = m_transform->applyVMD(m_translation);
+    VMD originInPrevious = toPreviousBinIndexes(m_translation);
+    std::vector<int64_t> offset(m_outD);
+    for (size_t d=0; d<m_outD; d++)
+    {
+      double shift = originInPrevious[d] - originInOutput[d];
+      double rounded = std::floor(shift + 0.5);
+      if (std::fabs(shift - rounded) > tolerance)
+        return false;
+      offset[d] = static_cast<int64_t>(rounded);
+
+      VMD step = m_translation + m_bases[d];
+      VMD stepInOutput = m_transform->applyVMD(step) - originInOutput;
+      VMD stepInPrevious = toPreviousBinIndexes(step) - originInPrevious;
+      for (size_t dd=0; dd<m_outD; dd++)
+      {
+        if (std::fabs(stepInPrevious[dd] - stepInOutput[dd]) > tolerance * std::max(1.0, std::fabs(double(stepInOutput[dd]))))
+          return false;
+      }
+    }
+
+    // The overlapping bins (indexes in the output workspace)
+    overlapMin.resize(m_outD);
+    overlapMax.resize(m_outD);
+    std::vector<size_t> previousMultiplier(m_outD, 1);
+    for (size_t d=0; d<m_outD; d++)
+    {
+      int64_t nBins = static_cast<int64_t>(m_binDimensions[d]->getNBins());
+      int64_t nPreviousBins = static_cast<int64_t>(m_previousWS->getDimension(d)->getNBins());
+      int64_t first = std::max(int64_t(0), -offset[d]);
+      int64_t last = std::min(nBins, nPreviousBins - offset[d]);
+      if (first >= last)
+        return false;
+      overlapMin[d] = static_cast<size_t>(first);
+      overlapMax[d] = static_cast<size_t>(last);
+      if (d > 0)
+        previousMultiplier[d] = m_previousWS->getIndexMultiplier()[d-1];
+    }
+
+    const signal_t * previousSignals = m_previousWS->getSignalArray();
+    const signal_t * previousErrors = m_previousWS->getErrorSquaredArray();
+    const signal_t * previousNumEvents = m_previousWS->getNumEventsArray();
+    std::vector<size_t> nBins(m_outD);
+    for (size_t d=0; d<m_outD; d++)
+      nBins[d] = m_binDimensions[d]->getNBins();
+    std::vector<size_t> index(m_outD);
+    const size_t numPoints = static_cast<size_t>(outWS->getNPoints());
+    for (size_t linearIndex=0; linearIndex < numPoints; linearIndex++)
+    {
+      Utils::getIndicesFromLinearIndex(linearIndex, nBins.data(), m_outD, index.data());
+      size_t previousIndex = 0;
+      bool inOverlap = true;
+      for (size_t d=0; d<m_outD; d++)
+      {
+        if (index[d] < overlapMin[d] || index[d] >= overlapMax[d])
+        {
+          inOverlap = false;
+          break;
+        }
+        previousIndex += previousMultiplier[d] * static_cast<size_t>(static_cast<int64_t>(index[d]) + offset[d]);
+      }
+      if (!inOverlap)
+        continue;
+      if (boost::math::isnan(previousSignals[previousIndex]))
+      {
+        // Masked or produced with an implicit function: cannot be reused
+        outWS->setTo(0.0, 0.0, 0.0);
+        return false;
+      }
+      signals[linearIndex] = previousSignals[previousIndex];
+      errors[linearIndex] = previousErrors[previousIndex];
+      numEvents[linearIndex] = previousNumEvents[previousIndex];
+    }
+    return true;
+  }
 
   //----------------------------------------------------------------------------------------------
   /** Perform binning by iterating through every event and placing them in the output workspace
@@ -264,52 +415,94 @@ namespace MDAlgorithms
     // Start with signal/error/numEvents at 0.0
     outWS->setTo(0.0, 0.0, 0.0);
 
-    // The dimension (in the output workspace) along which we chunk for parallel processing
-    // TODO: Find the smartest dimension to chunk against
-    size_t chunkDimension = 0;
-
-    // How many bins (in that dimension) per chunk.
-    // Try to split it so each core will get 2 tasks:
-    int chunkNumBins =  int(m_binDimensions[chunkDimension]->getNBins() / (PARALLEL_GET_MAX_THREADS*2));
-    if (chunkNumBins < 1) chunkNumBins = 1;
-
     // Do we actually do it in parallel?
     bool doParallel = getProperty("Parallel");
     // Not if file-backed!
     if (bc->isFileBacked()) doParallel = false;
-    if (!doParallel)
-      chunkNumBins = int(m_binDimensions[chunkDimension]->getNBins());
+
+    // The regions of the output workspace (minimum and maximum bin index in each dimension) to bin
+    std::vector<std::vector<size_t> > regionMin;
+    std::vector<std::vector<size_t> > regionMax;
+
+    std::vector<size_t> overlapMin, overlapMax;
+    if (this->copyPreviousOutput(overlapMin, overlapMax))
+    {
+      // Only the bins around the copied ones are binned, split into slabs which do not overlap
+      for (size_t bd=0; bd<m_outD; bd++)
+      {
+        std::vector<size_t> slabMin(m_outD), slabMax(m_outD);
+        for (size_t d=0; d<m_outD; d++)
+        {
+          // Dimensions before the slab one are limited to the overlap, so the slabs do not intersect
+          slabMin[d] = (d < bd) ? overlapMin[d] : 0;
+          slabMax[d] = (d < bd) ? overlapMax[d] : m_binDimensions[d]->getNBins();
+        }
+        if (overlapMin[bd] > 0)
+        {
+          slabMax[bd] = overlapMin[bd];
+          regionMin.push_back(slabMin);
+          regionMax.push_back(slabMax);
+        }
+        if (overlapMax[bd] < m_binDimensions[bd]->getNBins())
+        {
+          slabMin[bd] = overlapMax[bd];
+          slabMax[bd] = m_binDimensions[bd]->getNBins();
+          regionMin.push_back(slabMin);
+          regionMax.push_back(slabMax);
+        }
+      }
+      g_log.debug() << "Reused the overlapping bins of the previous output, binning " << regionMin.size() << " regions." << std::endl;
+    }
+    else
+    {
+      // The dimension (in the output workspace) along which we chunk for parallel processing
+      // TODO: Find the smartest dimension to chunk against
+      size_t chunkDimension = 0;
+      size_t nChunkBins = m_binDimensions[chunkDimension]->getNBins();
+
+      // How many bins (in that dimension) per chunk.
+      // Try to split it so each core will get 2 tasks:
+      size_t chunkNumBins =  nChunkBins / static_cast<size_t>(PARALLEL_GET_MAX_THREADS*2);
+      if (chunkNumBins < 1) chunkNumBins = 1;
+      if (!doParallel)
+        chunkNumBins = nChunkBins;
+
+      for (size_t chunk=0; chunk < nChunkBins; chunk += chunkNumBins)
+      {
+        // Region of interest for this chunk.
+        std::vector<size_t> chunkMin(m_outD);
+        std::vector<size_t> chunkMax(m_outD);
+        for (size_t bd=0; bd<m_outD; bd++)
+        {
+          // Same limits in the other dimensions
+          chunkMin[bd] = 0;
+          chunkMax[bd] = m_binDimensions[bd]->getNBins();
+        }
+        // Parcel out a chunk in that single dimension dimension
+        chunkMin[chunkDimension] = chunk;
+        chunkMax[chunkDimension] = std::min(chunk+chunkNumBins, nChunkBins);
+        regionMin.push_back(chunkMin);
+        regionMax.push_back(chunkMax);
+      }
+    }
 
     // Total number of steps
     size_t progNumSteps = 0;
     if (prog) prog->setNotifyStep(0.1);
     if (prog) prog->resetNumSteps(100, 0.00, 1.0);
 
-    // Run the chunks in parallel. There is no overlap in the output workspace so it is
+    // Run the regions in parallel. There is no overlap in the output workspace so it is
     // thread safe to write to it..
     // cppcheck-suppress syntaxError
     PRAGMA_OMP( parallel for schedule(dynamic,1) if (doParallel) )
-    for(int chunk=0; chunk < int(m_binDimensions[chunkDimension]->getNBins()); chunk += chunkNumBins)
+    for(int region=0; region < int(regionMin.size()); region++)
     {
       PARALLEL_START_INTERUPT_REGION
-      // Region of interest for this chunk.
-      std::vector<size_t> chunkMin(m_outD);
-      std::vector<size_t> chunkMax(m_outD);
-      for (size_t bd=0; bd<m_outD; bd++)
-      {
-        // Same limits in the other dimensions
-        chunkMin[bd] = 0;
-        chunkMax[bd] = m_binDimensions[bd]->getNBins();
-      }
-      // Parcel out a chunk in that single dimension dimension
-      chunkMin[chunkDimension] = size_t(chunk);
-      if (size_t(chunk+chunkNumBins) > m_binDimensions[chunkDimension]->getNBins())
-        chunkMax[chunkDimension] = m_binDimensions[chunkDimension]->getNBins();
-      else
-        chunkMax[chunkDimension] = size_t(chunk+chunkNumBins);
+      const size_t * const chunkMin = regionMin[region].data();
+      const size_t * const chunkMax = regionMax[region].data();
 
       // Build an implicit function (it needs to be in the space of the MDEventWorkspace)
-      MDImplicitFunction * function = this->getImplicitFunctionForChunk(chunkMin.data(), chunkMax.data());
+      MDImplicitFunction * function = this->getImplicitFunctionForChunk(chunkMin, chunkMax);
 
       // Use getBoxes() to get an array with a pointer to each box
       std::vector<API::IMDNode *> boxes;
@@ -325,19 +518,19 @@ namespace MDAlgorithms
       {
         PARALLEL_CRITICAL(BinMD_progress)
         {
-          g_log.debug() << "Chunk " << chunk << ": found " << boxes.size() << " boxes within the implicit function." << std::endl;
+          g_log.debug() << "Region " << region << ": found " << boxes.size() << " boxes within the implicit function." << std::endl;
           progNumSteps += boxes.size();
           prog->setNumSteps( progNumSteps );
         }
       }
 
-      // Go through every box for this chunk.
+      // Go through every box for this region.
       for (size_t i=0; i<boxes.size(); i++)
       {
         MDBox<MDE,nd> * box = dynamic_cast<MDBox<MDE,nd> *>(boxes[i]);
         // Perform the binning in this separate method.
         if (box)
-          this->binMDBox(box, chunkMin.data(), chunkMax.data());
+          this->binMDBox(box, chunkMin, chunkMax);
 
         // Progress reporting
         if (prog) prog->report();
@@ -346,7 +539,7 @@ namespace MDAlgorithms
           break;
       }// for each box in the vector
       PARALLEL_END_INTERUPT_REGION
-    } // for each chunk in parallel
+    } // for each region in parallel
     PARALLEL_CHECK_INTERUPT_REGION
 
 
@@ -380,6 +573,10 @@ namespace MDAlgorithms
     if (!ImplicitFunctionXML.empty())
       implicitFunction = Mantid::API::ImplicitFunctionFactory::Instance().createUnwrapped(ImplicitFunctionXML);
 
+    IMDHistoWorkspace_sptr previousWS = getProperty("PreviousOutputWorkspace");
+    m_previousWS = boost::dynamic_pointer_cast<MDHistoWorkspace>(previousWS);
+    m_inputNPoints = m_inWS->getNPoints();
+
   
     prog = new Progress(this, 0, 1.0, 1); // This gets deleted by the thread pool; don't delete it in here.
 
@@ -416,6 +613,9 @@ namespace MDAlgorithms
     IMDEventWorkspace_sptr inEWS = boost::dynamic_pointer_cast<IMDEventWorkspace>(m_inWS);
     if (inEWS)
       outWS->copyExperimentInfos( *inEWS );
+    // Remember how many points were binned, to check whether the output can be reused later
+    if (outWS->getNumExperimentInfo() > 0)
+      outWS->getExperimentInfo(0)->mutableRun().addProperty(INPUT_NPOINTS_LOG, m_inputNPoints, true);
 
     outWS->updateSum();
     // Save the output
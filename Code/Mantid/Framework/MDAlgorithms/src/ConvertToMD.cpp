@@ -8,6 +8,7 @@
 #include "MantidKernel/ArrayLengthValidator.h"
 #include "MantidKernel/VisibleWhenProperty.h"
 //
+#include "MantidAPI/FileProperty.h"
 #include "MantidAPI/IMDEventWorkspace.h"
 #include "MantidAPI/Progress.h"
 #include "MantidAPI/WorkspaceValidators.h"
@@ -75,6 +76,18 @@ namespace Mantid
         "property is necessary if one wants to generate multiple file based workspaces in order to merge them later.");
       setPropertyGroup("MinRecursionDepth", getBoxSettingsGroupName());
 
+      std::vector<std::string> exts(1,".nxs");
+      declareProperty(new FileProperty("OutputFilename", "", FileProperty::OptionalSave, exts),
+        "Optional: Specify a NeXus file to write if you want the new output workspace to be file-backed. "
+        "The events are written to the file while the conversion runs, so the workspace does not have to fit into memory.");
+
+      declareProperty(new PropertyWithValue<int>("Memory", -1),
+        "If OutputFilename is specified to use a file back end:\n"
+        "  The amount of memory (in MB) the converted events may occupy before they are written to the file.\n"
+        "  If not specified, the default write buffer size of the file back end is used.");
+
+      setPropertyGroup("OutputFilename", "File Back-End");
+      setPropertyGroup("Memory", "File Back-End");
     }
     //----------------------------------------------------------------------------------------------
     /** Destructor
@@ -200,9 +213,24 @@ namespace Mantid
       m_Progress.reset(new API::Progress(this,0.0,1.0,n_steps)); 
 
       g_log.information()<<" conversion started\n";
+      // set up the file back end for a new workspace if requested
+      std::string filename = getProperty("OutputFilename");
+      if(createNewTargetWs && !filename.empty())
+        this->setUpFileBackEnd(spws,filename);
+
       //DO THE JOB:
       this->m_Convertor->runConversion(m_Progress.get());
 
+      if(spws->isFileBacked())
+      {
+        // write the remaining events and the box structure to the file
+        g_log.information()<<" Running SaveMD to update the file back-end\n";
+        IAlgorithm_sptr saver = createChildAlgorithm("SaveMD");
+        saver->setProperty("UpdateFileBackEnd", true);
+        saver->setProperty("InputWorkspace", spws);
+        saver->executeAsChildAlg();
+      }
+
 
       //JOB COMPLETED:
       setProperty("OutputWorkspace", boost::dynamic_pointer_cast<IMDEventWorkspace>(spws));
@@ -444,6 +472,41 @@ namespace Mantid
 
     }
 
+    /** Make the new target workspace file-backed and size its write buffer.
+    * The converters split the boxes and write the events to the file at least every time the number of events added
+    * exceeds the write buffer, so the buffer size controls the memory used by the conversion.
+    *
+    *@param spws     -- shared pointer to the new, empty target workspace
+    *@param filename -- the name of the NeXus file to create
+    */
+    void ConvertToMD::setUpFileBackEnd(API::IMDEventWorkspace_sptr spws,const std::string &filename)
+    {
+      g_log.information()<<" Running SaveMD to create file back-end\n";
+      IAlgorithm_sptr saver = createChildAlgorithm("SaveMD");
+      saver->setPropertyValue("Filename", filename);
+      saver->setProperty("InputWorkspace", spws);
+      saver->setProperty("MakeFileBacked", true);
+      saver->executeAsChildAlg();
+
+      Mantid::API::BoxController_sptr bc = spws->getBoxController();
+      if(!bc->isFileBacked())
+        throw std::runtime_error("ConvertToMD with file-backed output: Can not set up file-backed output workspace ");
+
+      auto IOptr = bc->getFileIO();
+      uint64_t bufSize = IOptr->getWriteBufferSize();
+      int memory = getProperty("Memory");
+      if(memory>0)
+      {
+        // an MDEvent keeps its coordinates, signal, error, run index and detector ID
+        uint64_t eventSize = uint64_t(sizeof(coord_t)*(spws->getNumDims()+4));
+        bufSize = uint64_t(memory)*1024*1024/eventSize;
+      }
+      // a reasonable buffer holds at least 10 data chunks
+      if(bufSize<10*IOptr->getDataChunk())
+        bufSize = 10*IOptr->getDataChunk();
+      IOptr->setWriteBufferSize(bufSize);
+    }
+
     /**Check if the target workspace new or exists and we need to create new workspace
     *@param spws -- shared pointer to target MD workspace, which can be undefined if the workspace does not exist
     *
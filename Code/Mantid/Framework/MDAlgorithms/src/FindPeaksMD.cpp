@@ -7,8 +7,10 @@
 
 #include <boost/math/special_functions/fpclassify.hpp>
 #include <boost/type_traits/integral_constant.hpp>
+#include <boost/unordered_map.hpp>
 
-#include <map>
+#include <algorithm>
+#include <cmath>
 #include <vector>
 
 using namespace Mantid::Kernel;
@@ -109,6 +111,117 @@ namespace MDAlgorithms
       addDetectors(peak, box, IsFullEvent<MDE,nd>());
     }
 
+    /// Pair of <density, box>, sorted by increasing density only
+    template<typename BoxType>
+    bool compareDensity(const std::pair<double, BoxType> & a, const std::pair<double, BoxType> & b)
+    {
+      return a.first < b.first;
+    }
+
+    /**
+     * Keeps the centers of the peaks found so far, bucketed on a grid over the first 3
+     * dimensions with cells as wide as the peak distance threshold. A new candidate then only
+     * needs to be compared to the centers in the 27 cells around it instead of to all of them.
+     */
+    class PeakCenterGrid
+    {
+    public:
+      /**
+       * @param nd :: Number of dimensions of the centers
+       * @param radiusSquared :: Centers closer than the square root of this are too close
+       */
+      PeakCenterGrid(const size_t nd, const coord_t radiusSquared)
+        : m_nd(nd), m_radiusSquared(radiusSquared),
+          // Slightly wider than the threshold so that rounding cannot hide a neighbour two cells away
+          m_cellSize(1.001 * std::sqrt(static_cast<double>(radiusSquared))),
+          m_centers(), m_cells()
+      {
+      }
+
+      /**
+       * @param center :: nd coordinates of the candidate center
+       * @return true if the center is closer than the threshold to a center already added
+       */
+      bool isTooClose(const coord_t * center) const
+      {
+        int64_t cell[3];
+        if (!getCell(center, cell))
+          return false;
+        for (int64_t i=-1; i<=1; ++i)
+          for (int64_t j=-1; j<=1; ++j)
+            for (int64_t k=-1; k<=1; ++k)
+            {
+              auto it = m_cells.find(makeKey(cell[0]+i, cell[1]+j, cell[2]+k));
+              if (it == m_cells.end())
+                continue;
+              for (auto index = it->second.begin(); index != it->second.end(); ++index)
+              {
+                const coord_t * otherCenter = &m_centers[*index * m_nd];
+                // Distance between this box and a box we already put in.
+                coord_t distSquared = 0.0;
+                for (size_t d=0; d<m_nd; d++)
+                {
+                  coord_t dist = otherCenter[d] - center[d];
+                  distSquared += (dist * dist);
+                }
+                if (distSquared < m_radiusSquared)
+                  return true;
+              }
+            }
+        return false;
+      }
+
+      /**
+       * @param center :: nd coordinates of an accepted peak center
+       */
+      void add(const coord_t * center)
+      {
+        int64_t cell[3];
+        // A center that is not finite can never be too close to another one
+        if (!getCell(center, cell))
+          return;
+        m_cells[makeKey(cell[0], cell[1], cell[2])].push_back(m_centers.size() / m_nd);
+        m_centers.insert(m_centers.end(), center, center + m_nd);
+      }
+
+    private:
+      /// Find the grid cell of a center. Returns false if it cannot be too close to anything.
+      bool getCell(const coord_t * center, int64_t * cell) const
+      {
+        if (!(m_radiusSquared > 0))
+          return false;
+        for (size_t d=0; d<m_nd; d++)
+          if (!boost::math::isfinite(center[d]))
+            return false;
+        for (size_t d=0; d<3; d++)
+        {
+          // Clamp far away cells together, it only adds candidates to compare
+          double index = std::floor(static_cast<double>(center[d]) / m_cellSize);
+          index = std::max(-1e15, std::min(1e15, index));
+          cell[d] = static_cast<int64_t>(index);
+        }
+        return true;
+      }
+
+      /// Pack the 3 cell indexes in one key. Wrapped indexes only add candidates to compare.
+      static int64_t makeKey(const int64_t x, const int64_t y, const int64_t z)
+      {
+        const int64_t mask = (int64_t(1) << 21) - 1;
+        return ((x & mask) << 42) | ((y & mask) << 21) | (z & mask);
+      }
+
+      /// Number of dimensions
+      size_t m_nd;
+      /// Square of the peak distance threshold
+      coord_t m_radiusSquared;
+      /// Width of the grid cells
+      double m_cellSize;
+      /// Coordinates of the centers added, nd per center
+      std::vector<coord_t> m_centers;
+      /// Indexes of the centers in each occupied cell
+      boost::unordered_map<int64_t, std::vector<size_t> > m_cells;
+    };
+
   }
 
 
@@ -310,21 +423,24 @@ namespace MDAlgorithms
     // This pair is the <density, ptr to the box>
     typedef std::pair<double,  API::IMDNode *> dens_box;
 
-    // Map that will sort the boxes by increasing density. The key = density; value = box *.
-    typename std::multimap<double, API::IMDNode *> sortedBoxes;
-
     // --------------- Sort and Filter by Density -----------------------------
     progress(0.20, "Sorting Boxes by Density");
-    auto  it1= boxes.begin();
-    auto  it1_end = boxes.end();
-    for (; it1 != it1_end; it1++)
+    const int numBoxes = static_cast<int>(boxes.size());
+    std::vector<double> densities(boxes.size());
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int i=0; i<numBoxes; i++)
+      densities[i] = boxes[i]->getSignalNormalized() * m_densityScaleFactor;
+
+    // Flat array of the boxes dense enough, sorted by increasing density.
+    // The sort is stable so boxes of equal density keep the order they were found in.
+    std::vector<dens_box> sortedBoxes;
+    for (size_t i=0; i<boxes.size(); i++)
     {
-      auto box = *it1;
-      double density = box->getSignalNormalized() * m_densityScaleFactor;
       // Skip any boxes with too small a signal density.
-      if (density > thresholdDensity)
-        sortedBoxes.insert(dens_box(density,box));
+      if (densities[i] > thresholdDensity)
+        sortedBoxes.push_back(dens_box(densities[i], boxes[i]));
     }
+    std::stable_sort(sortedBoxes.begin(), sortedBoxes.end(), compareDensity<API::IMDNode *>);
 
     // --------------- Find Peak Boxes -----------------------------
     // List of chosen possible peak boxes.
@@ -335,11 +451,14 @@ namespace MDAlgorithms
     // used for selecting method for calculating BinCount
     bool isMDEvent(ws->id().find("MDEventWorkspace") != std::string::npos);
 
+    // Centers of the boxes already picked
+    PeakCenterGrid pickedCenters(nd, peakRadiusSquared);
+
     int64_t numBoxesFound = 0;
-    // Now we go (backwards) through the map
+    // Now we go (backwards) through the array
     // e.g. from highest density down to lowest density.
-    typename std::multimap<double, boxPtr>::reverse_iterator it2;
-    typename std::multimap<double, boxPtr>::reverse_iterator it2_end = sortedBoxes.rend();
+    typename std::vector<dens_box>::reverse_iterator it2;
+    typename std::vector<dens_box>::reverse_iterator it2_end = sortedBoxes.rend();
     for (it2 = sortedBoxes.rbegin(); it2 != it2_end; it2++)
     {
       signal_t density = it2->first;
@@ -351,33 +470,8 @@ namespace MDAlgorithms
       const coord_t * boxCenter = box->getCentroid();
 #endif
 
-      // Compare to all boxes already picked.
-      bool badBox = false;
-      for (typename std::vector<boxPtr>::iterator it3=peakBoxes.begin(); it3 != peakBoxes.end(); it3++)
-      {
-
-#ifndef MDBOX_TRACK_CENTROID
-        coord_t otherCenter[nd];
-        (*it3)->calculateCentroid(otherCenter);
-#else
-        const coord_t * otherCenter = (*it3)->getCentroid();
-#endif
-
-        // Distance between this box and a box we already put in.
-        coord_t distSquared = 0.0;
-        for (size_t d=0; d<nd; d++)
-        {
-          coord_t dist = otherCenter[d] - boxCenter[d];
-          distSquared += (dist * dist);
-        }
-
-        // Reject this box if it is too close to another previously found box.
-        if (distSquared < peakRadiusSquared)
-        {
-          badBox = true;
-          break;
-        }
-      }
+      // Reject this box if it is too close to another previously found box.
+      bool badBox = pickedCenters.isTooClose(boxCenter);
 
       // The box was not rejected for another reason.
       if (!badBox)
@@ -389,6 +483,7 @@ namespace MDAlgorithms
         }
 
         peakBoxes.push_back(box);
+        pickedCenters.add(boxCenter);
         g_log.debug() << "Found box at ";
         for (size_t d=0; d<nd; d++)
           g_log.debug() << (d>0?",":"") << boxCenter[d];
@@ -465,9 +560,6 @@ namespace MDAlgorithms
     // This pair is the <density, box index>
     typedef std::pair<double, size_t> dens_box;
 
-    // Map that will sort the boxes by increasing density. The key = density; value = box index.
-    std::multimap<double, size_t> sortedBoxes;
-
     size_t numBoxes = ws->getNPoints();
 
     // --------- Count the overall signal density -----------------------------
@@ -488,13 +580,21 @@ namespace MDAlgorithms
 
     // -------------- Sort and Filter by Density -----------------------------
     progress(0.20, "Sorting Boxes by Density");
+    std::vector<double> densities(numBoxes);
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int i=0; i<static_cast<int>(numBoxes); i++)
+      densities[i] = ws->getSignalNormalizedAt(static_cast<size_t>(i)) * m_densityScaleFactor;
+
+    // Flat array of the boxes dense enough, sorted by increasing density.
+    // The sort is stable so boxes of equal density keep the order of their index.
+    std::vector<dens_box> sortedBoxes;
     for (size_t i=0; i<numBoxes; i++)
     {
-      double density = ws->getSignalNormalizedAt(i) * m_densityScaleFactor;
       // Skip any boxes with too small a signal density.
-      if (density > thresholdDensity)
-        sortedBoxes.insert(dens_box(density,i));
+      if (densities[i] > thresholdDensity)
+        sortedBoxes.push_back(dens_box(densities[i], i));
     }
+    std::stable_sort(sortedBoxes.begin(), sortedBoxes.end(), compareDensity<size_t>);
 
 
     // --------------- Find Peak Boxes -----------------------------
@@ -503,39 +603,26 @@ namespace MDAlgorithms
 
     prog = new Progress(this, 0.30, 0.95, MaxPeaks);
 
+    // Centers of the boxes already picked
+    PeakCenterGrid pickedCenters(nd, peakRadiusSquared);
+    std::vector<coord_t> centerCoords(nd);
+
     int64_t numBoxesFound = 0;
-    // Now we go (backwards) through the map
+    // Now we go (backwards) through the array
     // e.g. from highest density down to lowest density.
-    std::multimap<double, size_t>::reverse_iterator it2;
-    std::multimap<double, size_t>::reverse_iterator it2_end = sortedBoxes.rend();
+    std::vector<dens_box>::reverse_iterator it2;
+    std::vector<dens_box>::reverse_iterator it2_end = sortedBoxes.rend();
     for (it2 = sortedBoxes.rbegin(); it2 != it2_end; ++it2)
     {
       signal_t density = it2->first;
       size_t index = it2->second;
       // Get the center of the box
       VMD boxCenter = ws->getCenter(index);
+      for (size_t d=0; d<nd; d++)
+        centerCoords[d] = static_cast<coord_t>(boxCenter[d]);
 
-      // Compare to all boxes already picked.
-      bool badBox = false;
-      for (std::vector<size_t>::iterator it3=peakBoxes.begin(); it3 != peakBoxes.end(); ++it3)
-      {
-        VMD otherCenter = ws->getCenter(*it3);
-
-        // Distance between this box and a box we already put in.
-        coord_t distSquared = 0.0;
-        for (size_t d=0; d<nd; d++)
-        {
-          coord_t dist = otherCenter[d] - boxCenter[d];
-          distSquared += (dist * dist);
-        }
-
-        // Reject this box if it is too close to another previously found box.
-        if (distSquared < peakRadiusSquared)
-        {
-          badBox = true;
-          break;
-        }
-      }
+      // Reject this box if it is too close to another previously found box.
+      bool badBox = pickedCenters.isTooClose(&centerCoords[0]);
 
       // The box was not rejected for another reason.
       if (!badBox)
@@ -547,6 +634,7 @@ namespace MDAlgorithms
         }
 
         peakBoxes.push_back(index);
+        pickedCenters.add(&centerCoords[0]);
         g_log.debug() << "Found box at index " << index;
         g_log.debug() << "; Density = " << density << std::endl;
         // Report progres for each box found.
@@ -229,17 +229,130 @@ namespace MDAlgorithms
     outFile = save_path + outFile;
     out.open(outFile.c_str(), std::ofstream::out);
     }
-//
-// If the following OMP pragma is included, this algorithm seg faults
-// sporadically when processing multiple TOPAZ runs in a script, on 
-// Scientific Linux 6.2.  Typically, it seg faults after 2 to 6 runs are 
-// processed, though occasionally it will process all 8 requested in the 
-// script without crashing.  Since the lower level codes already use OpenMP, 
-// parallelizing at this level is only marginally useful, giving about a 
-// 5-10% speedup.  Perhaps is should just be removed permanantly, but for 
-// now it is commented out to avoid the seg faults.  Refs #5533
-//PRAGMA_OMP(parallel for schedule(dynamic, 10) )
-    for (int i=0; i < peakWS->getNumberPeaks(); ++i)
+    const int numPeaks = peakWS->getNumberPeaks();
+    // Find the peaks whose sphere/cylinder is off the edge of the detector
+    std::vector<bool> offEdge(numPeaks, false);
+    for (int i=0; i < numPeaks; ++i)
+      offEdge[i] = !detectorQ(peakWS->getPeak(i).getQLabFrame(), std::max(BackgroundOuterRadius, PeakRadius));
+
+    // Integrate the spheres of all the peaks first, in parallel unless the workspace is file-backed.
+    // For an in-memory workspace the boxes have no ISaveable, so MDBox::getConstEvents() returns the
+    // event vector without touching the disk buffer and integrateSpheres() only reads events and box
+    // signals. Each iteration reads its own peak and writes only its own elements of the output
+    // vectors. File-backed boxes load and mark themselves busy in the shared DiskBuffer, so that
+    // case stays serial.
+    std::vector<signal_t> peakSignal(numPeaks, 0), peakErrorSquared(numPeaks, 0);
+    std::vector<signal_t> peakBgSignal(numPeaks, 0), peakBgErrorSquared(numPeaks, 0);
+    if (!cylinderBool)
+    {
+      PARALLEL_FOR_IF( !ws->isFileBacked() )
+      for (int i=0; i < numPeaks; ++i)
+      {
+        PARALLEL_START_INTERUPT_REGION
+        if (!offEdge[i] || integrateEdge)
+        {
+          IPeak & p = peakWS->getPeak(i);
+          V3D pos;
+          if (CoordinatesToUse == 1) //"Q (lab frame)"
+            pos = p.getQLabFrame();
+          else if (CoordinatesToUse == 2) //"Q (sample frame)"
+            pos = p.getQSampleFrame();
+          else if (CoordinatesToUse == 3) //"HKL"
+            pos = p.getHKL();
+
+          bool dimensionsUsed[nd];
+          coord_t center[nd];
+          for (size_t d=0; d<nd; ++d)
+          {
+            dimensionsUsed[d] = true; // Use all dimensions
+            center[d] = static_cast<coord_t>(pos[d]);
+          }
+          // modulus of Q
+          coord_t lenQpeak = 1.0;
+          if (adaptiveQRadius)
+          {
+            lenQpeak = 0.0;
+            for (size_t d=0; d<nd; d++)
+            {
+              lenQpeak += center[d] * center[d];
+            }
+            lenQpeak = std::sqrt(lenQpeak);
+          }
+          PeakRadiusVector[i] = lenQpeak*PeakRadius;
+          BackgroundInnerRadiusVector[i] = lenQpeak*BackgroundInnerRadius;
+          BackgroundOuterRadiusVector[i] = lenQpeak*BackgroundOuterRadius;
+          CoordTransformDistance sphere(nd, center, dimensionsUsed);
+
+          // The peak sphere, then if needed the spheres "BackgroundOuterRadius" and
+          // "BackgroundInnerRadius", all integrated in one pass through the boxes
+          std::vector<coord_t> radiiSquared(1, static_cast<coord_t>(lenQpeak*PeakRadius*lenQpeak*PeakRadius));
+          const bool integrateBackground = (BackgroundOuterRadius > PeakRadius);
+          const bool integrateInterior = integrateBackground && (BackgroundInnerRadius != PeakRadius);
+          if (integrateBackground)
+            radiiSquared.push_back(static_cast<coord_t>(lenQpeak*BackgroundOuterRadius*lenQpeak*BackgroundOuterRadius));
+          if (integrateInterior)
+            radiiSquared.push_back(static_cast<coord_t>(lenQpeak*BackgroundInnerRadius*lenQpeak*BackgroundInnerRadius));
+          std::vector<signal_t> sphereSignal(radiiSquared.size(), 0), sphereErrorSquared(radiiSquared.size(), 0);
+
+          // Perform the integration into whatever box is contained within.
+          ws->getBox()->integrateSpheres(sphere, radiiSquared, sphereSignal, sphereErrorSquared);
+          peakSignal[i] = sphereSignal[0];
+          peakErrorSquared[i] = sphereErrorSquared[0];
+
+          // Integrate around the background radius
+
+          if (integrateBackground)
+          {
+            // Get the total signal inside "BackgroundOuterRadius"
+            peakBgSignal[i] = sphereSignal[1];
+            peakBgErrorSquared[i] = sphereErrorSquared[1];
+
+            // Evaluate the signal inside "BackgroundInnerRadius"
+            signal_t interiorSignal = 0;
+            signal_t interiorErrorSquared = 0;
+
+            // The 3rd radius, if needed
+            if (integrateInterior)
+            {
+              interiorSignal = sphereSignal[2];
+              interiorErrorSquared = sphereErrorSquared[2];
+            }
+            else
+            {
+              // PeakRadius == BackgroundInnerRadius, so use the previous value
+              interiorSignal = peakSignal[i];
+              interiorErrorSquared = peakErrorSquared[i];
+            }
+            // Subtract the peak part to get the intensity in the shell (BackgroundInnerRadius < r < BackgroundOuterRadius)
+            peakBgSignal[i] -= interiorSignal;
+            // We can subtract the error (instead of adding) because the two values are 100% dependent; this is the same as integrating a shell.
+            peakBgErrorSquared[i] -= interiorErrorSquared;
+
+            // Relative volume of peak vs the BackgroundOuterRadius sphere
+            double ratio = (PeakRadius / BackgroundOuterRadius);
+            double peakVolume = ratio * ratio * ratio;
+
+            // Relative volume of the interior of the shell vs overall background
+            double interiorRatio = (BackgroundInnerRadius / BackgroundOuterRadius);
+            // Volume of the bg shell, relative to the volume of the BackgroundOuterRadius sphere
+            double bgVolume = 1.0 - interiorRatio * interiorRatio * interiorRatio;
+
+            // Finally, you will multiply the bg intensity by this to get the estimated background under the peak volume
+            double scaleFactor = peakVolume / bgVolume;
+            peakBgSignal[i] *= scaleFactor;
+            peakBgErrorSquared[i] *= scaleFactor * scaleFactor;
+          }
+        }
+        PARALLEL_END_INTERUPT_REGION
+      }
+      PARALLEL_CHECK_INTERUPT_REGION
+    }
+
+    // This loop stays serial. It fits the cylinder profiles, writes to the profile file and
+    // modifies the peaks, none of which is thread-safe. Running it in parallel caused the
+    // sporadic seg faults of Refs #5533. Only the read-only sphere integration above runs in
+    // parallel.
+    for (int i=0; i < numPeaks; ++i)
     {
       // Get a direct ref to that peak.
       IPeak & p = peakWS->getPeak(i);
@@ -255,7 +368,7 @@ namespace MDAlgorithms
 
       // Do not integrate if sphere is off edge of detector
 
-      if (!detectorQ(p.getQLabFrame(), std::max(BackgroundOuterRadius, PeakRadius)))
+      if (offEdge[i])
         {
            g_log.warning() << "Warning: sphere/cylinder for integration is off edge of detector for peak " << i << std::endl;
            if (!integrateEdge)
@@ -284,66 +397,11 @@ namespace MDAlgorithms
     double background_total = 0.0;
       if (!cylinderBool)
     {
-      // modulus of Q
-      coord_t lenQpeak = 1.0;
-      if (adaptiveQRadius)
-      {
-        lenQpeak = 0.0;
-        for (size_t d=0; d<nd; d++)
-        {
-          lenQpeak += center[d] * center[d];
-        }
-        lenQpeak = std::sqrt(lenQpeak);
-      }
-      PeakRadiusVector[i] = lenQpeak*PeakRadius;
-      BackgroundInnerRadiusVector[i] = lenQpeak*BackgroundInnerRadius;
-      BackgroundOuterRadiusVector[i] = lenQpeak*BackgroundOuterRadius;
-      CoordTransformDistance sphere(nd, center, dimensionsUsed);
-
-      // Perform the integration into whatever box is contained within.
-      ws->getBox()->integrateSphere(sphere, static_cast<coord_t>(lenQpeak*PeakRadius*lenQpeak*PeakRadius), signal, errorSquared);
-
-      // Integrate around the background radius
-
-      if (BackgroundOuterRadius > PeakRadius )
-      {
-        // Get the total signal inside "BackgroundOuterRadius"
-        ws->getBox()->integrateSphere(sphere, static_cast<coord_t>(lenQpeak*BackgroundOuterRadius*lenQpeak*BackgroundOuterRadius), bgSignal, bgErrorSquared);
-
-        // Evaluate the signal inside "BackgroundInnerRadius"
-        signal_t interiorSignal = 0;
-        signal_t interiorErrorSquared = 0;
-
-        // Integrate this 3rd radius, if needed
-        if (BackgroundInnerRadius != PeakRadius)
-        {
-          ws->getBox()->integrateSphere(sphere, static_cast<coord_t>(lenQpeak*BackgroundInnerRadius*lenQpeak*BackgroundInnerRadius), interiorSignal, interiorErrorSquared);
-        }
-        else
-        {
-          // PeakRadius == BackgroundInnerRadius, so use the previous value
-          interiorSignal = signal;
-          interiorErrorSquared = errorSquared;
-        }
-            // Subtract the peak part to get the intensity in the shell (BackgroundInnerRadius < r < BackgroundOuterRadius)
-            bgSignal -= interiorSignal;
-            // We can subtract the error (instead of adding) because the two values are 100% dependent; this is the same as integrating a shell.
-            bgErrorSquared -= interiorErrorSquared;
-
-            // Relative volume of peak vs the BackgroundOuterRadius sphere
-            double ratio = (PeakRadius / BackgroundOuterRadius);
-            double peakVolume = ratio * ratio * ratio;
-
-            // Relative volume of the interior of the shell vs overall background
-            double interiorRatio = (BackgroundInnerRadius / BackgroundOuterRadius);
-            // Volume of the bg shell, relative to the volume of the BackgroundOuterRadius sphere
-            double bgVolume = 1.0 - interiorRatio * interiorRatio * interiorRatio;
-
-            // Finally, you will multiply the bg intensity by this to get the estimated background under the peak volume
-            double scaleFactor = peakVolume / bgVolume;
-            bgSignal *= scaleFactor;
-            bgErrorSquared *= scaleFactor * scaleFactor;
-      }
+      // The spheres were integrated before this loop
+      signal = peakSignal[i];
+      errorSquared = peakErrorSquared[i];
+      bgSignal = peakBgSignal[i];
+      bgErrorSquared = peakBgErrorSquared[i];
     }
       else
       {
@@ -25,6 +25,9 @@ namespace Mantid
       {
         return (v1[3] < v2[3]);
       }
+
+      /// Default largest total size in bytes of the per-thread copies of the normalization grid
+      const size_t MAX_PARTIAL_GRIDS_MEMORY = size_t(512) * 1024 * 1024;
     }
     
     // Register the algorithm into the AlgorithmFactory
@@ -35,7 +38,7 @@ namespace Mantid
      * Constructor
      */
     MDNormSCD::MDNormSCD() :
-      m_normWS(), m_inputWS(), m_hmin(0.0f), m_hmax(0.0f),
+      m_maxPartialGridsMemory(MAX_PARTIAL_GRIDS_MEMORY), m_normWS(), m_inputWS(), m_hmin(0.0f), m_hmax(0.0f),
       m_kmin(0.0f), m_kmax(0.0f), m_lmin(0.0f), m_lmax(0.0f), m_hIntegrated(true),
       m_kIntegrated(true), m_lIntegrated(true), m_rubw(3,3),
       m_kiMin(0.0), m_kiMax(EMPTY_DBL()), m_hIdx(-1), m_kIdx(-1), m_lIdx(-1),
@@ -390,12 +393,29 @@ namespace Mantid
       const detid2index_map fluxDetToIdx = integrFlux->getDetectorIDToWorkspaceIndexMap();
       const detid2index_map solidAngDetToIdx = solidAngleWS->getDetectorIDToWorkspaceIndexMap();
 
+      // Each thread sums its contributions into its own copy of the normalization grid,
+      // which are added together at the end. If the copies would take too much memory the
+      // contributions of a detector are added straight to the grid, in one critical section.
+      const size_t numBins = m_normWS->getNPoints();
+      const size_t numThreads = static_cast<size_t>(PARALLEL_GET_MAX_THREADS);
+      const bool usePartialGrids = (numThreads > 1) && (numThreads * numBins * sizeof(signal_t) <= m_maxPartialGridsMemory);
+      std::vector<std::vector<signal_t> > partialGrids(usePartialGrids ? numThreads : 0);
+
       auto *prog = new API::Progress(this, 0.3, 1.0, ndets);
       PARALLEL_FOR1(integrFlux)
       for(int64_t i = 0; i < ndets; i++)
       {
         PARALLEL_START_INTERUPT_REGION
 
+        signal_t *partialGrid = NULL;
+        if(usePartialGrids)
+        {
+          // Allocated by the thread using it
+          std::vector<signal_t> &threadGrid = partialGrids[PARALLEL_THREAD_NUMBER];
+          if(threadGrid.empty()) threadGrid.resize(numBins, 0.0);
+          partialGrid = &threadGrid[0];
+        }
+
         const auto detID = detIDs[i];
         double theta(0.0), phi(0.0);
         bool skip(false);
@@ -440,6 +460,8 @@ namespace Mantid
         // pre-allocate for efficiency and copy non-hkl dim values into place
         std::vector<coord_t> pos(vmdDims + otherValues.size());
         std::copy(otherValues.begin(), otherValues.end(), pos.begin() + vmdDims);
+        // (linear index, signal) of the contributions when there is no grid for this thread
+        std::vector<std::pair<size_t, signal_t> > contributions;
 
         for (auto it = intersectionsBegin + 1; it != intersections.end(); ++it)
         {
@@ -462,10 +484,17 @@ namespace Mantid
           // signal = integral between two consecutive intersections
           double signal = (yValues[k] - yValues[k - 1])*solid;
 
+          if(partialGrid) partialGrid[linIndex] += signal;
+          else contributions.push_back(std::make_pair(linIndex, signal));
+        }
+        if(!contributions.empty())
+        {
           PARALLEL_CRITICAL(updateMD)
           {
-            signal += m_normWS->getSignalAt(linIndex);
-            m_normWS->setSignalAt(linIndex, signal);
+            for(auto it = contributions.begin(); it != contributions.end(); ++it)
+            {
+              m_normWS->setSignalAt(it->first, m_normWS->getSignalAt(it->first) + it->second);
+            }
           }
         }
         prog->report();
@@ -474,6 +503,19 @@ namespace Mantid
       }
       PARALLEL_CHECK_INTERUPT_REGION
 
+      if(usePartialGrids)
+      {
+        signal_t *signals = m_normWS->getSignalArray();
+        PARALLEL_FOR_NO_WSP_CHECK()
+        for(int64_t j = 0; j < int64_t(numBins); ++j)
+        {
+          for(size_t t = 0; t < numThreads; ++t)
+          {
+            if(!partialGrids[t].empty()) signals[j] += partialGrids[t][j];
+          }
+        }
+      }
+
       delete prog;
     }
 
@@ -1,6 +1,7 @@
 #include "MantidAPI/FileProperty.h"
 #include "MantidAPI/MultipleFileProperty.h"
 #include "MantidKernel/CPUTimer.h"
+#include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/Strings.h"
 #include "MantidKernel/System.h"
 #include "MantidMDEvents/MDBoxBase.h"
@@ -20,6 +21,11 @@ namespace Mantid
 {
 namespace MDAlgorithms
 {
+  namespace
+  {
+    /// Maximal number of events read from all files in one block unless a single box holds more
+    const uint64_t MAX_EVENTS_IN_BLOCK = 10000000;
+  }
 
   // Register the algorithm into the AlgorithmFactory
   DECLARE_ALGORITHM(MergeMDFiles)
@@ -149,37 +155,125 @@ namespace MDAlgorithms
       g_log.notice() << totalEvents << " events in " << m_Filenames.size() << " files." << std::endl;
   }
 
-  /** Task that loads all of the events from corresponded boxes of all files
-    * that is being merged into a particular box in the output workspace.
+  /** Find the end of the block of consecutive leaf boxes starting at blockStart, which events are stored
+    * contiguously in every input file, so the events of the whole block can be read with one read per file.
+    * The block is limited to MAX_EVENTS_IN_BLOCK events unless its first box alone holds more.
+    *
+    * @param leafBoxes  :: the leaf boxes of the target workspace in the order of their file positions
+    * @param blockStart :: the index of the first box of the block
+    * @return the index of the box after the last box of the block
   */
-
-  uint64_t MergeMDFiles::loadEventsFromSubBoxes(API::IMDNode *TargetBox)
+  size_t MergeMDFiles::findBlockEnd(const std::vector<API::IMDNode *> &leafBoxes, size_t blockStart)const
   {
-    /// get rid of the events and averages which are in the memory erroneously (from cloning)
-    TargetBox->clear();
+    const size_t nFiles = m_fileComponentsStructure.size();
+    // the position in each file the events of the next box have to start from to keep the block contiguous
+    std::vector<uint64_t> nextPosition(nFiles,0);
+    std::vector<bool> hasEvents(nFiles,false);
+    uint64_t nBlockEvents(0);
+
+    size_t ib = blockStart;
+    for(;ib<leafBoxes.size();ib++)
+    {
+      size_t ID = leafBoxes[ib]->getID();
+      uint64_t nBoxEvents(0);
+      bool contiguous(true);
+      for (size_t iw=0; iw<nFiles; iw++)
+      {
+        const std::vector<uint64_t> &eventIndex = m_fileComponentsStructure[iw].getEventIndex();
+        if(eventIndex[2*ID+1]==0) continue;
+        nBoxEvents += eventIndex[2*ID+1];
+        if(hasEvents[iw] && eventIndex[2*ID]!=nextPosition[iw]) contiguous = false;
+      }
+      if(ib>blockStart && (!contiguous || nBlockEvents+nBoxEvents>MAX_EVENTS_IN_BLOCK)) break;
+
+      for (size_t iw=0; iw<nFiles; iw++)
+      {
+        const std::vector<uint64_t> &eventIndex = m_fileComponentsStructure[iw].getEventIndex();
+        if(eventIndex[2*ID+1]==0) continue;
+        hasEvents[iw]    = true;
+        nextPosition[iw] = eventIndex[2*ID]+eventIndex[2*ID+1];
+      }
+      nBlockEvents += nBoxEvents;
+    }
+    return ib;
+  }
 
-    uint64_t nBoxEvents(0);
-    std::vector<size_t> numFileEvents(m_EventLoader.size());
+  /** Load all of the events from corresponded boxes of all files which are merged into
+    * a block of boxes of the output workspace.
+    * The events of the block are read from every file in one piece and then distributed between the target boxes, 
+    * which are filled in parallel if requested.
+    *
+    * @param leafBoxes  :: the leaf boxes of the target workspace in the order of their file positions
+    * @param blockStart :: the index of the first box of the block
+    * @param blockEnd   :: the index of the box after the last box of the block, as returned by findBlockEnd
+    * @param parallel   :: if true, build the events of different boxes in parallel
+    * @return the number of events loaded
+  */
+  uint64_t MergeMDFiles::loadEventsFromSubBoxes(const std::vector<API::IMDNode *> &leafBoxes, size_t blockStart, size_t blockEnd, bool parallel)
+  {
+    const size_t nFiles = m_EventLoader.size();
+    std::vector<std::vector<coord_t> > blockData(nFiles);
+    std::vector<uint64_t> blockPosition(nFiles,0);
+    std::vector<size_t> nColumns(nFiles,0);
 
-    for (size_t iw=0; iw<this->m_EventLoader.size(); iw++)
+    uint64_t nBlockEvents(0);
+    for (size_t iw=0; iw<nFiles; iw++)
     {
-      size_t ID = TargetBox->getID();
-      numFileEvents[iw] = static_cast<size_t>(m_fileComponentsStructure[iw].getEventIndex()[2*ID+1]);
-      nBoxEvents += numFileEvents[iw];
+      const std::vector<uint64_t> &eventIndex = m_fileComponentsStructure[iw].getEventIndex();
+      uint64_t firstEvent(0),lastEvent(0);
+      bool hasEvents(false);
+      for(size_t ib=blockStart;ib<blockEnd;ib++)
+      {
+        size_t ID = leafBoxes[ib]->getID();
+        if(eventIndex[2*ID+1]==0) continue;
+        if(!hasEvents)
+        {
+          firstEvent = eventIndex[2*ID];
+          hasEvents  = true;
+        }
+        lastEvent = eventIndex[2*ID]+eventIndex[2*ID+1];
+      }
+      if(!hasEvents) continue;
+
+      const size_t nEvents = static_cast<size_t>(lastEvent-firstEvent);
+      m_EventLoader[iw]->loadBlock(blockData[iw],firstEvent,nEvents);
+      blockPosition[iw] = firstEvent;
+      nColumns[iw]      = blockData[iw].size()/nEvents;
+      nBlockEvents     += nEvents;
     }
 
-    // At this point memory required is known, so it is reserved all in one go
-    TargetBox->reserveMemoryForLoad(nBoxEvents);
+    /// get rid of the events and averages which are in the memory erroneously (from cloning)
+    for(size_t ib=blockStart;ib<blockEnd;ib++)
+      leafBoxes[ib]->clear();
 
-    for (size_t iw=0; iw<this->m_EventLoader.size(); iw++)
+    const int64_t nBoxes = static_cast<int64_t>(blockEnd-blockStart);
+    PARALLEL_FOR_IF(parallel)
+    for(int64_t i=0;i<nBoxes;i++)
     {
+      PARALLEL_START_INTERUPT_REGION
+      API::IMDNode *TargetBox = leafBoxes[blockStart+static_cast<size_t>(i)];
       size_t ID = TargetBox->getID();
-      uint64_t fileLocation   = m_fileComponentsStructure[iw].getEventIndex()[2*ID+0];
-      if(numFileEvents[iw]==0) continue;
-      TargetBox->loadAndAddFrom(m_EventLoader[iw],fileLocation,numFileEvents[iw]);
+
+      uint64_t nBoxEvents(0);
+      for (size_t iw=0; iw<nFiles; iw++)
+        nBoxEvents += m_fileComponentsStructure[iw].getEventIndex()[2*ID+1];
+      // At this point memory required is known, so it is reserved all in one go
+      TargetBox->reserveMemoryForLoad(nBoxEvents);
+
+      std::vector<coord_t> boxData;
+      for (size_t iw=0; iw<nFiles; iw++)
+      {
+        const std::vector<uint64_t> &eventIndex = m_fileComponentsStructure[iw].getEventIndex();
+        if(eventIndex[2*ID+1]==0) continue;
+        auto first = blockData[iw].begin()+static_cast<ptrdiff_t>((eventIndex[2*ID]-blockPosition[iw])*nColumns[iw]);
+        boxData.assign(first,first+static_cast<ptrdiff_t>(eventIndex[2*ID+1]*nColumns[iw]));
+        TargetBox->addEventsData(boxData);
+      }
+      PARALLEL_END_INTERUPT_REGION
     }
+    PARALLEL_CHECK_INTERUPT_REGION
 
-    return nBoxEvents;
+    return nBlockEvents;
   }
 
   //----------------------------------------------------------------------------------------------
@@ -195,8 +289,8 @@ namespace MDAlgorithms
     m_MDEventType = ws->getEventTypeName();
 
 
-   // Run the tasks in parallel? TODO: enable
-    //bool Parallel = this->getProperty("Parallel");
+    // Build the events of the boxes in parallel?
+    bool Parallel = this->getProperty("Parallel");
 
     // Fix the box controller settings in the output workspace so that it splits normally
     BoxController_sptr bc = ws->getBoxController();
@@ -237,12 +331,8 @@ namespace MDAlgorithms
     // For tracking progress
     //uint64_t totalEventsInTasks = 0;
    
-    // Prepare thread pool
     CPUTimer overallTime;
 
-    ThreadSchedulerFIFO * ts = new ThreadSchedulerFIFO();
-    ThreadPool tp(ts);
-
     Kernel::DiskBuffer *DiskBuf(NULL);
     if(m_fileBasedTargetWS)
     {
@@ -251,51 +341,42 @@ namespace MDAlgorithms
 
     this->totalLoaded = 0;
     std::vector<API::IMDNode *> &boxes = m_BoxStruct.getBoxes();
-
+    // the leaf boxes are kept in the order of their positions in the target file, so the boxes are written sequentially
+    std::vector<API::IMDNode *> leafBoxes;
+    leafBoxes.reserve(numBoxes);
     for(size_t ib=0;ib<numBoxes;ib++)
     {
-      auto box = boxes[ib];
-      if(!box->isBox())continue;
-      // load all contributed events into current box;
-      this->loadEventsFromSubBoxes(boxes[ib]);
+      if(boxes[ib]->isBox()) leafBoxes.push_back(boxes[ib]);
+    }
+
+    size_t blockStart = 0;
+    while(blockStart<leafBoxes.size())
+    {
+      size_t blockEnd = this->findBlockEnd(leafBoxes,blockStart);
+      // load all contributed events into the boxes of the current block;
+      this->totalLoaded += this->loadEventsFromSubBoxes(leafBoxes,blockStart,blockEnd,Parallel);
 
       if(DiskBuf)
       {
-        if(box->getDataInMemorySize()>0)
-        {  // data position has been already pre-calculated 
-            box->getISaveable()->save();
-            box->clearDataFromMemory();
-            //Kernel::ISaveable *Saver = box->getISaveable();
-            //DiskBuf->toWrite(Saver);
+        for(size_t ib=blockStart;ib<blockEnd;ib++)
+        {
+          auto box = leafBoxes[ib];
+          if(box->getDataInMemorySize()>0)
+          {  // data position has been already pre-calculated 
+              box->getISaveable()->save();
+              box->clearDataFromMemory();
+          }
         }
       }
-      //else
-      //{   size_t ID = box->getID();
-      //    uint64_t filePosition = targetEventIndexes[2*ID];
-      //    box->saveAt(saver.get(), filePosition);
-      //}
-      //
-      //if (!Parallel)
-      //{
-      //  // Run the task serially only
-      //  task->run();
-      //  delete task;
-      //}
-      //else
-      //{
-      //  // Enqueue to run in parallel (at the joinAll() call below).
-      //  ts->push(task);
-      //}
-
-      prog->reportIncrement(ib,"Loading and merging box data");
+
+      prog->reportIncrement(blockEnd-blockStart,"Loading and merging box data");
+      blockStart = blockEnd;
     }
     if(DiskBuf)
     {
       DiskBuf->flushCache();
       bc->getFileIO()->flushData();
     }
-    //// Run any final tasks
-    //tp.joinAll();
     g_log.information() << overallTime << " to do all the adding." << std::endl;
 
     // Close any open file handle
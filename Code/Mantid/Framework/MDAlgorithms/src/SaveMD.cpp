@@ -75,6 +75,11 @@ namespace MDAlgorithms
         "For an MDEventWorkspace that was created in memory:\n"
         "This saves it to a file AND makes the workspace into a file-backed one.");
     setPropertySettings("MakeFileBacked", new EnabledWhenProperty("UpdateFileBackEnd", IS_EQUAL_TO, "0"));
+
+    declareProperty("CompressEvents", false,
+        "Compress the event data written to a new file. Compressed files are smaller and faster to move\n"
+        "but take more CPU time to save and load. Ignored if UpdateFileBackEnd is checked.");
+    setPropertySettings("CompressEvents", new EnabledWhenProperty("UpdateFileBackEnd", IS_EQUAL_TO, "0"));
   }
 
  
@@ -90,6 +95,7 @@ namespace MDAlgorithms
     std::string filename = getPropertyValue("Filename");
     bool update = getProperty("UpdateFileBackEnd");
     bool MakeFileBacked = getProperty("MakeFileBacked");
+    bool CompressEvents = getProperty("CompressEvents");
 
     bool wsIsFileBacked = ws->isFileBacked();
     if (update && MakeFileBacked)
@@ -144,7 +150,10 @@ namespace MDAlgorithms
       // the boxes file positions are unknown and we need to calculate it.
       BoxFlatStruct.initFlatStructure(ws,filename);
       // create saver class
-      auto Saver = boost::shared_ptr<API::IBoxControllerIO>(new MDEvents::BoxControllerNeXusIO(bc.get()));
+      auto NeXusSaver = new MDEvents::BoxControllerNeXusIO(bc.get());
+      if(CompressEvents)
+        NeXusSaver->setCompression(::NeXus::LZW);
+      auto Saver = boost::shared_ptr<API::IBoxControllerIO>(NeXusSaver);
       Saver->setDataType(sizeof(coord_t),MDE::getTypeName());
       if(MakeFileBacked)
       {
@@ -997,6 +997,116 @@ public:
         "OutputBins", "10,10");
     TSM_ASSERT( "Algorithm threw an error, as expected", !alg->isExecuted())
   }
+
+  //---------------------------------------------------------------------------------------------
+  /** Bin a panned view reusing the bins of the previous one */
+  void test_exec_reuses_PreviousOutputWorkspace()
+  {
+    IMDEventWorkspace_sptr in_ws = MDEventsTestHelper::makeMDEW<3>(10, 0.0, 10.0, 1);
+    AnalysisDataService::Instance().addOrReplace("BinMDTest_ws", in_ws);
+
+    FrameworkManager::Instance().exec("BinMD", 10,
+        "InputWorkspace", "BinMDTest_ws",
+        "AlignedDim0", "Axis0,0.0,6.0, 6",
+        "AlignedDim1", "Axis1,0.0,6.0, 6",
+        "AlignedDim2", "Axis2,0.0,10.0, 10",
+        "OutputWorkspace", "BinMDTest_previous");
+    MDHistoWorkspace_sptr previous = AnalysisDataService::Instance().retrieveWS<MDHistoWorkspace>("BinMDTest_previous");
+    TS_ASSERT(previous);
+    if (!previous) return;
+    // Mark the bins, so the ones copied from the previous workspace can be told apart
+    previous->setTo(5.0, 5.0, 5.0);
+
+    BinMD alg;
+    TS_ASSERT_THROWS_NOTHING( alg.initialize() )
+    TS_ASSERT_THROWS_NOTHING( alg.setPropertyValue("InputWorkspace", "BinMDTest_ws") );
+    TS_ASSERT_THROWS_NOTHING( alg.setPropertyValue("AlignedDim0", "Axis0,2.0,8.0, 6") );
+    TS_ASSERT_THROWS_NOTHING( alg.setPropertyValue("AlignedDim1", "Axis1,1.0,7.0, 6") );
+    TS_ASSERT_THROWS_NOTHING( alg.setPropertyValue("AlignedDim2", "Axis2,0.0,10.0, 10") );
+    TS_ASSERT_THROWS_NOTHING( alg.setPropertyValue("PreviousOutputWorkspace", "BinMDTest_previous") );
+    TS_ASSERT_THROWS_NOTHING( alg.setPropertyValue("OutputWorkspace", "BinMDTest_panned") );
+    TS_ASSERT_THROWS_NOTHING( alg.execute(); )
+    TS_ASSERT( alg.isExecuted() );
+
+    MDHistoWorkspace_sptr out = AnalysisDataService::Instance().retrieveWS<MDHistoWorkspace>("BinMDTest_panned");
+    TS_ASSERT(out);
+    if (!out) return;
+    TS_ASSERT_EQUALS( out->getNPoints(), 6*6*10);
+    for (size_t i=0; i<6; i++)
+      for (size_t j=0; j<6; j++)
+        for (size_t k=0; k<10; k++)
+        {
+          // Bins with x < 6 and y < 6 come from the previous workspace, the other ones are binned from the events
+          double expected = (i < 4 && j < 5) ? 5.0 : 1.0;
+          TS_ASSERT_DELTA( out->getSignalAt(out->getLinearIndex(i,j,k)), expected, 1e-5);
+          TS_ASSERT_DELTA( out->getNumEventsAt(out->getLinearIndex(i,j,k)), expected, 1e-5);
+        }
+
+    // A view with a different bin width is binned from scratch
+    TS_ASSERT_THROWS_NOTHING( alg.setPropertyValue("AlignedDim0", "Axis0,2.0,8.0, 3") );
+    TS_ASSERT_THROWS_NOTHING( alg.execute(); )
+    out = AnalysisDataService::Instance().retrieveWS<MDHistoWorkspace>("BinMDTest_panned");
+    for (size_t i=0; i < out->getNPoints(); i++)
+      TS_ASSERT_DELTA( out->getSignalAt(i), 2.0, 1e-5);
+
+    AnalysisDataService::Instance().remove("BinMDTest_ws");
+    AnalysisDataService::Instance().remove("BinMDTest_previous");
+    AnalysisDataService::Instance().remove("BinMDTest_panned");
+  }
+
+  //---------------------------------------------------------------------------------------------
+  /** A previous output is not reused once events have been added to the input */
+  void test_exec_ignores_PreviousOutputWorkspace_when_input_changed()
+  {
+    IMDEventWorkspace_sptr in_ws = MDEventsTestHelper::makeMDEW<3>(10, 0.0, 10.0, 1);
+    AnalysisDataService::Instance().addOrReplace("BinMDTest_ws", in_ws);
+
+    FrameworkManager::Instance().exec("BinMD", 10,
+        "InputWorkspace", "BinMDTest_ws",
+        "AlignedDim0", "Axis0,0.0,6.0, 6",
+        "AlignedDim1", "Axis1,0.0,6.0, 6",
+        "AlignedDim2", "Axis2,0.0,10.0, 10",
+        "OutputWorkspace", "BinMDTest_previous");
+    MDHistoWorkspace_sptr previous = AnalysisDataService::Instance().retrieveWS<MDHistoWorkspace>("BinMDTest_previous");
+    TS_ASSERT(previous);
+    if (!previous) return;
+    TS_ASSERT_EQUALS( previous->getExperimentInfo(0)->run().getPropertyValueAsType<uint64_t>("BinMD_InputNPoints"), 1000);
+    previous->setTo(5.0, 5.0, 5.0);
+
+    // Change the input in place: one more event in every unit cube
+    FrameworkManager::Instance().exec("FakeMDEventData", 4,
+        "InputWorkspace", "BinMDTest_ws",
+        "UniformParams", "-1000");
+    TS_ASSERT_EQUALS( in_ws->getNPoints(), 2000);
+
+    BinMD alg;
+    TS_ASSERT_THROWS_NOTHING( alg.initialize() )
+    TS_ASSERT_THROWS_NOTHING( alg.setPropertyValue("InputWorkspace", "BinMDTest_ws") );
+    TS_ASSERT_THROWS_NOTHING( alg.setPropertyValue("AlignedDim0", "Axis0,2.0,8.0, 6") );
+    TS_ASSERT_THROWS_NOTHING( alg.setPropertyValue("AlignedDim1", "Axis1,1.0,7.0, 6") );
+    TS_ASSERT_THROWS_NOTHING( alg.setPropertyValue("AlignedDim2", "Axis2,0.0,10.0, 10") );
+    TS_ASSERT_THROWS_NOTHING( alg.setPropertyValue("PreviousOutputWorkspace", "BinMDTest_previous") );
+    TS_ASSERT_THROWS_NOTHING( alg.setPropertyValue("OutputWorkspace", "BinMDTest_panned") );
+    TS_ASSERT_THROWS_NOTHING( alg.execute(); )
+    TS_ASSERT( alg.isExecuted() );
+
+    MDHistoWorkspace_sptr out = AnalysisDataService::Instance().retrieveWS<MDHistoWorkspace>("BinMDTest_panned");
+    TS_ASSERT(out);
+    if (!out) return;
+    // Nothing comes from the stale previous workspace: every bin holds the events now in the input
+    signal_t total = 0;
+    for (size_t i=0; i < out->getNPoints(); i++)
+    {
+      TS_ASSERT_DIFFERS( out->getSignalAt(i), 5.0);
+      total += out->getSignalAt(i);
+    }
+    TS_ASSERT_DELTA( total, 2.0 * 6*6*10, 1e-5);
+    TS_ASSERT_EQUALS( out->getExperimentInfo(0)->run().getPropertyValueAsType<uint64_t>("BinMD_InputNPoints"), 2000);
+
+    AnalysisDataService::Instance().remove("BinMDTest_ws");
+    AnalysisDataService::Instance().remove("BinMDTest_previous");
+    AnalysisDataService::Instance().remove("BinMDTest_panned");
+  }
 };
 
 
@@ -62,7 +62,7 @@ void testInit(){
     TS_ASSERT_THROWS_NOTHING( pAlg->initialize() )
     TS_ASSERT( pAlg->isInitialized() )
 
-    TSM_ASSERT_EQUALS("algorithm should have 21 properties",21,(size_t)(pAlg->getProperties().size()));
+    TSM_ASSERT_EQUALS("algorithm should have 23 properties",23,(size_t)(pAlg->getProperties().size()));
 }
 
 
@@ -171,6 +171,41 @@ void testExecQ3D()
     AnalysisDataService::Instance().remove("WS5DQ3D");
 }
 
+void testExecQ3DFileBacked()
+{
+     Mantid::API::MatrixWorkspace_sptr ws2D = AnalysisDataService::Instance().retrieveWS<MatrixWorkspace>("testWSProcessed");
+     API::NumericAxis *pAxis = new API::NumericAxis(3);
+     pAxis->setUnit("DeltaE");
+
+     ws2D->replaceAxis(0,pAxis);
+
+    ConvertToMD alg;
+    TS_ASSERT_THROWS_NOTHING(alg.initialize());
+    alg.setPropertyValue("OutputWorkspace","WS3DQ3DFileBacked");
+    alg.setPropertyValue("InputWorkspace","testWSProcessed");
+    alg.setPropertyValue("PreprocDetectorsWS","");
+    alg.setPropertyValue("QDimensions", "Q3D");
+    alg.setPropertyValue("dEAnalysisMode", "Direct");
+    alg.setPropertyValue("MinValues","-10,-10,-10,  0");
+    alg.setPropertyValue("MaxValues"," 10, 10, 10, 20");
+    alg.setPropertyValue("OutputFilename","ConvertToMDTest_FileBacked.nxs");
+    alg.setPropertyValue("Memory","1");
+
+    alg.setRethrows(true);
+    TS_ASSERT_THROWS_NOTHING(alg.execute());
+    TSM_ASSERT("Should finish successfully",alg.isExecuted());
+
+    auto outWS = AnalysisDataService::Instance().retrieveWS<IMDEventWorkspace>("WS3DQ3DFileBacked");
+    TS_ASSERT(outWS);
+    if(!outWS) return;
+    TSM_ASSERT("The output workspace should be file-backed",outWS->isFileBacked());
+    TS_ASSERT(outWS->getNPoints() > 0);
+
+    outWS->clearFileBacked(false);
+    MDEventsTestHelper::checkAndDeleteFile(alg.getPropertyValue("OutputFilename"));
+    AnalysisDataService::Instance().remove("WS3DQ3DFileBacked");
+}
+
 //DO NOT DISABLE THIS TEST
 void testAlgorithmProperties()
 {
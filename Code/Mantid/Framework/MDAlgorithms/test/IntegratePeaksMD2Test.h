@@ -6,6 +6,7 @@
 #include "MantidAPI/FrameworkManager.h"
 #include "MantidDataObjects/PeaksWorkspace.h"
 #include "MantidGeometry/MDGeometry/MDHistoDimension.h"
+#include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/System.h"
 #include "MantidKernel/Timer.h"
 #include "MantidMDEvents/MDEventFactory.h"
@@ -335,6 +336,46 @@ public:
 
   }
 
+  //-------------------------------------------------------------------------------
+  /// The spheres are integrated in parallel: the result must not depend on the number of threads
+  void test_exec_parallel_matches_serial()
+  {
+    createMDEW();
+    Instrument_sptr inst = ComponentCreationHelper::createTestInstrumentCylindrical(5);
+    PeaksWorkspace_sptr peakWS(new PeaksWorkspace());
+    for (int i = 0; i < 4; ++i)
+      for (int j = 0; j < 4; ++j)
+      {
+        const double x = -6.0 + 4.0 * i;
+        const double y = -6.0 + 4.0 * j;
+        const double z = static_cast<double>(i - j);
+        addPeak(200 + 100 * (i + j), x, y, z, 0.5 + 0.1 * i);
+        peakWS->addPeak( Peak(inst, 1, 1.0, V3D(x, y, z) ) );
+      }
+    AnalysisDataService::Instance().addOrReplace("IntegratePeaksMD2Test_peaks",peakWS);
+
+    const int maxThreads = PARALLEL_GET_MAX_THREADS;
+    PARALLEL_SET_NUM_THREADS(1);
+    doRun(0.8, 1.5, "IntegratePeaksMD2Test_serial", 1.0);
+    PARALLEL_SET_NUM_THREADS(maxThreads);
+    doRun(0.8, 1.5, "IntegratePeaksMD2Test_parallel", 1.0);
+
+    auto serialWS = AnalysisDataService::Instance().retrieveWS<PeaksWorkspace>("IntegratePeaksMD2Test_serial");
+    auto parallelWS = AnalysisDataService::Instance().retrieveWS<PeaksWorkspace>("IntegratePeaksMD2Test_parallel");
+    TS_ASSERT_EQUALS( serialWS->getNumberPeaks(), 16 );
+    TS_ASSERT_EQUALS( parallelWS->getNumberPeaks(), 16 );
+    for (int i = 0; i < serialWS->getNumberPeaks(); ++i)
+    {
+      const double intensity = serialWS->getPeak(i).getIntensity();
+      TS_ASSERT_LESS_THAN( 0.0, intensity );
+      TS_ASSERT_DELTA( parallelWS->getPeak(i).getIntensity(), intensity, 1e-9 * intensity );
+      TS_ASSERT_DELTA( parallelWS->getPeak(i).getSigmaIntensity(), serialWS->getPeak(i).getSigmaIntensity(), 1e-9 * intensity );
+    }
+
+    AnalysisDataService::Instance().remove("IntegratePeaksMD2Test_serial");
+    AnalysisDataService::Instance().remove("IntegratePeaksMD2Test_parallel");
+  }
+
   void test_writes_out_selected_algorithm_parameters()
   {
     createMDEW();
@@ -5,13 +5,26 @@
 
 #include "MantidMDAlgorithms/MDNormSCD.h"
 #include "MantidMDAlgorithms/CreateMDWorkspace.h"
+#include "MantidAPI/FrameworkManager.h"
 #include "MantidAPI/IMDHistoWorkspace.h"
+#include "MantidAPI/MatrixWorkspace.h"
 #include "MantidAPI/WorkspaceFactory.h"
+#include "MantidKernel/MultiThreaded.h"
 #include "MantidTestHelpers/WorkspaceCreationHelper.h"
 
+#include <algorithm>
+#include <cmath>
+
 using Mantid::MDAlgorithms::MDNormSCD;
 using namespace Mantid::API;
 
+/// Lets the tests force the normalization to be added up in the critical section
+class MDNormSCDTestHelper : public MDNormSCD
+{
+public:
+  void setMaxPartialGridsMemory(size_t bytes) { m_maxPartialGridsMemory = bytes; }
+};
+
 class MDNormSCDTest : public CxxTest::TestSuite
 {
 public:
@@ -51,9 +64,100 @@ public:
 
     AnalysisDataService::Instance().clear();
   }
-  
+
+  void test_parallel_normalization_matches_serial()
+  {
+    createConvertedWorkspaces();
+    const int maxThreads = PARALLEL_GET_MAX_THREADS;
+
+    PARALLEL_SET_NUM_THREADS(1);
+    IMDHistoWorkspace_sptr serial = runNormalization("MDNormSCDTest_serial", false);
+    PARALLEL_SET_NUM_THREADS(maxThreads);
+    // One copy of the grid per thread
+    IMDHistoWorkspace_sptr partialGrids = runNormalization("MDNormSCDTest_grids", false);
+    // No copies: every detector adds its contributions in the critical section
+    IMDHistoWorkspace_sptr critical = runNormalization("MDNormSCDTest_critical", true);
+
+    TS_ASSERT(serial && partialGrids && critical);
+    if (!serial || !partialGrids || !critical) return;
+    TS_ASSERT_EQUALS(serial->getNPoints(), partialGrids->getNPoints());
+    TS_ASSERT_EQUALS(serial->getNPoints(), critical->getNPoints());
+
+    double total(0.0);
+    for (size_t i = 0; i < serial->getNPoints(); ++i)
+    {
+      const double expected = serial->getSignalAt(i);
+      total += expected;
+      // Only the order of the additions differs
+      const double tolerance = 1e-10 * std::max(1.0, std::fabs(expected));
+      TS_ASSERT_DELTA(partialGrids->getSignalAt(i), expected, tolerance);
+      TS_ASSERT_DELTA(critical->getSignalAt(i), expected, tolerance);
+    }
+    TSM_ASSERT("The detectors should reach some of the bins", total > 0.0);
+
+    AnalysisDataService::Instance().clear();
+  }
+
 private:
 
+  /// Event data with a UB matrix converted to HKL, with the matching integrated flux and solid angles
+  void createConvertedWorkspaces()
+  {
+    FrameworkManager::Instance().exec("CreateSampleWorkspace", 16,
+        "OutputWorkspace", "MDNormSCDTest_events",
+        "WorkspaceType", "Event",
+        "Function", "Flat background",
+        "NumBanks", "1",
+        "BankPixelWidth", "10",
+        "XUnit", "Momentum",
+        "XMin", "2",
+        "XMax", "10",
+        "BinWidth", "0.5");
+    AnalysisDataService::Instance().retrieveWS<MatrixWorkspace>("MDNormSCDTest_events")->mutableRun().setProtonCharge(1.0);
+    FrameworkManager::Instance().exec("SetUB", 8,
+        "Workspace", "MDNormSCDTest_events",
+        "a", "5",
+        "b", "5",
+        "c", "5");
+    FrameworkManager::Instance().exec("ConvertToMD", 16,
+        "InputWorkspace", "MDNormSCDTest_events",
+        "OutputWorkspace", "MDNormSCDTest_md",
+        "QDimensions", "Q3D",
+        "dEAnalysisMode", "Elastic",
+        "Q3DFrames", "HKL",
+        "QConversionScales", "HKL",
+        "MinValues", "-10,-10,-10",
+        "MaxValues", "10,10,10");
+    FrameworkManager::Instance().exec("IntegrateFlux", 4,
+        "InputWorkspace", "MDNormSCDTest_events",
+        "OutputWorkspace", "MDNormSCDTest_flux");
+    FrameworkManager::Instance().exec("Rebin", 8,
+        "InputWorkspace", "MDNormSCDTest_events",
+        "OutputWorkspace", "MDNormSCDTest_solidAngle",
+        "Params", "2,8,10",
+        "PreserveEvents", "0");
+  }
+
+  IMDHistoWorkspace_sptr runNormalization(const std::string & normWsName, bool noPartialGrids)
+  {
+    MDNormSCDTestHelper alg;
+    alg.setChild(true);
+    if (noPartialGrids) alg.setMaxPartialGridsMemory(0);
+    TS_ASSERT_THROWS_NOTHING( alg.initialize() )
+    TS_ASSERT_THROWS_NOTHING( alg.setPropertyValue("InputWorkspace", "MDNormSCDTest_md") );
+    TS_ASSERT_THROWS_NOTHING( alg.setPropertyValue("AlignedDim0", "[H,0,0],-2,2,20") );
+    TS_ASSERT_THROWS_NOTHING( alg.setPropertyValue("AlignedDim1", "[0,K,0],-2,2,20") );
+    TS_ASSERT_THROWS_NOTHING( alg.setPropertyValue("AlignedDim2", "[0,0,L],-2,2,20") );
+    TS_ASSERT_THROWS_NOTHING( alg.setPropertyValue("FluxWorkspace", "MDNormSCDTest_flux") );
+    TS_ASSERT_THROWS_NOTHING( alg.setPropertyValue("SolidAngleWorkspace", "MDNormSCDTest_solidAngle") );
+    TS_ASSERT_THROWS_NOTHING( alg.setPropertyValue("OutputWorkspace", "MDNormSCDTest_out") );
+    TS_ASSERT_THROWS_NOTHING( alg.setPropertyValue("OutputNormalizationWorkspace", normWsName) );
+    TS_ASSERT_THROWS_NOTHING( alg.execute() );
+    TS_ASSERT( alg.isExecuted() );
+    Workspace_sptr normWS = alg.getProperty("OutputNormalizationWorkspace");
+    return boost::dynamic_pointer_cast<IMDHistoWorkspace>(normWS);
+  }
+
   void createMDWorkspace(const std::string& wsName)
   {
     const int ndims = 2;
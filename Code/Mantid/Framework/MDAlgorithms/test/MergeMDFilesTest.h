@@ -37,8 +37,18 @@ public:
   {
     do_test_exec("MergeMDFilesTest_OutputWS.nxs");
   }
+
+  void test_exec_parallel()
+  {
+    do_test_exec("", true);
+  }
+
+  void test_exec_fileBacked_parallel()
+  {
+    do_test_exec("MergeMDFilesTest_OutputWS.nxs", true);
+  }
   
-  void do_test_exec(std::string OutputFilename)
+  void do_test_exec(std::string OutputFilename, bool parallel = false)
   {
     if (OutputFilename != "")
     {
@@ -68,6 +78,7 @@ public:
     TS_ASSERT( alg.isInitialized() )
     TS_ASSERT_THROWS_NOTHING( alg.setProperty("Filenames", filenames) );
     TS_ASSERT_THROWS_NOTHING( alg.setPropertyValue("OutputFilename", OutputFilename) );
+    TS_ASSERT_THROWS_NOTHING( alg.setProperty("Parallel", parallel) );
     TS_ASSERT_THROWS_NOTHING( alg.setPropertyValue("OutputWorkspace", outWSName) );
 
     // clean up possible rubbish from previous runs
@@ -57,6 +57,11 @@ public:
     do_test_exec(0, "SaveMDTest_noEvents.nxs");
   }
 
+  void test_exec_compressed()
+  {
+    do_test_exec(23, "SaveMDTest_compressed.nxs", false, false, true);
+  }
+
   void test_MakeFileBacked()
   {
     do_test_exec(23, "SaveMDTest.nxs", true);
@@ -68,7 +73,7 @@ public:
   }
 
 
-  void do_test_exec(size_t numPerBox, std::string filename, bool MakeFileBacked = false, bool UpdateFileBackEnd = false)
+  void do_test_exec(size_t numPerBox, std::string filename, bool MakeFileBacked = false, bool UpdateFileBackEnd = false, bool CompressEvents = false)
   {
    
     // Make a 1D MDEventWorkspace
@@ -93,6 +98,7 @@ public:
     TS_ASSERT_THROWS_NOTHING( alg.setPropertyValue("InputWorkspace", "SaveMDTest_ws") );
     TS_ASSERT_THROWS_NOTHING( alg.setPropertyValue("Filename", filename) );
     TS_ASSERT_THROWS_NOTHING( alg.setProperty("MakeFileBacked", MakeFileBacked) );
+    TS_ASSERT_THROWS_NOTHING( alg.setProperty("CompressEvents", CompressEvents) );
 
     // clean up possible rubbish from the previous runs
     std::string fullName = alg.getPropertyValue("Filename");
@@ -74,6 +74,17 @@ namespace MDEvents
             //Auxiliary functions. Used to change default state of this object which is not fully supported. Should be replaced by some IBoxControllerIO factory
             virtual void setDataType(const size_t coordSize, const std::string &typeName);
             virtual void getDataType(size_t &coordSize, std::string &typeName)const;
+            /**Set the compression applied to the event data array when it is created. Existing data keep the compression they were written with.
+             * The data are compressed chunk by chunk (DATA_CHUNK events each), so random access to the boxes is preserved. */
+            void setCompression(const ::NeXus::NXcompression compression)
+            {
+                m_compression = compression;
+            }
+            /// @return the compression used for newly created event data arrays
+            ::NeXus::NXcompression getCompression()const
+            {
+                return m_compression;
+            }
   //------------------------------------------------------------------------------------------------------------------------
             //Auxiliary functions (non-virtual, used for testing)
             int64_t getNDataColums()const
@@ -94,6 +105,8 @@ namespace MDEvents
         bool m_ReadOnly;
         /// The size of the events block which can be written in the neXus array at once (continious part of the data block)
         size_t m_dataChunk;
+        /// the compression of the event data array, created by this class
+        ::NeXus::NXcompression m_compression;
         /// shared pointer to the box controller, which is repsoponsible for this IO
         API::BoxController *const m_bc;
         //------ 
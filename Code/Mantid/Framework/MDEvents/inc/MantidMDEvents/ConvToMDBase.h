@@ -102,6 +102,9 @@ namespace MDEvents
    bool m_ignoreZeros;
    /// Any special coordinate system used.
    Mantid::API::SpecialCoordinateSystem m_coordinateSystem;
+
+   /// check if the events added since the last split have to be written to the file back end of the target workspace
+   bool shouldWriteBack(size_t eventsAdded)const;
  private:
     /** internal function which do one peace of work, which should be performed by one thread 
       *
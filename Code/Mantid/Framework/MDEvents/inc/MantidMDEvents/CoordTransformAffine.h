@@ -44,6 +44,7 @@ namespace MDEvents
         const Mantid::Kernel::VMD & scaling);
 
     virtual void apply(const coord_t * inputVector, coord_t * outVector) const;
+    virtual void applyMany(const coord_t * inputVectors, coord_t * outVectors, const size_t numPoints) const;
 
     static CoordTransformAffine * combineTransformations(CoordTransform * first, CoordTransform * second);
 
@@ -66,6 +66,7 @@ namespace MDEvents
     std::string toXMLString() const;
     std::string id() const;
     void apply(const coord_t * inputVector, coord_t * outVector) const;
+    void applyMany(const coord_t * inputVectors, coord_t * outVectors, const size_t numPoints) const;
     Mantid::Kernel::Matrix<coord_t> makeAffineMatrix() const;
 
   protected:
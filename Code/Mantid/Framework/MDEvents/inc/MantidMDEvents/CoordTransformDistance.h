@@ -40,6 +40,7 @@ namespace MDEvents
     virtual std::string id() const;
 
     void apply(const coord_t * inputVector, coord_t * outVector) const;
+    void applyMany(const coord_t * inputVectors, coord_t * outVectors, const size_t numPoints) const;
 
     /// Return the center coordinate array
     const coord_t * getCenter() { return m_center; }
@@ -116,6 +116,7 @@ namespace MDEvents
 
     virtual void getEventsData(std::vector<coord_t> &coordTable,size_t &nColumns)const ;
     virtual void setEventsData(const std::vector<coord_t> &coordTable);
+    virtual void addEventsData(const std::vector<coord_t> &coordTable);
 
 
     virtual void addEvent(const MDE & Evnt);
@@ -145,6 +146,8 @@ namespace MDEvents
     coord_t * getCentroid() const;
     void calculateDimensionStats(MDDimensionStats * stats) const;
     void integrateSphere(Mantid::API::CoordTransform & radiusTransform, const coord_t radiusSquared, signal_t & signal, signal_t & errorSquared) const;
+    void integrateSpheres(Mantid::API::CoordTransform & radiusTransform, const std::vector<coord_t> & radiiSquared,
+                          std::vector<signal_t> & signal, std::vector<signal_t> & errorSquared) const;
     void centroidSphere(Mantid::API::CoordTransform & radiusTransform, const coord_t radiusSquared, coord_t * centroid, signal_t & signal) const;
     void integrateCylinder(Mantid::API::CoordTransform & radiusTransform, const coord_t radius, const coord_t length, signal_t & signal, signal_t & errorSquared, std::vector<signal_t> & signal_fit) const;
  
@@ -174,6 +177,8 @@ namespace MDEvents
      /// Flag indicating that masking has been applied.
     bool m_bIsMasked;
   private:
+    /// Number of event centers transformed with one call when integrating
+    enum {TRANSFORM_BLOCK_SIZE=1024};
 
     /// private default copy constructor as the only correct constructor is the one with the boxController;
     MDBox(const MDBox &);
@@ -94,6 +94,8 @@ namespace MDEvents
      *   Used to convert from a vector of values (2D table in Fortran representation (by rows) into box events. 
 	     Does nothing for GridBox (may be temporary) -- can be combined with build and add events	 */
     virtual void setEventsData(const std::vector<coord_t> &/*coordTable*/) {}
+    /** The method to append the events from the table of data to the box events. Does nothing for GridBox */
+    virtual void addEventsData(const std::vector<coord_t> &/*coordTable*/) {}
     /// Return a copy of contained events
     virtual std::vector< MDE > * getEventsCopy() = 0;
 
@@ -119,6 +121,10 @@ namespace MDEvents
     /** Sphere (peak) integration */
     virtual void integrateSphere(Mantid::API::CoordTransform & radiusTransform, const coord_t radiusSquared, signal_t & signal, signal_t & errorSquared) const = 0;
 
+    /** Integration of several spheres with the same center in one pass */
+    virtual void integrateSpheres(Mantid::API::CoordTransform & radiusTransform, const std::vector<coord_t> & radiiSquared,
+                                  std::vector<signal_t> & signal, std::vector<signal_t> & errorSquared) const = 0;
+
     /** Find the centroid around a sphere */
     virtual void centroidSphere(Mantid::API::CoordTransform & radiusTransform, const coord_t radiusSquared, coord_t * centroid, signal_t & signal) const = 0;
 
@@ -122,6 +122,9 @@ namespace MDEvents
 
     void integrateSphere(Mantid::API::CoordTransform & radiusTransform, const coord_t radiusSquared, signal_t & signal, signal_t & errorSquared) const;
 
+    void integrateSpheres(Mantid::API::CoordTransform & radiusTransform, const std::vector<coord_t> & radiiSquared,
+                          std::vector<signal_t> & signal, std::vector<signal_t> & errorSquared) const;
+
     void centroidSphere(Mantid::API::CoordTransform & radiusTransform, const coord_t radiusSquared, coord_t * centroid, signal_t & signal) const;
 
     void integrateCylinder(Mantid::API::CoordTransform & radiusTransform, const coord_t radius, const coord_t length, signal_t & signal, signal_t & errorSquared, std::vector<signal_t> & signal_fit) const;
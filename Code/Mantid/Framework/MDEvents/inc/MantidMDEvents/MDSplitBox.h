@@ -57,6 +57,10 @@ namespace MDEvents
     void integrateSphere(Mantid::API::CoordTransform & /*radiusTransform*/, const coord_t /*radiusSquared*/, signal_t & /*signal*/, signal_t & /*errorSquared*/) const
     { throw std::runtime_error("Not implemented."); }
 
+    void integrateSpheres(Mantid::API::CoordTransform & /*radiusTransform*/, const std::vector<coord_t> & /*radiiSquared*/,
+                          std::vector<signal_t> & /*signal*/, std::vector<signal_t> & /*errorSquared*/) const
+    { throw std::runtime_error("Not implemented."); }
+
     void centroidSphere(Mantid::API::CoordTransform & , const coord_t , coord_t * , signal_t & ) const
     { throw std::runtime_error("Not implemented."); }
 
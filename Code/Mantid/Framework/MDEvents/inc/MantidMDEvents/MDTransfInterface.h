@@ -122,6 +122,35 @@ public:
      * */
     virtual bool calcMatrixCoord(const double & X,std::vector<coord_t> &Coord, double &signal, double &errSq)const=0;
 
+ /**  The method to calculate the coordinates of a batch of points which share all Y-dependent coordinates, e.g. all events
+    *  of one detector. Equivalent to calling calcMatrixCoord for each point, but subclasses override it to avoid a virtual call
+    *  and the choice of the conversion mode per point.
+     * @param X      -- X values of the points, converted into the units expected by the transformation
+     * @param Coord  -- vector of MD coordinates with the generic and Y-dependent coordinates already set; used as workspace
+     * @param signal -- signals of the points; on return contains (possibly modified) signals of the points within the range only
+     * @param errSq  -- squared errors of the points; on return contains the errors of the points within the range only
+     * @param allCoord -- the coordinates of the points within the range are appended to this vector
+     * @return the number of points within the range requested by algorithm
+     * */
+    virtual size_t calcMatrixCoordBatch(const std::vector<double> &X,std::vector<coord_t> &Coord,
+                                        std::vector<double> &signal,std::vector<double> &errSq,std::vector<coord_t> &allCoord)const
+    {
+      size_t nAccepted(0);
+      for(size_t i=0;i<X.size();i++)
+      {
+        double s   = signal[i];
+        double err = errSq[i];
+        if(!calcMatrixCoord(X[i],Coord,s,err))continue;
+        signal[nAccepted] = s;
+        errSq[nAccepted]  = err;
+        nAccepted++;
+        allCoord.insert(allCoord.end(),Coord.begin(),Coord.end());
+      }
+      signal.resize(nAccepted);
+      errSq.resize(nAccepted);
+      return nAccepted;
+    }
+
     /* clone method allowing to provide the copy of the particular class */
     virtual MDTransfInterface * clone() const = 0;
     // destructor
@@ -55,6 +55,8 @@ public:
     bool calcGenericVariables(std::vector<coord_t> &Coord, size_t nd);
     bool calcYDepCoordinates(std::vector<coord_t> &Coord,size_t i);
     bool calcMatrixCoord(const double& k0,std::vector<coord_t> &Coord, double &s, double &err)const;
+    size_t calcMatrixCoordBatch(const std::vector<double> &X,std::vector<coord_t> &Coord,
+                                std::vector<double> &signal,std::vector<double> &errSq,std::vector<coord_t> &allCoord)const;
     // constructor;
     MDTransfModQ();
     /* clone method allowing to provide the copy of the particular class */
@@ -52,6 +52,8 @@ public:
     const std::string transfID()const; // {return "Q3D"; }
     bool calcYDepCoordinates(std::vector<coord_t> &Coord,size_t i);   
     bool calcMatrixCoord(const double& X,std::vector<coord_t> &Coord, double &s, double &err)const;
+    size_t calcMatrixCoordBatch(const std::vector<double> &X,std::vector<coord_t> &Coord,
+                                std::vector<double> &signal,std::vector<double> &errSq,std::vector<coord_t> &allCoord)const;
     // constructor;
     MDTransfQ3D();
     /* clone method allowing to provide the copy of the particular class */
@@ -77,6 +77,7 @@ public:
     void initialize(const std::string &unitsFrom,const std::string &unitsTo,const DataObjects::TableWorkspace_const_sptr &DetWS,int Emode,bool forceViaTOF=false);
     void updateConversion(size_t i);
     double convertUnits(double val)const;   
+    void convertUnits(std::vector<double> &vals)const;
 
     bool isUnitConverted()const;
     std::pair<double,double> getConversionRange(double x1,double x2)const;
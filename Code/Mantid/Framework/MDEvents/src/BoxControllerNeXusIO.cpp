@@ -24,6 +24,7 @@ namespace MDEvents
        m_File(NULL),
        m_ReadOnly(true),
        m_dataChunk(DATA_CHUNK),  
+       m_compression(::NeXus::NONE),
        m_bc(bc),
        m_BlockStart(2,0),
        m_BlockSize(2,0),
@@ -210,9 +211,9 @@ namespace MDEvents
 
         // Make and open the data
         if(m_CoordSize==4)
-            m_File->makeCompData("event_data", ::NeXus::FLOAT32, m_BlockSize, ::NeXus::NONE, chunk, true);
+            m_File->makeCompData("event_data", ::NeXus::FLOAT32, m_BlockSize, m_compression, chunk, true);
         else
-            m_File->makeCompData("event_data", ::NeXus::FLOAT64, m_BlockSize, ::NeXus::NONE, chunk, true);
+            m_File->makeCompData("event_data", ::NeXus::FLOAT64, m_BlockSize, m_compression, chunk, true);
 
         // A little bit of description for humans to read later
         m_File->putAttr("description", m_EventsTypeHeaders[m_EventType]);
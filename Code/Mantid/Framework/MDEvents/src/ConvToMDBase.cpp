@@ -97,6 +97,20 @@ namespace Mantid
       m_coordinateSystem(Mantid::API::None)
     { }
 
+    /** Check if the events added to a file-backed target workspace since the last split exceed the size of its write buffer.
+      * The boxes are marked for writing to the file when they are split, so splitting at least that often keeps the number of
+      * events held in memory bounded by the write buffer rather than by the size of the workspace.
+      *
+      *@param eventsAdded -- the number of events added to the target workspace since the last split
+      *@return true if the boxes have to be split and written to the file back end, false if the workspace is in memory
+    */
+    bool ConvToMDBase::shouldWriteBack(size_t eventsAdded)const
+    {
+      API::BoxController_sptr bc = m_OutWSWrapper->pWorkspace()->getBoxController();
+      if(!bc->isFileBacked())return false;
+      return eventsAdded > bc->getFileIO()->getWriteBufferSize();
+    }
+
 
 
   } // endNamespace MDAlgorithms
@@ -29,46 +29,40 @@ namespace Mantid
       if(!m_QConverter->calcYDepCoordinates(locCoord,workspaceIndex))return 0;   // skip if any y outsize of the range of interest;
       localUnitConv.updateConversion(workspaceIndex);
       //
-      // allocate temporary buffers for MD Events data
-      // MD events coordinates buffer
-      std::vector<coord_t>  allCoord;
-      std::vector<float>    sig_err;       // array for signal and error. 
-      std::vector<uint16_t> run_index;     // Buffer for run index for each event 
-      std::vector<uint32_t> det_ids;       // Buffer of det Id-s for each event
-
-      allCoord.reserve(this->m_NDims*numEvents);     sig_err.reserve(2*numEvents);
-      run_index.reserve(numEvents);                 det_ids.reserve(numEvents);
-
       // This little dance makes the getting vector of events more general (since you can't overload by return type).
       typename std::vector<T>const * events_ptr;
       getEventsFrom(el, events_ptr);
       const typename std::vector<T> & events = *events_ptr;
 
-
-
-      // Iterators to start/end
-      typename std::vector<T>::const_iterator it = events.begin();
-      typename std::vector<T>::const_iterator it_end = events.end();
-
-
-      it = events.begin();
-      for (; it != it_end; it++)
+      // copy the event data into contiguous arrays to convert the whole event list at once
+      std::vector<double> xVal(numEvents);
+      std::vector<double> signal(numEvents);
+      std::vector<double> errorSq(numEvents);
+      for (size_t i = 0; i < numEvents; i++)
       {
-        double val=localUnitConv.convertUnits(it->tof());
-        double signal = it->weight();
-        double errorSq= it->errorSquared();
-        if(!m_QConverter->calcMatrixCoord(val,locCoord,signal,errorSq))continue; // skip ND outside the range
+        const T & event = events[i];
+        xVal[i]    = event.tof();
+        signal[i]  = event.weight();
+        errorSq[i] = event.errorSquared();
+      }
+      localUnitConv.convertUnits(xVal);
 
+      // MD events coordinates buffer
+      std::vector<coord_t>  allCoord;
+      allCoord.reserve(this->m_NDims*numEvents);
+      size_t n_added_events = m_QConverter->calcMatrixCoordBatch(xVal,locCoord,signal,errorSq,allCoord); // skip ND outside the range
 
-        sig_err.push_back(float(signal));
-        sig_err.push_back(float(errorSq));
-        run_index.push_back(runIndexLoc);
-        det_ids.push_back(detID);
-        allCoord.insert(allCoord.end(),locCoord.begin(),locCoord.end());
+      // allocate temporary buffers for MD Events data
+      std::vector<float>    sig_err(2*n_added_events);       // array for signal and error. 
+      std::vector<uint16_t> run_index(n_added_events,runIndexLoc);     // Buffer for run index for each event 
+      std::vector<uint32_t> det_ids(n_added_events,detID);       // Buffer of det Id-s for each event
+      for (size_t i = 0; i < n_added_events; i++)
+      {
+        sig_err[2*i]   = float(signal[i]);
+        sig_err[2*i+1] = float(errorSq[i]);
       }
 
       // Add them to the MDEW
-      size_t n_added_events = run_index.size();
       m_OutWSWrapper->addMDData(sig_err,run_index,det_ids,allCoord,n_added_events);
       return n_added_events;
     }
@@ -155,7 +149,7 @@ namespace Mantid
         //ts->push( new FunctionTask( func, cost) );
 
         // Keep a running total of how many events we've added
-        if (bc->shouldSplitBoxes(nEventsInWS,eventsAdded, lastNumBoxes))
+        if (bc->shouldSplitBoxes(nEventsInWS,eventsAdded, lastNumBoxes)||this->shouldWriteBack(eventsAdded))
         {
           if(runMultithreaded)
           {
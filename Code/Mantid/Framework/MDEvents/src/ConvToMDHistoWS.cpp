@@ -198,7 +198,7 @@ namespace Mantid
         nEventsInWS +=nThreadEv;
 
 
-        if (bc->shouldSplitBoxes(nEventsInWS,nAddedEvents,lastNumBoxes))
+        if (bc->shouldSplitBoxes(nEventsInWS,nAddedEvents,lastNumBoxes)||this->shouldWriteBack(nAddedEvents))
         {
           if(runMultithreaded)
           {
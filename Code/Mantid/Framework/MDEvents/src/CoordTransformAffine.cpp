@@ -233,6 +233,61 @@ namespace MDEvents
   }
 
 
+  namespace
+  {
+    /** Transform numPoints points with the affine matrix, with the number of input dimensions
+     * known at compile time so the inner loop is unrolled and the points can be vectorised.
+     *
+     * @param rawMatrix :: the affine matrix, outD rows of inD+1 values
+     * @param outD :: number of output dimensions
+     * @param in :: the input points, inD coordinates each
+     * @param out :: the output points, outD coordinates each
+     * @param numPoints :: number of points
+     */
+    template<size_t inD>
+    void applyAffineMany(coord_t ** rawMatrix, const size_t outD, const coord_t * in, coord_t * out, const size_t numPoints)
+    {
+      for (size_t i = 0; i < numPoints; ++i)
+      {
+        const coord_t * point = in + i * inD;
+        coord_t * result = out + i * outD;
+        for (size_t o = 0; o < outD; ++o)
+        {
+          const coord_t * row = rawMatrix[o];
+          coord_t outVal = 0.0;
+          for (size_t d = 0; d < inD; ++d)
+            outVal += row[d] * point[d];
+          // The last input coordinate is "1" always, as in apply()
+          result[o] = outVal + row[inD];
+        }
+      }
+    }
+  }
+
+  //----------------------------------------------------------------------------------------------
+  /** Apply the coordinate transformation to several points
+   *
+   * @param inputVectors :: numPoints points of inD coordinates each, one after another
+   * @param outVectors :: numPoints*outD array filled with the transformed points
+   * @param numPoints :: the number of points to transform
+   */
+  void CoordTransformAffine::applyMany(const coord_t * inputVectors, coord_t * outVectors, const size_t numPoints) const
+  {
+    switch (inD)
+    {
+    case 1: applyAffineMany<1>(rawMatrix, outD, inputVectors, outVectors, numPoints); break;
+    case 2: applyAffineMany<2>(rawMatrix, outD, inputVectors, outVectors, numPoints); break;
+    case 3: applyAffineMany<3>(rawMatrix, outD, inputVectors, outVectors, numPoints); break;
+    case 4: applyAffineMany<4>(rawMatrix, outD, inputVectors, outVectors, numPoints); break;
+    case 5: applyAffineMany<5>(rawMatrix, outD, inputVectors, outVectors, numPoints); break;
+    case 6: applyAffineMany<6>(rawMatrix, outD, inputVectors, outVectors, numPoints); break;
+    default:
+      for (size_t i = 0; i < numPoints; ++i)
+        this->apply(inputVectors + i * inD, outVectors + i * outD);
+    }
+  }
+
+
   //----------------------------------------------------------------------------------------------
   /** Serialize the coordinate transform
   *
@@ -113,6 +113,25 @@ namespace MDEvents
     }
   }
 
+  //----------------------------------------------------------------------------------------------
+  /** Apply the coordinate transformation to several points
+   *
+   * @param inputVectors :: numPoints points of inD coordinates each, one after another
+   * @param outVectors :: numPoints*outD array filled with the transformed points
+   * @param numPoints :: the number of points to transform
+   */
+  void CoordTransformAligned::applyMany(const coord_t * inputVectors, coord_t * outVectors, const size_t numPoints) const
+  {
+    for (size_t out = 0; out < outD; ++out)
+    {
+      const size_t in = m_dimensionToBinFrom[out];
+      const coord_t origin = m_origin[out];
+      const coord_t scaling = m_scaling[out];
+      for (size_t i = 0; i < numPoints; ++i)
+        outVectors[i * outD + out] = (inputVectors[i * inD + in] - origin) * scaling;
+    }
+  }
+
   //----------------------------------------------------------------------------------------------
   /** Create an equivalent affine transformation matrix out of the
    * parameters of this axis-aligned transformation.
@@ -106,6 +106,35 @@ namespace MDEvents
 	}
   }
 
+  //----------------------------------------------------------------------------------------------
+  /** Apply the coordinate transformation to several points
+   *
+   * @param inputVectors :: numPoints points of inD coordinates each, one after another
+   * @param outVectors :: numPoints*outD array filled with the transformed points
+   * @param numPoints :: the number of points to transform
+   */
+  void CoordTransformDistance::applyMany(const coord_t * inputVectors, coord_t * outVectors, const size_t numPoints) const
+  {
+    if (outD != 1)
+    {
+      CoordTransform::applyMany(inputVectors, outVectors, numPoints);
+      return;
+    }
+    // The distance squared only: start from zero and add the used dimensions one by one
+    for (size_t i = 0; i < numPoints; ++i)
+      outVectors[i] = 0;
+    for (size_t d = 0; d < inD; ++d)
+    {
+      if (!m_dimensionsUsed[d]) continue;
+      const coord_t center = m_center[d];
+      for (size_t i = 0; i < numPoints; ++i)
+      {
+        coord_t dist = inputVectors[i * inD + d] - center;
+        outVectors[i] += (dist * dist);
+      }
+    }
+  }
+
   //----------------------------------------------------------------------------------------------
   /** Serialize the coordinate transform distance
   *
@@ -5,6 +5,7 @@
 #include "MantidKernel/DiskBuffer.h"
 #include "MantidMDEvents/MDGridBox.h"
 #include <boost/math/special_functions/round.hpp>
+#include <algorithm>
 #include <cmath>
 
 using namespace Mantid::API;
@@ -350,6 +351,17 @@ namespace MDEvents
   {
       MDE::dataToEvents(coordTable, this->data);
   };
+    /** The method to convert the table of data into events and append them to the events already in the box
+     *   Used to merge events loaded from files. Call reserveMemoryForLoad first to avoid reallocations.
+     *   @param coordTable -- vector of events parameters, which will be converted into events
+                               signal error and coordinates
+     */
+  TMDE(
+  void MDBox)::addEventsData(const std::vector<coord_t> &coordTable)
+  {
+      Poco::ScopedLock<Kernel::Mutex> _lock(this->m_dataMutex);
+      MDE::dataToEvents(coordTable, this->data, false);
+  };
 
  
 
@@ -592,18 +604,28 @@ namespace MDEvents
   {
     // If the box is cached to disk, you need to retrieve it
     const std::vector<MDE> & events = this->getConstEvents();
-    typename std::vector<MDE>::const_iterator it = events.begin();
-    typename std::vector<MDE>::const_iterator it_end = events.end();
-
-    // For each MDLeanEvent
-    for (; it != it_end; ++it)
+    const size_t numEvents = events.size();
+    const size_t blockSize = std::min(numEvents, size_t(TRANSFORM_BLOCK_SIZE));
+    const size_t outD = radiusTransform.getOutD();
+    std::vector<coord_t> centers(blockSize * nd);
+    std::vector<coord_t> out(blockSize * outD);
+
+    // For each block of MDLeanEvents, transform all the centers at once
+    for (size_t blockStart = 0; blockStart < numEvents; blockStart += blockSize)
     {
-      coord_t out[nd];
-      radiusTransform.apply(it->getCenter(), out);
-      if (out[0] < radiusSquared)
+      const size_t numInBlock = std::min(blockSize, numEvents - blockStart);
+      for (size_t i = 0; i < numInBlock; i++)
+        std::copy(events[blockStart + i].getCenter(), events[blockStart + i].getCenter() + nd, centers.begin() + i * nd);
+      radiusTransform.applyMany(centers.data(), out.data(), numInBlock);
+
+      for (size_t i = 0; i < numInBlock; i++)
       {
-        signal += static_cast<signal_t>(it->getSignal());
-        errorSquared += static_cast<signal_t>(it->getErrorSquared());
+        if (out[i * outD] < radiusSquared)
+        {
+          const MDE & event = events[blockStart + i];
+          signal += static_cast<signal_t>(event.getSignal());
+          errorSquared += static_cast<signal_t>(event.getErrorSquared());
+        }
       }
     }
     // it is constant access, so no saving or fiddling with the buffer is needed. Events just can be dropped if necessary
@@ -614,6 +636,55 @@ namespace MDEvents
     }
   }
 
+  /** Integrate the signal within several spheres with the same center, going through the events once.
+   *
+   * @param radiusTransform :: nd-to-1 coordinate transformation that converts from these
+   *        dimensions to the distance (squared) from the center of the spheres.
+   * @param radiiSquared :: radius^2 below which to integrate, for each sphere
+   * @param[out] signal :: the integrated signal of each sphere is added to the element at its index
+   * @param[out] errorSquared :: the integrated squared error of each sphere is added to the element at its index
+   */
+  TMDE(
+  void MDBox)::integrateSpheres(Mantid::API::CoordTransform & radiusTransform, const std::vector<coord_t> & radiiSquared,
+                                std::vector<signal_t> & signal, std::vector<signal_t> & errorSquared) const
+  {
+    const size_t numRadii = radiiSquared.size();
+    // If the box is cached to disk, you need to retrieve it
+    const std::vector<MDE> & events = this->getConstEvents();
+    const size_t numEvents = events.size();
+    const size_t blockSize = std::min(numEvents, size_t(TRANSFORM_BLOCK_SIZE));
+    const size_t outD = radiusTransform.getOutD();
+    std::vector<coord_t> centers(blockSize * nd);
+    std::vector<coord_t> out(blockSize * outD);
+
+    // For each block of MDLeanEvents, transform all the centers at once
+    for (size_t blockStart = 0; blockStart < numEvents; blockStart += blockSize)
+    {
+      const size_t numInBlock = std::min(blockSize, numEvents - blockStart);
+      for (size_t i = 0; i < numInBlock; i++)
+        std::copy(events[blockStart + i].getCenter(), events[blockStart + i].getCenter() + nd, centers.begin() + i * nd);
+      radiusTransform.applyMany(centers.data(), out.data(), numInBlock);
+
+      for (size_t i = 0; i < numInBlock; i++)
+      {
+        const coord_t distanceSquared = out[i * outD];
+        const MDE & event = events[blockStart + i];
+        for (size_t r = 0; r < numRadii; r++)
+        {
+          if (distanceSquared < radiiSquared[r])
+          {
+            signal[r] += static_cast<signal_t>(event.getSignal());
+            errorSquared[r] += static_cast<signal_t>(event.getErrorSquared());
+          }
+        }
+      }
+    }
+    if(m_Saveable)
+    {
+        m_Saveable->setBusy(false);  
+    }
+  }
+
   /** Integrate the signal within a sphere; for example, to perform single-crystal
    * peak integration.
    * The CoordTransform object could be used for more complex shapes, e.g. "lentil" integration, as long
@@ -684,20 +755,30 @@ namespace MDEvents
   {
     // If the box is cached to disk, you need to retrieve it
     const std::vector<MDE> & events = this->getConstEvents();
-    typename std::vector<MDE>::const_iterator it = events.begin();
-    typename std::vector<MDE>::const_iterator it_end = events.end();
-
-    // For each MDLeanEvent
-    for (; it != it_end; ++it)
+    const size_t numEvents = events.size();
+    const size_t blockSize = std::min(numEvents, size_t(TRANSFORM_BLOCK_SIZE));
+    const size_t outD = radiusTransform.getOutD();
+    std::vector<coord_t> centers(blockSize * nd);
+    std::vector<coord_t> out(blockSize * outD);
+
+    // For each block of MDLeanEvents, transform all the centers at once
+    for (size_t blockStart = 0; blockStart < numEvents; blockStart += blockSize)
     {
-      coord_t out[nd];
-      radiusTransform.apply(it->getCenter(), out);
-      if (out[0] < radiusSquared)
+      const size_t numInBlock = std::min(blockSize, numEvents - blockStart);
+      for (size_t i = 0; i < numInBlock; i++)
+        std::copy(events[blockStart + i].getCenter(), events[blockStart + i].getCenter() + nd, centers.begin() + i * nd);
+      radiusTransform.applyMany(centers.data(), out.data(), numInBlock);
+
+      for (size_t i = 0; i < numInBlock; i++)
       {
-        coord_t eventSignal = static_cast<coord_t>(it->getSignal());
-        signal += signal_t(eventSignal);
-        for (size_t d=0; d<nd; d++)
-          centroid[d] += it->getCenter(d) * eventSignal;
+        if (out[i * outD] < radiusSquared)
+        {
+          const MDE & event = events[blockStart + i];
+          coord_t eventSignal = static_cast<coord_t>(event.getSignal());
+          signal += signal_t(eventSignal);
+          for (size_t d=0; d<nd; d++)
+            centroid[d] += event.getCenter(d) * eventSignal;
+        }
       }
     }
     // it is constant access, so no saving or fiddling with the buffer is needed. Events just can be dropped if necessary
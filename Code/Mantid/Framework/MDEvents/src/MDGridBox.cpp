@@ -1273,6 +1273,156 @@ namespace MDEvents
   }
 
 
+  //-----------------------------------------------------------------------------------------------
+  /** Integrate the signal within several spheres with the same center, e.g. a peak and its
+   * background shell. Works as integrateSphere() but the vertices and boxes are only
+   * visited once for all the spheres.
+   *
+   * @param radiusTransform :: nd-to-1 coordinate transformation that converts from these
+   *        dimensions to the distance (squared) from the center of the spheres.
+   * @param radiiSquared :: radius^2 below which to integrate, for each sphere
+   * @param signal [out] :: the integrated signal of each sphere is added to the element at its index
+   * @param errorSquared [out] :: the integrated squared error of each sphere is added to the element at its index
+   */
+  TMDE(
+  void MDGridBox)::integrateSpheres(CoordTransform & radiusTransform, const std::vector<coord_t> & radiiSquared,
+                                    std::vector<signal_t> & signal, std::vector<signal_t> & errorSquared) const
+  {
+    const size_t numRadii = radiiSquared.size();
+    if (numRadii == 0)
+      return;
+
+    // The # of vertices of each box contained in each sphere, at [box * numRadii + sphere]
+    std::vector<size_t> verticesContained(numBoxes * numRadii, 0);
+
+    // How many vertices does one box have? 2^nd, or bitwise shift left 1 by nd bits
+    size_t maxVertices = 1 << nd;
+
+    // set up caches for box sizes and min box values
+    coord_t boxSize[nd];
+    coord_t minBoxVal[nd];
+
+    // The number of vertices in each dimension is the # split[d] + 1
+    size_t vertices_max[nd]; Utils::NestedForLoop::SetUp(nd, vertices_max, 0);
+    for (size_t d=0; d<nd; ++d)
+    {
+      vertices_max[d] = split[d]+1;
+      boxSize[d]     = static_cast<coord_t>(m_SubBoxSize[d]);
+      minBoxVal[d]   = static_cast<coord_t>(this->extents[d].getMin());
+    }
+
+    // The index to the vertex in each dimension
+    size_t vertexIndex[nd]; Utils::NestedForLoop::SetUp(nd, vertexIndex, 0);
+    size_t boxIndex[nd]; Utils::NestedForLoop::SetUp(nd, boxIndex, 0);
+    size_t indexMaker[nd]; Utils::NestedForLoop::SetUpIndexMaker(nd, indexMaker, split);
+
+    bool allDone = false;
+    while (!allDone)
+    {
+      // Coordinates of this vertex
+      coord_t vertexCoord[nd];
+      for (size_t d=0; d<nd; ++d)
+        vertexCoord[d] = static_cast<coord_t>(vertexIndex[d])*boxSize[d] +minBoxVal[d];
+
+      // The distance is computed once for all the spheres
+      coord_t out[nd];
+      radiusTransform.apply(vertexCoord, out);
+      bool contained = false;
+      for (size_t r=0; r<numRadii; ++r)
+        contained = contained || (out[0] < radiiSquared[r]);
+      if (contained)
+      {
+        // This vertex is shared by up to 2^nd adjacent boxes (left-right along each dimension).
+        for (size_t neighb=0; neighb<maxVertices; ++neighb)
+        {
+          bool badIndex = false;
+          for (size_t d=0; d<nd;d++)
+          {
+            boxIndex[d] = vertexIndex[d] - ((neighb & ((size_t)1 << d)) >> d);
+            if (boxIndex[d] >= split[d])
+            {
+              badIndex = true;
+              break;
+            }
+          }
+          if (!badIndex)
+          {
+            size_t linearIndex = Utils::NestedForLoop::GetLinearIndex(nd, boxIndex, indexMaker);
+            for (size_t r=0; r<numRadii; ++r)
+            {
+              if (out[0] < radiiSquared[r])
+                verticesContained[linearIndex * numRadii + r]++;
+            }
+          }
+        }
+      }
+
+      // Increment the counter(s) in the nested for loops.
+      allDone = Utils::NestedForLoop::Increment(nd, vertexIndex, vertices_max);
+    }
+
+    // The spheres that a box might be partially in, with their index in radiiSquared
+    std::vector<coord_t> partialRadiiSquared;
+    std::vector<size_t> partialRadii;
+    std::vector<signal_t> partialSignal, partialErrorSquared;
+    for (size_t i=0; i < numBoxes; ++i)
+    {
+      API::IMDNode * box = m_Children[i];
+      partialRadiiSquared.clear();
+      partialRadii.clear();
+      bool haveCenterDistance = false;
+      coord_t centerDistance = 0;
+
+      for (size_t r=0; r<numRadii; ++r)
+      {
+        const size_t contained = verticesContained[i * numRadii + r];
+        if (contained >= maxVertices)
+        {
+          // Fully contained: use the integrated sum of signal in the box
+          signal[r] += box->getSignal();
+          errorSquared[r] += box->getErrorSquared();
+          continue;
+        }
+
+        bool partialBox = (contained > 0);
+        if (!partialBox)
+        {
+          // There is a chance that this part of the box is within the sphere,
+          // even if no vertex of it is. Same test as integrateSphere().
+          if (!haveCenterDistance)
+          {
+            coord_t boxCenter[nd];
+            box->getCenter(boxCenter);
+            coord_t out[nd];
+            radiusTransform.apply(boxCenter, out);
+            centerDistance = out[0];
+            haveCenterDistance = true;
+          }
+          partialBox = (centerDistance < diagonalSquared*0.72 + radiiSquared[r]);
+        }
+        if (partialBox)
+        {
+          partialRadiiSquared.push_back(radiiSquared[r]);
+          partialRadii.push_back(r);
+        }
+      }
+
+      if (!partialRadiiSquared.empty())
+      {
+        // Use the detailed integration method, once for all the spheres the box might be in
+        partialSignal.assign(partialRadiiSquared.size(), 0);
+        partialErrorSquared.assign(partialRadiiSquared.size(), 0);
+        box->integrateSpheres(radiusTransform, partialRadiiSquared, partialSignal, partialErrorSquared);
+        for (size_t j=0; j < partialRadii.size(); ++j)
+        {
+          signal[partialRadii[j]] += partialSignal[j];
+          errorSquared[partialRadii[j]] += partialErrorSquared[j];
+        }
+      }
+    }
+  }
+
+
   //-----------------------------------------------------------------------------------------------
   /** Find the centroid of all events contained within by doing a weighted average
    * of their coordinates.
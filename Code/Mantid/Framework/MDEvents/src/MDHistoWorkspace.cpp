@@ -1,5 +1,6 @@
 #include "MantidGeometry/MDGeometry/IMDDimension.h"
 #include "MantidGeometry/MDGeometry/MDGeometryXMLBuilder.h"
+#include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/System.h"
 #include "MantidKernel/Utils.h"
 #include "MantidKernel/VMD.h"
@@ -21,6 +22,12 @@ namespace Mantid
 {
 namespace MDEvents
 {
+  namespace
+  {
+    /// Element-by-element operations on fewer bins than this are not split between threads
+    const size_t MIN_PARALLEL_LENGTH = 10000;
+  }
+
   //----------------------------------------------------------------------------------------------
   /** Constructor given the 4 dimensions
    * @param dimX :: X dimension binning parameters
@@ -250,14 +257,15 @@ namespace MDEvents
    */
   void MDHistoWorkspace::setTo(signal_t signal, signal_t errorSquared, signal_t numEvents)
   {
-    for (size_t i=0; i < m_length; i++)
+    PARALLEL_FOR_IF(m_length > MIN_PARALLEL_LENGTH)
+    for (int64_t i=0; i < int64_t(m_length); i++)
     {
       m_signals[i] = signal;
       m_errorsSquared[i] = errorSquared;
       m_numEvents[i] = numEvents;
       m_masks[i] = false; //Not masked by default;
-      m_nEventsContributed+=uint64_t(numEvents);
     }
+    m_nEventsContributed += uint64_t(numEvents) * m_length;
   }
 
   //----------------------------------------------------------------------------------------------
@@ -673,7 +681,8 @@ namespace MDEvents
   void MDHistoWorkspace::add(const MDHistoWorkspace & b)
   {
     checkWorkspaceSize(b, "add");
-    for (size_t i=0; i<m_length; ++i)
+    PARALLEL_FOR_IF(m_length > MIN_PARALLEL_LENGTH)
+    for (int64_t i=0; i<int64_t(m_length); ++i)
     {
       m_signals[i] += b.m_signals[i];
       m_errorsSquared[i] += b.m_errorsSquared[i];
@@ -691,7 +700,8 @@ namespace MDEvents
   void MDHistoWorkspace::add(const signal_t signal, const signal_t error)
   {
     signal_t errorSquared = error * error;
-    for (size_t i=0; i<m_length; ++i)
+    PARALLEL_FOR_IF(m_length > MIN_PARALLEL_LENGTH)
+    for (int64_t i=0; i<int64_t(m_length); ++i)
     {
       m_signals[i] += signal;
       m_errorsSquared[i] += errorSquared;
@@ -718,7 +728,8 @@ namespace MDEvents
   void MDHistoWorkspace::subtract(const MDHistoWorkspace & b)
   {
     checkWorkspaceSize(b, "subtract");
-    for (size_t i=0; i<m_length; ++i)
+    PARALLEL_FOR_IF(m_length > MIN_PARALLEL_LENGTH)
+    for (int64_t i=0; i<int64_t(m_length); ++i)
     {
       m_signals[i] -= b.m_signals[i];
       m_errorsSquared[i] += b.m_errorsSquared[i];
@@ -736,7 +747,8 @@ namespace MDEvents
   void MDHistoWorkspace::subtract(const signal_t signal, const signal_t error)
   {
     signal_t errorSquared = error * error;
-    for (size_t i=0; i<m_length; ++i)
+    PARALLEL_FOR_IF(m_length > MIN_PARALLEL_LENGTH)
+    for (int64_t i=0; i<int64_t(m_length); ++i)
     {
       m_signals[i] -= signal;
       m_errorsSquared[i] += errorSquared;
@@ -768,7 +780,8 @@ namespace MDEvents
   void MDHistoWorkspace::multiply(const MDHistoWorkspace & b_ws)
   {
     checkWorkspaceSize(b_ws, "multiply");
-    for (size_t i=0; i<m_length; ++i)
+    PARALLEL_FOR_IF(m_length > MIN_PARALLEL_LENGTH)
+    for (int64_t i=0; i<int64_t(m_length); ++i)
     {
       signal_t a = m_signals[i];
       signal_t da2 = m_errorsSquared[i];
@@ -798,7 +811,8 @@ namespace MDEvents
     signal_t b = signal;
     signal_t db2 = error * error;
     signal_t db2_relative = db2 / (b*b);
-    for (size_t i=0; i<m_length; ++i)
+    PARALLEL_FOR_IF(m_length > MIN_PARALLEL_LENGTH)
+    for (int64_t i=0; i<int64_t(m_length); ++i)
     {
       signal_t a = m_signals[i];
       signal_t da2 = m_errorsSquared[i];
@@ -837,7 +851,8 @@ namespace MDEvents
   void MDHistoWorkspace::divide(const MDHistoWorkspace & b_ws)
   {
     checkWorkspaceSize(b_ws, "divide");
-    for (size_t i=0; i<m_length; ++i)
+    PARALLEL_FOR_IF(m_length > MIN_PARALLEL_LENGTH)
+    for (int64_t i=0; i<int64_t(m_length); ++i)
     {
       signal_t a = m_signals[i];
       signal_t da2 = m_errorsSquared[i];
@@ -869,7 +884,8 @@ namespace MDEvents
     signal_t b = signal;
     signal_t db2 = error * error;
     signal_t db2_relative = db2 / (b*b);
-    for (size_t i=0; i<m_length; ++i)
+    PARALLEL_FOR_IF(m_length > MIN_PARALLEL_LENGTH)
+    for (int64_t i=0; i<int64_t(m_length); ++i)
     {
       signal_t a = m_signals[i];
       signal_t da2 = m_errorsSquared[i];
@@ -890,7 +906,8 @@ namespace MDEvents
    */
   void MDHistoWorkspace::log(double filler)
   {
-    for (size_t i=0; i<m_length; ++i)
+    PARALLEL_FOR_IF(m_length > MIN_PARALLEL_LENGTH)
+    for (int64_t i=0; i<int64_t(m_length); ++i)
     {
       signal_t a = m_signals[i];
       signal_t da2 = m_errorsSquared[i];
@@ -915,7 +932,8 @@ namespace MDEvents
    */
   void MDHistoWorkspace::log10(double filler)
   {
-    for (size_t i=0; i<m_length; ++i)
+    PARALLEL_FOR_IF(m_length > MIN_PARALLEL_LENGTH)
+    for (int64_t i=0; i<int64_t(m_length); ++i)
     {
       signal_t a = m_signals[i];
       signal_t da2 = m_errorsSquared[i];
@@ -940,7 +958,8 @@ namespace MDEvents
    */
   void MDHistoWorkspace::exp()
   {
-    for (size_t i=0; i<m_length; ++i)
+    PARALLEL_FOR_IF(m_length > MIN_PARALLEL_LENGTH)
+    for (int64_t i=0; i<int64_t(m_length); ++i)
     {
       signal_t f = std::exp(m_signals[i]);
       signal_t da2 = m_errorsSquared[i];
@@ -958,7 +977,8 @@ namespace MDEvents
   void MDHistoWorkspace::power(double exponent)
   {
     double exponent_squared = exponent * exponent;
-    for (size_t i=0; i<m_length; ++i)
+    PARALLEL_FOR_IF(m_length > MIN_PARALLEL_LENGTH)
+    for (int64_t i=0; i<int64_t(m_length); ++i)
     {
       signal_t a = m_signals[i];
       signal_t f = std::pow(a, exponent);
@@ -982,7 +1002,8 @@ namespace MDEvents
   MDHistoWorkspace & MDHistoWorkspace::operator&=(const MDHistoWorkspace & b)
   {
     checkWorkspaceSize(b, "&= (and)");
-    for (size_t i=0; i<m_length; ++i)
+    PARALLEL_FOR_IF(m_length > MIN_PARALLEL_LENGTH)
+    for (int64_t i=0; i<int64_t(m_length); ++i)
     {
       m_signals[i] = ((m_signals[i] != 0) && (b.m_signals[i] != 0)) ? 1.0 : 0.0;
       m_errorsSquared[i] = 0;
@@ -1000,7 +1021,8 @@ namespace MDEvents
   MDHistoWorkspace & MDHistoWorkspace::operator|=(const MDHistoWorkspace & b)
   {
     checkWorkspaceSize(b, "|= (or)");
-    for (size_t i=0; i<m_length; ++i)
+    PARALLEL_FOR_IF(m_length > MIN_PARALLEL_LENGTH)
+    for (int64_t i=0; i<int64_t(m_length); ++i)
     {
       m_signals[i] = ((m_signals[i] != 0) || (b.m_signals[i] != 0)) ? 1.0 : 0.0;
       m_errorsSquared[i] = 0;
@@ -1018,7 +1040,8 @@ namespace MDEvents
   MDHistoWorkspace & MDHistoWorkspace::operator^=(const MDHistoWorkspace & b)
   {
     checkWorkspaceSize(b, "^= (xor)");
-    for (size_t i=0; i<m_length; ++i)
+    PARALLEL_FOR_IF(m_length > MIN_PARALLEL_LENGTH)
+    for (int64_t i=0; i<int64_t(m_length); ++i)
     {
       m_signals[i] = ((m_signals[i] != 0) ^ (b.m_signals[i] != 0)) ? 1.0 : 0.0;
       m_errorsSquared[i] = 0;
@@ -1034,7 +1057,8 @@ namespace MDEvents
    */
   void MDHistoWorkspace::operatorNot()
   {
-    for (size_t i=0; i<m_length; ++i)
+    PARALLEL_FOR_IF(m_length > MIN_PARALLEL_LENGTH)
+    for (int64_t i=0; i<int64_t(m_length); ++i)
     {
       m_signals[i] = (m_signals[i] == 0.0);
       m_errorsSquared[i] = 0;
@@ -1053,7 +1077,8 @@ namespace MDEvents
   void MDHistoWorkspace::lessThan(const MDHistoWorkspace & b)
   {
     checkWorkspaceSize(b, "lessThan");
-    for (size_t i=0; i<m_length; ++i)
+    PARALLEL_FOR_IF(m_length > MIN_PARALLEL_LENGTH)
+    for (int64_t i=0; i<int64_t(m_length); ++i)
     {
       m_signals[i] = (m_signals[i] < b.m_signals[i]) ? 1.0 : 0.0;
       m_errorsSquared[i] = 0;
@@ -1070,7 +1095,8 @@ namespace MDEvents
    */
   void MDHistoWorkspace::lessThan(const signal_t signal)
   {
-    for (size_t i=0; i<m_length; ++i)
+    PARALLEL_FOR_IF(m_length > MIN_PARALLEL_LENGTH)
+    for (int64_t i=0; i<int64_t(m_length); ++i)
     {
       m_signals[i] = (m_signals[i] < signal) ? 1.0 : 0.0;
       m_errorsSquared[i] = 0;
@@ -1088,7 +1114,8 @@ namespace MDEvents
   void MDHistoWorkspace::greaterThan(const MDHistoWorkspace & b)
   {
     checkWorkspaceSize(b, "greaterThan");
-    for (size_t i=0; i<m_length; ++i)
+    PARALLEL_FOR_IF(m_length > MIN_PARALLEL_LENGTH)
+    for (int64_t i=0; i<int64_t(m_length); ++i)
     {
       m_signals[i] = (m_signals[i] > b.m_signals[i]) ? 1.0 : 0.0;
       m_errorsSquared[i] = 0;
@@ -1105,7 +1132,8 @@ namespace MDEvents
    */
   void MDHistoWorkspace::greaterThan(const signal_t signal)
   {
-    for (size_t i=0; i<m_length; ++i)
+    PARALLEL_FOR_IF(m_length > MIN_PARALLEL_LENGTH)
+    for (int64_t i=0; i<int64_t(m_length); ++i)
     {
       m_signals[i] = (m_signals[i] > signal) ? 1.0 : 0.0;
       m_errorsSquared[i] = 0;
@@ -1124,7 +1152,8 @@ namespace MDEvents
   void MDHistoWorkspace::equalTo(const MDHistoWorkspace & b, const signal_t tolerance)
   {
     checkWorkspaceSize(b, "equalTo");
-    for (size_t i=0; i<m_length; ++i)
+    PARALLEL_FOR_IF(m_length > MIN_PARALLEL_LENGTH)
+    for (int64_t i=0; i<int64_t(m_length); ++i)
     {
       signal_t diff = fabs(m_signals[i] - b.m_signals[i]);
       m_signals[i] = (diff < tolerance) ? 1.0 : 0.0;
@@ -1143,7 +1172,8 @@ namespace MDEvents
    */
   void MDHistoWorkspace::equalTo(const signal_t signal, const signal_t tolerance)
   {
-    for (size_t i=0; i<m_length; ++i)
+    PARALLEL_FOR_IF(m_length > MIN_PARALLEL_LENGTH)
+    for (int64_t i=0; i<int64_t(m_length); ++i)
     {
       signal_t diff = fabs(m_signals[i] - signal);
       m_signals[i] = (diff < tolerance) ? 1.0 : 0.0;
@@ -1171,7 +1201,8 @@ namespace MDEvents
   {
     checkWorkspaceSize(mask, "setUsingMask");
     checkWorkspaceSize(values, "setUsingMask");
-    for (size_t i=0; i<m_length; ++i)
+    PARALLEL_FOR_IF(m_length > MIN_PARALLEL_LENGTH)
+    for (int64_t i=0; i<int64_t(m_length); ++i)
     {
       if (mask.m_signals[i] != 0.0)
       {
@@ -1201,7 +1232,8 @@ namespace MDEvents
   {
     signal_t errorSquared = error * error;
     checkWorkspaceSize(mask, "setUsingMask");
-    for (size_t i=0; i<m_length; ++i)
+    PARALLEL_FOR_IF(m_length > MIN_PARALLEL_LENGTH)
+    for (int64_t i=0; i<int64_t(m_length); ++i)
     {
       if (mask.m_signals[i] != 0.0)
       {
@@ -146,9 +146,10 @@ namespace Mantid
       // Make sure that the first iteration is at a point inside the implicit function
       if (m_function)
       {
-        // Calculate the center of the 0-th bin
+        // Calculate the center of the first bin, which is not the 0-th one for
+        // the iterators created to split the workspace between cores
         for (size_t d = 0; d < m_nd; d++)
-          m_center[d] = m_origin[d] + 0.5f * m_binWidth[d];
+          m_center[d] = m_origin[d] + (coord_t(m_index[d]) + 0.5f) * m_binWidth[d];
         // Skip on if the first point is NOT contained
         if (!m_function->isPointContained(m_center))
           next();
@@ -200,6 +201,7 @@ namespace Mantid
       delete[] m_binWidth;
       delete[] m_index;
       delete[] m_indexMax;
+      delete[] m_indexMaker;
 
       if (m_function)
         delete m_function;
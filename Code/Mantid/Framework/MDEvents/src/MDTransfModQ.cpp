@@ -193,6 +193,41 @@ namespace Mantid
       return true;
 
     }
+    /** Calculate the MD coordinates of a batch of points which belong to the same detector.
+    * The conversion mode is selected once per batch and the points are processed by the inlined
+    * elastic/inelastic kernels rather than through the virtual calcMatrixCoord.
+    *
+    *@param X      -- input values (momentum or energy transfer), converted into the units expected by the transformation
+    *@param Coord  -- vector of MD coordinates with generic and detector-dependent values set
+    *@param signal -- signals, on return contains signals of the points within the range only
+    *@param errSq  -- squared errors, on return contains errors of the points within the range only
+    *@param allCoord -- the MD coordinates of the points within the range are appended to this vector
+    *
+    *@return the number of points within the limits requested by the algorithm
+    */
+    size_t MDTransfModQ::calcMatrixCoordBatch(const std::vector<double> &X,std::vector<coord_t> &Coord,
+                                            std::vector<double> &signal,std::vector<double> &errSq,std::vector<coord_t> &allCoord)const
+    {
+      const bool isElastic = (m_Emode == Kernel::DeltaEMode::Elastic);
+      const size_t nPoints = X.size();
+      size_t nAccepted(0);
+      for(size_t i=0;i<nPoints;i++)
+      {
+        double s   = signal[i];
+        double err = errSq[i];
+        const bool inRange = isElastic ? calcMatrixCoordElastic(X[i],Coord) : calcMatrixCoordInelastic(X[i],Coord);
+        if(!inRange)continue;
+
+        signal[nAccepted] = s;
+        errSq[nAccepted]  = err;
+        nAccepted++;
+        allCoord.insert(allCoord.end(),Coord.begin(),Coord.end());
+      }
+      signal.resize(nAccepted);
+      errSq.resize(nAccepted);
+      return nAccepted;
+    }
+
     /** method returns the vector of input coordinates values where the transformed coordinates reach its extremum values in Q or dE
      * direction. 
      *
@@ -336,6 +336,50 @@ namespace Mantid
 
       }
     }
+
+    /** convert an array of values from input to output units in place. The type of the conversion
+    is selected once for the whole array.
+    @param   vals  -- the values to convert, replaced by the values in the units requested
+    */
+    void UnitsConversionHelper::convertUnits(std::vector<double> &vals)const
+    {
+      const size_t nVals = vals.size();
+      switch(m_UnitCnvrsn)
+      {
+      case(CnvrtToMD::ConvertNo):   
+        {
+          return;
+        }
+      case(CnvrtToMD::ConvertFast):
+        {
+          for(size_t i=0;i<nVals;i++)
+          {
+            vals[i] = m_Factor*std::pow(vals[i],m_Power);
+          }
+          return;
+        }
+      case(CnvrtToMD::ConvertFromTOF):
+        {  
+          for(size_t i=0;i<nVals;i++)
+          {
+            vals[i] = m_TargetUnit->singleFromTOF(vals[i]);
+          }
+          return;
+        }
+      case(CnvrtToMD::ConvertByTOF):
+        {
+          for(size_t i=0;i<nVals;i++)
+          {
+            double tof = m_SourceWSUnit->singleToTOF(vals[i]);
+            vals[i] = m_TargetUnit->singleFromTOF(tof);
+          }
+          return;
+        }
+      default:
+        throw std::runtime_error("updateConversion: unknown type of conversion requested");
+
+      }
+    }
     // copy constructor;
     UnitsConversionHelper::UnitsConversionHelper(const UnitsConversionHelper &another)
     {
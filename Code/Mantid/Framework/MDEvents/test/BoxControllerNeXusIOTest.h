@@ -220,6 +220,44 @@ void setUp()
 
  }
 
+ void test_compressedDataReadBack()
+ {
+     MDEvents::BoxControllerNeXusIO *pSaver(NULL);
+     TS_ASSERT_THROWS_NOTHING(pSaver=new MDEvents::BoxControllerNeXusIO(sc.get()));
+     TS_ASSERT_EQUALS(::NeXus::NONE,pSaver->getCompression());
+     pSaver->setCompression(::NeXus::LZW);
+     TS_ASSERT_EQUALS(::NeXus::LZW,pSaver->getCompression());
+     pSaver->setDataType(4,"MDEvent");
+     std::string FullPathFile;
+
+     TS_ASSERT_THROWS_NOTHING(pSaver->openFile(this->xxfFileName,"w"));
+     TS_ASSERT_THROWS_NOTHING(FullPathFile = pSaver->getFileName());
+
+     // more events than in one chunk to go through several compressed chunks
+     size_t nEvents=25000;
+     size_t nColumns=pSaver->getNDataColums();
+     std::vector<float> toWrite(nColumns*nEvents);
+     for(size_t i=0;i<toWrite.size();i++)
+         toWrite[i] = static_cast<float>(i%97);
+     TS_ASSERT_THROWS_NOTHING(pSaver->saveBlock(toWrite,0));
+     TS_ASSERT_THROWS_NOTHING(pSaver->closeFile());
+
+     // read back the part crossing the chunk boundary
+     TS_ASSERT_THROWS_NOTHING(pSaver->openFile(FullPathFile,"r"));
+     std::vector<float> toRead;
+     TS_ASSERT_THROWS_NOTHING(pSaver->loadBlock(toRead,9990,20));
+     TS_ASSERT_EQUALS(20*nColumns,toRead.size());
+     for(size_t i=0;i<toRead.size();i++)
+     {
+         TS_ASSERT_EQUALS(toWrite[9990*nColumns+i],toRead[i]);
+     }
+     TS_ASSERT_THROWS_NOTHING(pSaver->closeFile());
+
+     delete pSaver;
+     if(Poco::File(FullPathFile).exists())
+         Poco::File(FullPathFile).remove();
+ }
+
  void test_WriteFloatReadReadFloat()
  {
      this->WriteReadRead<float,float>();
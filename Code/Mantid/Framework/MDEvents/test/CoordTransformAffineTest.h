@@ -173,6 +173,37 @@ public:
   }
 
 
+  /** applyMany gives the same points as apply, for specialised and generic numbers of dimensions */
+  void test_applyMany()
+  {
+    for (size_t inD = 2; inD <= 8; inD += 3)
+    {
+      const size_t outD = inD - 1;
+      CoordTransformAffine ct(inD, outD);
+      Matrix<coord_t> mat(outD+1, inD+1);
+      for (size_t r=0; r<outD; r++)
+        for (size_t c=0; c<=inD; c++)
+          mat[r][c] = coord_t(0.5 + 0.25*double(r) - 0.125*double(c));
+      mat[outD][inD] = 1.0;
+      ct.setMatrix(mat);
+
+      const size_t numPoints = 7;
+      std::vector<coord_t> in(numPoints*inD);
+      for (size_t i=0; i<in.size(); i++)
+        in[i] = coord_t(i) * 0.3f - 2.0f;
+      std::vector<coord_t> out(numPoints*outD);
+      ct.applyMany(in.data(), out.data(), numPoints);
+
+      std::vector<coord_t> single(outD);
+      for (size_t i=0; i<numPoints; i++)
+      {
+        ct.apply(in.data() + i*inD, single.data());
+        for (size_t d=0; d<outD; d++)
+          TS_ASSERT_EQUALS( out[i*outD+d], single[d] );
+      }
+    }
+  }
+
   //-----------------------------------------------------------------------------------------------
   /** Test a case of a rotation 0.1 radians around +Z,
    * and a projection into the XY plane */
@@ -429,6 +460,21 @@ public:
     }
   }
 
+  void test_applyMany_4D_performance()
+  {
+    CoordTransformAffine ct(4,4);
+    coord_t translation[4] = {2.0, 3.0, 4.0, 5.0};
+    ct.addTranslation(translation);
+    const size_t numPoints = 1000;
+    std::vector<coord_t> in(numPoints*4, 1.5);
+    std::vector<coord_t> out(numPoints*4);
+
+    for (size_t i=0; i<1000*10; ++i)
+    {
+      ct.applyMany(in.data(), out.data(), numPoints);
+    }
+  }
+
 };
 
 
@@ -94,6 +94,25 @@ public:
     TS_ASSERT_DELTA( out, 4.0, 1e-5);
   }
 
+  /** applyMany gives the same distances as apply */
+  void test_applyMany()
+  {
+    coord_t center[3] = {1, 2, 3};
+    bool used[3] = {true, false, true};
+    CoordTransformDistance ct(3,center,used);
+
+    coord_t in[9] = {0, 3, 1,  -1, 5, 2,  4, 4, 4};
+    coord_t out[3];
+    TS_ASSERT_THROWS_NOTHING( ct.applyMany(in, out, 3) );
+    for (size_t i=0; i<3; i++)
+    {
+      coord_t single = 0;
+      ct.apply(in + 3*i, &single);
+      TS_ASSERT_EQUALS( out[i], single );
+    }
+    TS_ASSERT_DELTA( out[0], 5.0, 1e-5);
+  }
+
   /** Test serialization */
   void test_to_xml_string()
   {
@@ -123,6 +123,7 @@ public:
   virtual void calculateCentroid(coord_t * /*centroid*/) const{};
   virtual coord_t * getCentroid() const{return 0;};
   virtual void integrateSphere(Mantid::API::CoordTransform & /*radiusTransform*/, const coord_t /*radiusSquared*/, signal_t & /*signal*/, signal_t & /*errorSquared*/) const {};
+  virtual void integrateSpheres(Mantid::API::CoordTransform & /*radiusTransform*/, const std::vector<coord_t> & /*radiiSquared*/, std::vector<signal_t> & /*signal*/, std::vector<signal_t> & /*errorSquared*/) const {};
   virtual void centroidSphere(Mantid::API::CoordTransform & /*radiusTransform*/, const coord_t /*radiusSquared*/, coord_t *, signal_t & ) const {};
   virtual void integrateCylinder(Mantid::API::CoordTransform & /*radiusTransform*/, const coord_t /*radius*/,const coord_t /*length*/, signal_t & /*signal*/, signal_t & /*errorSquared*/, std::vector<signal_t> & /*signal_fit*/) const {};
   virtual void getBoxes(std::vector<API::IMDNode *>&  /*boxes*/, size_t /*maxDepth*/, bool) {};
@@ -1211,6 +1211,22 @@ public:
     box.integrateSphere(sphere, static_cast<coord_t>(radius*radius), signal, errorSquared);
     TSM_ASSERT_DELTA( message, signal, 1.0*numExpected, 1e-5);
     TSM_ASSERT_DELTA( message, errorSquared, 1.0*numExpected, 1e-5);
+
+    // Integrating it with a bigger and a smaller sphere in one pass gives the same as one at a time
+    std::vector<coord_t> radiiSquared;
+    radiiSquared.push_back(static_cast<coord_t>(radius*radius));
+    radiiSquared.push_back(static_cast<coord_t>(4.0*radius*radius));
+    radiiSquared.push_back(static_cast<coord_t>(0.25*radius*radius));
+    std::vector<signal_t> signals(radiiSquared.size(), 0), errorsSquared(radiiSquared.size(), 0);
+    box.integrateSpheres(sphere, radiiSquared, signals, errorsSquared);
+    for (size_t r = 0; r < radiiSquared.size(); ++r)
+    {
+      signal_t oneSignal = 0;
+      signal_t oneErrorSquared = 0;
+      box.integrateSphere(sphere, radiiSquared[r], oneSignal, oneErrorSquared);
+      TSM_ASSERT_DELTA( message, signals[r], oneSignal, 1e-5);
+      TSM_ASSERT_DELTA( message, errorsSquared[r], oneErrorSquared, 1e-5);
+    }
   }
 
   /** Re-used suite of tests */
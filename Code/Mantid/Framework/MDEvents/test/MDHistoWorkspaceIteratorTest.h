@@ -240,6 +240,30 @@ public:
 
   }
 
+  /** Iterators that start part-way through the workspace check the implicit function on their own first point */
+  void test_parallel_iterators_implicitFunction()
+  {
+    MDHistoWorkspace_sptr ws = MDEventsTestHelper::makeFakeMDHistoWorkspace(1.0, 2, 10);
+    for (size_t i = 0; i < 100; i++)
+      ws->setSignalAt(i, double(i));
+
+    // Keep only the first 3 columns (x < 3)
+    MDImplicitFunction function;
+    function.addPlane(MDPlane(VMD(-1., 0.), VMD(3., 0.)));
+
+    std::vector<IMDIterator *> iterators = ws->createIterators(3, &function);
+    TS_ASSERT_EQUALS( iterators.size(), 3);
+    // Each iterator skips to the first point inside the function
+    TS_ASSERT_DELTA( iterators[0]->getSignal(), 0.0, 1e-5);
+    TS_ASSERT_DELTA( iterators[1]->getSignal(), 40.0, 1e-5);
+    TS_ASSERT_DELTA( iterators[2]->getSignal(), 70.0, 1e-5);
+    iterators[2]->next();
+    TS_ASSERT_DELTA( iterators[2]->getSignal(), 71.0, 1e-5);
+
+    for (size_t i = 0; i < iterators.size(); i++)
+      delete iterators[i];
+  }
+
   void test_predictable_steps()
   {
     MDHistoWorkspace_sptr ws = MDEventsTestHelper::makeFakeMDHistoWorkspace(1.0, 2, 10);
@@ -668,6 +668,16 @@ public:
     checkWorkspace(a, 6.0, 36. * (.5 + 1./3.), 2.0);
   }
 
+  /** Large enough for the operation to be split between threads */
+  void test_times_ws_large()
+  {
+    MDHistoWorkspace_sptr a = MDEventsTestHelper::makeFakeMDHistoWorkspace(2.0, 3, 30, 10.0, 2.0 /*errorSquared*/, "", 2.0);
+    MDHistoWorkspace_sptr b = MDEventsTestHelper::makeFakeMDHistoWorkspace(3.0, 3, 30, 10.0, 3.0 /*errorSquared*/, "", 3.0);
+    TS_ASSERT_EQUALS( a->getNPoints(), 27000);
+    *a *= *b;
+    checkWorkspace(a, 6.0, 36. * (.5 + 1./3.), 2.0);
+  }
+
   //--------------------------------------------------------------------------------------
   void test_times_scalar()
   {
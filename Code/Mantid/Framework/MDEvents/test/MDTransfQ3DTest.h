@@ -144,6 +144,57 @@ void testISLorents()
 }
 
 
+void testBatchConversionMatchesSinglePoints()
+{
+  MDTransfQ3D Q3DTransf;
+
+  MDWSDescription WSDescr(4);
+  std::string QMode = Q3DTransf.transfID();
+  std::string dEMode= Kernel::DeltaEMode::asString(Kernel::DeltaEMode::Direct);
+  std::vector<std::string> dimPropNames;
+
+  WSDescr.buildFromMatrixWS(ws2D,QMode,dEMode,dimPropNames);
+  WSDescr.m_PreprDetTable = WorkspaceCreationHelper::buildPreprocessedDetectorsWorkspace(ws2D);
+  TS_ASSERT_THROWS_NOTHING(Q3DTransf.initialize(WSDescr));
+
+  std::vector<coord_t> coord(4);
+  TS_ASSERT(Q3DTransf.calcGenericVariables(coord,4));
+  TS_ASSERT(Q3DTransf.calcYDepCoordinates(coord,1));
+
+  // energy transfers below Ei=13meV
+  std::vector<double> dE(16);
+  std::vector<double> signal(dE.size()),errorSq(dE.size());
+  for(size_t i=0;i<dE.size();i++)
+  {
+    dE[i] = -5.+double(i);
+    signal[i]  = 1.+double(i);
+    errorSq[i] = 0.5*double(i);
+  }
+
+  std::vector<coord_t> expectedCoord;
+  std::vector<double> expectedSignal,expectedErrorSq;
+  std::vector<coord_t> locCoord(coord);
+  for(size_t i=0;i<dE.size();i++)
+  {
+    double s(signal[i]),err(errorSq[i]);
+    if(!Q3DTransf.calcMatrixCoord(dE[i],locCoord,s,err))continue;
+    expectedSignal.push_back(s);
+    expectedErrorSq.push_back(err);
+    expectedCoord.insert(expectedCoord.end(),locCoord.begin(),locCoord.end());
+  }
+
+  std::vector<coord_t> allCoord;
+  size_t nAccepted = Q3DTransf.calcMatrixCoordBatch(dE,coord,signal,errorSq,allCoord);
+
+  TS_ASSERT_EQUALS(nAccepted,expectedSignal.size());
+  TS_ASSERT_EQUALS(signal,expectedSignal);
+  TS_ASSERT_EQUALS(errorSq,expectedErrorSq);
+  TS_ASSERT_EQUALS(allCoord.size(),expectedCoord.size());
+  for(size_t i=0;i<allCoord.size() && i<expectedCoord.size();i++)
+  {
+    TS_ASSERT_EQUALS(allCoord[i],expectedCoord[i]);
+  }
+}
 
 MDTransfQ3DTest()
 {
@@ -112,6 +112,9 @@ namespace Mantid
        /// Reset the pointer to the progress object.
       void resetProgress(Mantid::API::Progress* prog);
 
+      /// Number of spectra of a 2D data set to write or read with one slab call
+      static int spectraPerBlock(const size_t numberOfChannels);
+
       /// Nexus file handle
       NXhandle fileID;
 
@@ -122,6 +125,13 @@ namespace Mantid
       int m_nexuscompression;
       /// Allow an externally supplied progress object to be used
       API::Progress *m_progress;
+      /// Number of spectra in a compression chunk of a 2D data set
+      static int spectraPerChunk(const size_t numberOfChannels);
+      /// Create a 2D data set and write the given spectra into it a block at a time
+      template<class WorkspaceType>
+      void writeData2D(const std::string& name, const WorkspaceType& ws,
+                       const MantidVec& (WorkspaceType::*readRow)(std::size_t const) const,
+                       const std::vector<int>& spec, const int nChannels) const;
       /// Write a simple value plus possible attributes
       template<class TYPE>
       bool writeNxValue(const std::string& name, const TYPE& value, const int nxType, 
@@ -3,6 +3,7 @@
 //----------------------------------------------------------------------
 // Includes
 //----------------------------------------------------------------------
+#include <algorithm>
 #include <vector>
 #include <sstream>
 #include <stdlib.h>
@@ -16,6 +17,7 @@
 #include "MantidKernel/Unit.h"
 #include "MantidKernel/UnitFactory.h"
 #include "MantidKernel/DateAndTime.h"
+#include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/ConfigService.h"
 #include "MantidKernel/ArrayProperty.h"
 #include "MantidAPI/NumericAxis.h"
@@ -45,6 +47,10 @@ namespace Mantid
     {
       /// static logger
       Logger g_log("NexusFileIO");
+      /// Target size in bytes of a compression chunk of the 2D data sets
+      const size_t CHUNK_SIZE = 256 * 1024;
+      /// Number of chunks written or read with one slab call
+      const int CHUNKS_PER_BLOCK = 16;
     }
 
     /// Empty default constructor
@@ -286,6 +292,66 @@ namespace Mantid
       return (true);
     }
 
+    //-------------------------------------------------------------------------------------
+    /** Number of spectra in a compression chunk of a 2D data set. Chunks cover whole
+     * spectra so that reading a range of spectra only decompresses the chunks it needs.
+     * @param numberOfChannels :: the number of values in each spectrum
+     * @return the number of spectra in a chunk, at least 1
+     */
+    int NexusFileIO::spectraPerChunk(const size_t numberOfChannels)
+    {
+      const size_t spectrumSize = sizeof(double) * std::max(numberOfChannels, size_t(1));
+      return static_cast<int>(std::max(CHUNK_SIZE / spectrumSize, size_t(1)));
+    }
+
+    /** Number of spectra of a 2D data set to write or read with one slab call.
+     * This is a whole number of chunks.
+     * @param numberOfChannels :: the number of values in each spectrum
+     * @return the number of spectra in a block
+     */
+    int NexusFileIO::spectraPerBlock(const size_t numberOfChannels)
+    {
+      return CHUNKS_PER_BLOCK * spectraPerChunk(numberOfChannels);
+    }
+
+    /** Create a 2D data set and write the rows of the given spectra into it.
+     * The spectra are copied into a block buffer in parallel and each block, a whole
+     * number of chunks, is written with a single slab call.
+     * The data set is left open so that attributes can be added.
+     * @param name :: the name of the data set
+     * @param ws :: the workspace to write
+     * @param readRow :: the method returning a row of the workspace, e.g. readY
+     * @param spec :: the workspace indices to write
+     * @param nChannels :: the number of values in each row
+     */
+    template<class WorkspaceType>
+    void NexusFileIO::writeData2D(const std::string& name, const WorkspaceType& ws,
+        const MantidVec& (WorkspaceType::*readRow)(std::size_t const) const,
+        const std::vector<int>& spec, const int nChannels) const
+    {
+      const int nSpect = static_cast<int>(spec.size());
+      int dims_array[2] = { nSpect, nChannels };
+      int chunk[2] = { std::min(spectraPerChunk(static_cast<size_t>(nChannels)), std::max(nSpect, 1)), nChannels };
+      NXcompmakedata(fileID, name.c_str(), NX_FLOAT64, 2, dims_array, m_nexuscompression, chunk);
+      NXopendata(fileID, name.c_str());
+
+      const int blockSpectra = std::min(spectraPerBlock(static_cast<size_t>(nChannels)), nSpect);
+      std::vector<double> block(static_cast<size_t>(blockSpectra) * nChannels);
+      for (int first = 0; nChannels > 0 && first < nSpect; first += blockSpectra)
+      {
+        const int count = std::min(blockSpectra, nSpect - first);
+        PARALLEL_FOR_IF(ws.threadSafe())
+        for (int i = 0; i < count; ++i)
+        {
+          const MantidVec& row = (ws.*readRow)(spec[first + i]);
+          std::copy(row.begin(), row.end(), block.begin() + static_cast<size_t>(i) * nChannels);
+        }
+        int start[2] = { first, 0 };
+        int size[2] = { count, nChannels };
+        NXputslab(fileID, &block[0], start, size);
+      }
+    }
+
     //-------------------------------------------------------------------------------------
     /** Write out a MatrixWorkspace's data as a 2D matrix.
      * Use writeNexusProcessedDataEvent if writing an EventWorkspace.
@@ -350,15 +416,7 @@ namespace Mantid
       if (write2Ddata)
       {
         std::string name = "values";
-        NXcompmakedata(fileID, name.c_str(), NX_FLOAT64, 2, dims_array, m_nexuscompression, asize);
-        NXopendata(fileID, name.c_str());
-        for (size_t i = 0; i < nSpect; i++)
-        {
-          int s = spec[i];
-          NXputslab(fileID, reinterpret_cast<void*>(const_cast<double*>(&(localworkspace->readY(s)[0]))),
-              start, asize);
-          start[0]++;
-        }
+        writeData2D<API::MatrixWorkspace>(name, *localworkspace, &API::MatrixWorkspace::readY, spec, dims_array[1]);
         if (m_progress != 0)
           m_progress->reportIncrement(1, "Writing data");
         int signal = 1;
@@ -377,16 +435,7 @@ namespace Mantid
 
         // error
         name = "errors";
-        NXcompmakedata(fileID, name.c_str(), NX_FLOAT64, 2, dims_array, m_nexuscompression, asize);
-        NXopendata(fileID, name.c_str());
-        start[0] = 0;
-        for (size_t i = 0; i < nSpect; i++)
-        {
-          int s = spec[i];
-          NXputslab(fileID, reinterpret_cast<void*>(const_cast<double*>(&(localworkspace->readE(s)[0]))),
-              start, asize);
-          start[0]++;
-        }
+        writeData2D<API::MatrixWorkspace>(name, *localworkspace, &API::MatrixWorkspace::readE, spec, dims_array[1]);
         if (m_progress != 0)
           m_progress->reportIncrement(1, "Writing data");
 
@@ -396,17 +445,8 @@ namespace Mantid
           RebinnedOutput_const_sptr rebin_workspace = boost::dynamic_pointer_cast<const RebinnedOutput>(
               localworkspace);
           name = "frac_area";
-          NXcompmakedata(fileID, name.c_str(), NX_FLOAT64, 2, dims_array, m_nexuscompression, asize);
-          NXopendata(fileID, name.c_str());
-          start[0] = 0;
-          for (size_t i = 0; i < nSpect; i++)
-          {
-            int s = spec[i];
-            NXputslab(fileID,
-                reinterpret_cast<void*>(const_cast<double*>(&(rebin_workspace->readF(s)[0]))), start,
-                asize);
-            start[0]++;
-          }
+          NXclosedata(fileID);
+          writeData2D<RebinnedOutput>(name, *rebin_workspace, &RebinnedOutput::readF, spec, dims_array[1]);
           if (m_progress != 0)
             m_progress->reportIncrement(1, "Writing data");
         }